@@ -24,8 +24,26 @@ void init_core(py::module_ &m) {
         .def("to_sorted_vector", &RoleDenotation::to_sorted_vector)
     ;
 
+    py::class_<BitSlicedDenotations>(m, "BitSlicedDenotations")
+        .def("get_concept_denotation", &BitSlicedDenotations::get_concept_denotation)
+        .def("get_role_denotation", &BitSlicedDenotations::get_role_denotation)
+        .def("get_num_objects", &BitSlicedDenotations::get_num_objects)
+        .def("get_num_states", &BitSlicedDenotations::get_num_states)
+    ;
+
+    py::class_<DenotationsCaches::Pin>(m, "DenotationsCachesPin");
+
     py::class_<DenotationsCaches>(m, "DenotationsCaches")
         .def(py::init<>())
+        .def(py::init<std::size_t>())
+        .def("compute_num_bytes", &DenotationsCaches::compute_num_bytes)
+        .def("is_bounded", &DenotationsCaches::is_bounded)
+        .def("get_byte_budget", &DenotationsCaches::get_byte_budget)
+        .def("compute_statistics_table", &DenotationsCaches::compute_statistics_table)
+        .def("compute_statistics_json", &DenotationsCaches::compute_statistics_json)
+        .def("set_num_threads", &DenotationsCaches::set_num_threads)
+        .def("get_num_threads", &DenotationsCaches::get_num_threads)
+        .def("pin", &DenotationsCaches::pin, py::keep_alive<0, 1>())
     ;
 
     py::class_<Constant>(m, "Constant")
@@ -70,9 +88,9 @@ void init_core(py::module_ &m) {
         .def("__str__", &Atom::get_name_ref, py::return_value_policy::reference)
         .def("get_index", &Atom::get_index)
         .def("get_name", &Atom::get_name_ref, py::return_value_policy::reference)
-        .def("get_predicate", &Atom::get_predicate_ref, py::return_value_policy::reference)
-        .def("get_objects", &Atom::get_objects_ref, py::return_value_policy::reference)
-        .def("get_object", &Atom::get_object_ref, py::return_value_policy::reference)
+        .def("get_predicate", &Atom::get_predicate_ref, py::return_value_policy::reference_internal)
+        .def("get_objects", &Atom::get_objects)
+        .def("get_object", &Atom::get_object_ref, py::return_value_policy::reference_internal)
         .def("get_is_static", &Atom::get_is_static)
     ;
 
@@ -119,15 +137,19 @@ void init_core(py::module_ &m) {
         .def("add_atom", py::overload_cast<const std::string&, const std::vector<std::string>&>(&InstanceInfo::add_atom))
         .def("add_static_atom", py::overload_cast<const Predicate&, const std::vector<Object>&>(&InstanceInfo::add_static_atom))
         .def("add_static_atom", py::overload_cast<const std::string&, const std::vector<std::string>&>(&InstanceInfo::add_static_atom))
+        .def("add_objects", &InstanceInfo::add_objects)
+        .def("add_atoms", py::overload_cast<const Index_Vec&, const Index_Vec&>(&InstanceInfo::add_atoms))
+        .def("add_static_atoms", &InstanceInfo::add_static_atoms)
         .def("set_index", &InstanceInfo::set_index)
         .def("get_index", &InstanceInfo::get_index)
-        .def("get_atoms", &InstanceInfo::get_atoms_ref, py::return_value_policy::reference)
-        .def("get_static_atoms", &InstanceInfo::get_static_atoms_ref, py::return_value_policy::reference)
-        .def("get_atom", &InstanceInfo::get_atom_ref, py::return_value_policy::reference)
+        .def("get_atoms", &InstanceInfo::get_atoms_ref, py::return_value_policy::reference_internal)
+        .def("get_static_atoms", &InstanceInfo::get_static_atoms_ref, py::return_value_policy::reference_internal)
+        .def("get_atom", &InstanceInfo::get_atom_ref, py::return_value_policy::reference_internal)
         .def("get_atom_idx", &InstanceInfo::get_atom_idx)
         .def("get_objects", &InstanceInfo::get_objects_ref, py::return_value_policy::reference)
         .def("get_object", &InstanceInfo::get_object_ref, py::return_value_policy::reference)
         .def("get_object_idx", &InstanceInfo::get_object_idx)
+        .def("get_constant_object_idx", &InstanceInfo::get_constant_object_idx)
         .def("get_num_objects", &InstanceInfo::get_num_objects)
         .def("get_vocabulary_info_ref", &InstanceInfo::get_vocabulary_info_ref, py::return_value_policy::reference)
         .def("get_vocabulary_info", &InstanceInfo::get_vocabulary_info)
@@ -141,6 +163,7 @@ void init_core(py::module_ &m) {
         .def("evaluate", py::overload_cast<const State&>(&Concept::evaluate, py::const_))
         .def("evaluate", py::overload_cast<const State&, DenotationsCaches&>(&Concept::evaluate, py::const_), py::return_value_policy::reference)
         .def("evaluate", py::overload_cast<const States&, DenotationsCaches&>(&Concept::evaluate, py::const_), py::return_value_policy::reference)
+        .def("evaluate_sliced", &Concept::evaluate_sliced, py::return_value_policy::reference)
         .def("compute_complexity", &Concept::compute_complexity)
         .def("compute_repr", &Concept::compute_repr)
         .def("set_index", &Concept::set_index)
@@ -155,6 +178,7 @@ void init_core(py::module_ &m) {
         .def("evaluate", py::overload_cast<const State&>(&Role::evaluate, py::const_))
         .def("evaluate", py::overload_cast<const State&, DenotationsCaches&>(&Role::evaluate, py::const_), py::return_value_policy::reference)
         .def("evaluate", py::overload_cast<const States&, DenotationsCaches&>(&Role::evaluate, py::const_), py::return_value_policy::reference)
+        .def("evaluate_sliced", &Role::evaluate_sliced, py::return_value_policy::reference)
         .def("compute_complexity", &Role::compute_complexity)
         .def("compute_repr", &Role::compute_repr)
         .def("set_index", &Role::set_index)
@@ -242,4 +266,15 @@ void init_core(py::module_ &m) {
         .def("get_vocabulary_info_ref", &SyntacticElementFactory::get_vocabulary_info_ref, py::return_value_policy::reference)
         .def("get_vocabulary_info", &SyntacticElementFactory::get_vocabulary_info)
     ;
+
+    py::class_<FeatureProgram>(m, "FeatureProgram")
+        .def(py::init<const std::vector<Boolean>&, const std::vector<Numerical>&>())
+        .def(py::init<const std::vector<std::shared_ptr<const Boolean>>&, const std::vector<std::shared_ptr<const Numerical>>&>())
+        .def("evaluate", &FeatureProgram::evaluate)
+        .def("evaluate_incrementally", &FeatureProgram::evaluate_incrementally)
+        .def("get_boolean_value", &FeatureProgram::get_boolean_value)
+        .def("get_numerical_value", &FeatureProgram::get_numerical_value)
+        .def("get_num_instructions", &FeatureProgram::get_num_instructions)
+        .def("get_num_executed_instructions", &FeatureProgram::get_num_executed_instructions)
+    ;
 }
@@ -83,6 +83,19 @@ def test_instance():
     assert o1.get_index() == 1
 
 
+def test_atom_lifetime():
+    """ Atoms remain usable after their instance is released.
+    """
+    vocabulary = generate_bw_vocabulary()
+    instance = generate_bw_instance(vocabulary)
+    atom = instance.add_atom("on", ["a", "b"])
+    atoms = instance.get_atoms()
+    del instance
+    assert str(atom) == "on(a,b)"
+    assert atom.get_object(1).get_name() == "b"
+    assert atoms[7].get_name() == "clear(b)"
+
+
 def test_factory():
     """ Test the construction, evaluation, and getters of Elements.
     """
@@ -0,0 +1,133 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../include/dlplan/core.h"
+#include "../include/dlplan/generator.h"
+
+using namespace dlplan;
+
+/*
+  Measures how parsing features with one shared SyntacticElementFactory
+  scales with the number of threads.
+  Thread t parses the features t, t + T, t + 2T, ... and keeps them alive,
+  such that threads look up the subelements that other threads constructed.
+  Each number of threads starts with a new factory such that the first run constructs all elements.
+*/
+
+static core::States sample_states(std::shared_ptr<core::InstanceInfo> instance, int num_blocks, int num_states) {
+    std::mt19937 rng(0);
+    core::States states;
+    for (int state_idx = 0; state_idx < num_states; ++state_idx) {
+        std::vector<std::string> blocks;
+        for (int i = 1; i <= num_blocks; ++i) blocks.push_back("b" + std::to_string(i));
+        std::shuffle(blocks.begin(), blocks.end(), rng);
+        std::vector<core::Atom> atoms;
+        if (std::bernoulli_distribution(0.5)(rng)) {
+            atoms.push_back(instance->add_atom("holding", {blocks.back()}));
+            blocks.pop_back();
+        } else {
+            atoms.push_back(instance->add_atom("arm-empty", {}));
+        }
+        for (std::size_t i = 0; i < blocks.size(); ++i) {
+            if (i == 0 || std::bernoulli_distribution(0.4)(rng)) {
+                atoms.push_back(instance->add_atom("on-table", {blocks[i]}));
+            } else {
+                atoms.push_back(instance->add_atom("on", {blocks[i], blocks[i - 1]}));
+            }
+            if (i + 1 == blocks.size() || std::bernoulli_distribution(0.4)(rng)) {
+                atoms.push_back(instance->add_atom("clear", {blocks[i]}));
+            }
+        }
+        states.emplace_back(instance, atoms, state_idx);
+    }
+    return states;
+}
+
+int main(int argc, char** argv) {
+    int complexity_limit = (argc > 1) ? std::atoi(argv[1]) : 5;
+    int num_repetitions = (argc > 2) ? std::atoi(argv[2]) : 20;
+    auto vocabulary = std::make_shared<core::VocabularyInfo>();
+    vocabulary->add_predicate("on", 2);
+    vocabulary->add_predicate("on-table", 1);
+    vocabulary->add_predicate("clear", 1);
+    vocabulary->add_predicate("holding", 1);
+    vocabulary->add_predicate("arm-empty", 0);
+    auto instance = std::make_shared<core::InstanceInfo>(vocabulary, 0);
+    core::States states = sample_states(instance, 5, 100);
+
+    std::vector<std::string> reprs;
+    {
+        core::SyntacticElementFactory factory(vocabulary);
+        for (const auto& repr : generator::FeatureGenerator().generate(
+            factory, complexity_limit, complexity_limit, complexity_limit, complexity_limit, complexity_limit,
+            3600, 1000000, 1, states)) {
+            if (repr.substr(0, 2) == "b_" || repr.substr(0, 2) == "n_") reprs.push_back(repr);
+        }
+    }
+
+    std::stringstream results;
+    results << "Hardware threads: " << std::thread::hardware_concurrency() << std::endl
+            << "Features: " << reprs.size() << std::endl
+            << std::left
+            << std::setw(10) << "threads"
+            << std::setw(14) << "cold [ms]"
+            << std::setw(14) << "warm [ms]"
+            << std::setw(16) << "cold speedup"
+            << std::setw(16) << "warm speedup" << std::endl;
+    double cold_ms_1 = 0;
+    double warm_ms_1 = 0;
+    for (int num_threads : {1, 2, 4, 8, 16, 32, 64}) {
+        core::SyntacticElementFactory factory(vocabulary);
+        std::vector<std::vector<core::Numerical>> numericals(num_threads);
+        std::vector<std::vector<core::Boolean>> booleans(num_threads);
+        auto run = [&](int num_repetitions) {
+            auto start = std::chrono::steady_clock::now();
+            std::vector<std::thread> threads;
+            for (int t = 0; t < num_threads; ++t) {
+                threads.emplace_back([&, t]() {
+                    for (int r = 0; r < num_repetitions; ++r) {
+                        std::vector<core::Numerical> parsed_numericals;
+                        std::vector<core::Boolean> parsed_booleans;
+                        for (std::size_t i = t; i < reprs.size(); i += num_threads) {
+                            if (reprs[i][0] == 'n') {
+                                parsed_numericals.push_back(factory.parse_numerical(reprs[i]));
+                            } else {
+                                parsed_booleans.push_back(factory.parse_boolean(reprs[i]));
+                            }
+                        }
+                        numericals[t] = std::move(parsed_numericals);
+                        booleans[t] = std::move(parsed_booleans);
+                    }
+                });
+            }
+            for (auto& thread : threads) thread.join();
+            auto end = std::chrono::steady_clock::now();
+            return std::chrono::duration<double, std::milli>(end - start).count() / num_repetitions;
+        };
+        // The first run constructs all elements and the following runs only look them up,
+        // because the features of the previous repetition are still alive.
+        double cold_ms = run(1);
+        double warm_ms = run(num_repetitions);
+        if (num_threads == 1) {
+            cold_ms_1 = cold_ms;
+            warm_ms_1 = warm_ms;
+        }
+        results << std::left << std::fixed << std::setprecision(1)
+                << std::setw(10) << num_threads
+                << std::setw(14) << cold_ms
+                << std::setw(14) << warm_ms
+                << std::setprecision(2)
+                << std::setw(16) << cold_ms_1 / cold_ms
+                << std::setw(16) << warm_ms_1 / warm_ms << std::endl;
+    }
+    std::cout << results.str();
+    return 0;
+}
@@ -0,0 +1,132 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../include/dlplan/core.h"
+#include "../include/dlplan/generator.h"
+
+using namespace dlplan;
+
+/*
+  Measures how evaluating features with one shared DenotationsCaches
+  scales with the number of threads.
+  Thread t evaluates the features t, t + T, t + 2T, ... in all states,
+  such that threads reuse the cached denotations of shared subelements.
+  States are random blocksworld states with 5 blocks.
+*/
+
+static core::States sample_states(std::shared_ptr<core::InstanceInfo> instance, int num_blocks, int num_states) {
+    std::mt19937 rng(0);
+    core::States states;
+    for (int state_idx = 0; state_idx < num_states; ++state_idx) {
+        std::vector<std::string> blocks;
+        for (int i = 1; i <= num_blocks; ++i) blocks.push_back("b" + std::to_string(i));
+        std::shuffle(blocks.begin(), blocks.end(), rng);
+        std::vector<core::Atom> atoms;
+        if (std::bernoulli_distribution(0.5)(rng)) {
+            atoms.push_back(instance->add_atom("holding", {blocks.back()}));
+            blocks.pop_back();
+        } else {
+            atoms.push_back(instance->add_atom("arm-empty", {}));
+        }
+        for (std::size_t i = 0; i < blocks.size(); ++i) {
+            if (i == 0 || std::bernoulli_distribution(0.4)(rng)) {
+                atoms.push_back(instance->add_atom("on-table", {blocks[i]}));
+            } else {
+                atoms.push_back(instance->add_atom("on", {blocks[i], blocks[i - 1]}));
+            }
+            if (i + 1 == blocks.size() || std::bernoulli_distribution(0.4)(rng)) {
+                atoms.push_back(instance->add_atom("clear", {blocks[i]}));
+            }
+        }
+        states.emplace_back(instance, atoms, state_idx);
+    }
+    return states;
+}
+
+int main(int argc, char** argv) {
+    int num_states = (argc > 1) ? std::atoi(argv[1]) : 1000;
+    int complexity_limit = (argc > 2) ? std::atoi(argv[2]) : 5;
+    auto vocabulary = std::make_shared<core::VocabularyInfo>();
+    vocabulary->add_predicate("on", 2);
+    vocabulary->add_predicate("on-table", 1);
+    vocabulary->add_predicate("clear", 1);
+    vocabulary->add_predicate("holding", 1);
+    vocabulary->add_predicate("arm-empty", 0);
+    auto instance = std::make_shared<core::InstanceInfo>(vocabulary, 0);
+    core::States states = sample_states(instance, 5, num_states);
+
+    core::SyntacticElementFactory factory(vocabulary);
+    auto reprs = generator::FeatureGenerator().generate(
+        factory, complexity_limit, complexity_limit, complexity_limit, complexity_limit, complexity_limit,
+        3600, 1000000, 1, states);
+    std::vector<core::Boolean> booleans;
+    std::vector<core::Numerical> numericals;
+    for (const auto& repr : reprs) {
+        if (repr.substr(0, 2) == "b_") {
+            booleans.push_back(factory.parse_boolean(repr));
+        } else if (repr.substr(0, 2) == "n_") {
+            numericals.push_back(factory.parse_numerical(repr));
+        }
+    }
+
+    std::stringstream results;
+    results << "Hardware threads: " << std::thread::hardware_concurrency() << std::endl
+            << "States: " << states.size() << ", booleans: " << booleans.size() << ", numericals: " << numericals.size() << std::endl
+            << std::left
+            << std::setw(10) << "threads"
+            << std::setw(14) << "cold [ms]"
+            << std::setw(14) << "warm [ms]"
+            << std::setw(16) << "cold speedup"
+            << std::setw(16) << "warm speedup" << std::endl;
+    double cold_ms_1 = 0;
+    double warm_ms_1 = 0;
+    for (int num_threads : {1, 2, 4, 8, 16, 32, 64}) {
+        core::DenotationsCaches caches;
+        auto run = [&](int num_repetitions) {
+            auto start = std::chrono::steady_clock::now();
+            std::vector<std::thread> threads;
+            std::vector<long> sums(num_threads, 0);
+            for (int t = 0; t < num_threads; ++t) {
+                threads.emplace_back([&, t]() {
+                    long sum = 0;
+                    for (int r = 0; r < num_repetitions; ++r) {
+                        for (std::size_t i = t; i < booleans.size(); i += num_threads) {
+                            for (const auto& state : states) sum += booleans[i].evaluate(state, caches);
+                        }
+                        for (std::size_t i = t; i < numericals.size(); i += num_threads) {
+                            for (const auto& state : states) sum += numericals[i].evaluate(state, caches);
+                        }
+                    }
+                    sums[t] = sum;
+                });
+            }
+            for (auto& thread : threads) thread.join();
+            auto end = std::chrono::steady_clock::now();
+            return std::chrono::duration<double, std::milli>(end - start).count() / num_repetitions;
+        };
+        // The first run fills the caches and the following runs only hit.
+        double cold_ms = run(1);
+        double warm_ms = run(50);
+        if (num_threads == 1) {
+            cold_ms_1 = cold_ms;
+            warm_ms_1 = warm_ms;
+        }
+        results << std::left << std::fixed << std::setprecision(1)
+                << std::setw(10) << num_threads
+                << std::setw(14) << cold_ms
+                << std::setw(14) << warm_ms
+                << std::setprecision(2)
+                << std::setw(16) << cold_ms_1 / cold_ms
+                << std::setw(16) << warm_ms_1 / warm_ms << std::endl;
+    }
+    std::cout << results.str();
+    return 0;
+}
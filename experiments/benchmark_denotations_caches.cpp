@@ -0,0 +1,260 @@
+#include <malloc.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <random>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <unordered_set>
+#include <vector>
+
+#include "../include/dlplan/core.h"
+#include "../include/dlplan/generator.h"
+
+using namespace dlplan;
+
+/*
+  Measures the heap memory that is retained per interned denotation
+  when storing unique denotations in DenotationsCaches.
+  The instances mirror the sizes of benchmarks/blocksworld_3/p-5-0.pddl,
+  benchmarks/gripper/p-5-0.pddl, and benchmarks/delivery/instance_4_3_0.pddl.
+  States are sampled randomly such that no planner is needed to run the benchmark.
+*/
+
+static std::size_t num_live_bytes = 0;
+
+void* operator new(std::size_t size) {
+    if (void* ptr = std::malloc(size ? size : 1)) {
+        num_live_bytes += malloc_usable_size(ptr);
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+__attribute__((noinline)) static void release(void* ptr) noexcept {
+    if (ptr) num_live_bytes -= malloc_usable_size(ptr);
+    std::free(ptr);
+}
+
+void operator delete(void* ptr) noexcept {
+    release(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+    release(ptr);
+}
+
+using AtomNames = std::vector<std::pair<std::string, std::vector<std::string>>>;
+
+struct Domain {
+    std::string name;
+    std::vector<std::pair<std::string, int>> predicates;
+    AtomNames static_atoms;
+    std::function<AtomNames(std::mt19937&)> sample_state;
+};
+
+static Domain blocksworld(int num_blocks) {
+    Domain domain;
+    domain.name = "blocksworld_" + std::to_string(num_blocks);
+    domain.predicates = {{"on", 2}, {"on-table", 1}, {"clear", 1}, {"holding", 1}, {"arm-empty", 0}};
+    domain.sample_state = [num_blocks](std::mt19937& rng) {
+        std::vector<std::string> blocks;
+        for (int i = 1; i <= num_blocks; ++i) blocks.push_back("b" + std::to_string(i));
+        std::shuffle(blocks.begin(), blocks.end(), rng);
+        AtomNames atoms;
+        bool holding = std::bernoulli_distribution(0.5)(rng);
+        if (holding) {
+            atoms.push_back({"holding", {blocks.back()}});
+            blocks.pop_back();
+        } else {
+            atoms.push_back({"arm-empty", {}});
+        }
+        // Stack the remaining blocks into random towers.
+        for (std::size_t i = 0; i < blocks.size(); ++i) {
+            if (i == 0 || std::bernoulli_distribution(0.4)(rng)) {
+                atoms.push_back({"on-table", {blocks[i]}});
+            } else {
+                atoms.push_back({"on", {blocks[i], blocks[i - 1]}});
+            }
+            if (i + 1 == blocks.size() || std::bernoulli_distribution(0.4)(rng)) {
+                atoms.push_back({"clear", {blocks[i]}});
+            }
+        }
+        return atoms;
+    };
+    return domain;
+}
+
+static Domain gripper(int num_balls) {
+    Domain domain;
+    domain.name = "gripper_" + std::to_string(num_balls);
+    domain.predicates = {{"room", 1}, {"ball", 1}, {"gripper", 1}, {"at-robby", 1}, {"at", 2}, {"free", 1}, {"carry", 2}};
+    domain.static_atoms = {{"room", {"rooma"}}, {"room", {"roomb"}}, {"gripper", {"left"}}, {"gripper", {"right"}}};
+    for (int i = 1; i <= num_balls; ++i) domain.static_atoms.push_back({"ball", {"ball" + std::to_string(i)}});
+    domain.sample_state = [num_balls](std::mt19937& rng) {
+        AtomNames atoms;
+        atoms.push_back({"at-robby", {std::bernoulli_distribution(0.5)(rng) ? "rooma" : "roomb"}});
+        std::vector<std::string> grippers({"left", "right"});
+        for (int i = 1; i <= num_balls; ++i) {
+            std::string ball = "ball" + std::to_string(i);
+            if (!grippers.empty() && std::bernoulli_distribution(0.2)(rng)) {
+                atoms.push_back({"carry", {ball, grippers.back()}});
+                grippers.pop_back();
+            } else {
+                atoms.push_back({"at", {ball, std::bernoulli_distribution(0.5)(rng) ? "rooma" : "roomb"}});
+            }
+        }
+        for (const auto& free_gripper : grippers) atoms.push_back({"free", {free_gripper}});
+        return atoms;
+    };
+    return domain;
+}
+
+static Domain delivery(int grid_size, int num_packages) {
+    Domain domain;
+    domain.name = "delivery_" + std::to_string(grid_size) + "_" + std::to_string(num_packages);
+    domain.predicates = {{"at", 2}, {"carrying", 2}, {"empty", 1}, {"adjacent", 2}};
+    auto cell = [](int x, int y) { return "c_" + std::to_string(x) + "_" + std::to_string(y); };
+    for (int x = 0; x < grid_size; ++x) {
+        for (int y = 0; y < grid_size; ++y) {
+            if (x + 1 < grid_size) {
+                domain.static_atoms.push_back({"adjacent", {cell(x, y), cell(x + 1, y)}});
+                domain.static_atoms.push_back({"adjacent", {cell(x + 1, y), cell(x, y)}});
+            }
+            if (y + 1 < grid_size) {
+                domain.static_atoms.push_back({"adjacent", {cell(x, y), cell(x, y + 1)}});
+                domain.static_atoms.push_back({"adjacent", {cell(x, y + 1), cell(x, y)}});
+            }
+        }
+    }
+    domain.sample_state = [grid_size, num_packages, cell](std::mt19937& rng) {
+        std::uniform_int_distribution<int> coordinate(0, grid_size - 1);
+        AtomNames atoms;
+        atoms.push_back({"at", {"t1", cell(coordinate(rng), coordinate(rng))}});
+        bool empty = true;
+        for (int i = 1; i <= num_packages; ++i) {
+            std::string package = "p" + std::to_string(i);
+            if (empty && std::bernoulli_distribution(0.2)(rng)) {
+                atoms.push_back({"carrying", {"t1", package}});
+                empty = false;
+            } else {
+                atoms.push_back({"at", {package, cell(coordinate(rng), coordinate(rng))}});
+            }
+        }
+        if (empty) atoms.push_back({"empty", {"t1"}});
+        return atoms;
+    };
+    return domain;
+}
+
+/**
+ * The representation of DenotationsCaches before denotations were interned in slabs.
+ */
+template<typename T>
+using NodeBasedSet = std::unordered_set<
+    std::unique_ptr<T>,
+    std::function<std::size_t(const std::unique_ptr<T>&)>,
+    std::function<bool(const std::unique_ptr<T>&, const std::unique_ptr<T>&)>>;
+
+/**
+ * Inserts copies of the denotations in the given order
+ * and returns the retained bytes per distinct denotation
+ * for the node-based set and for the interning pool.
+ */
+template<typename T>
+static std::tuple<std::size_t, double, double> measure(const std::vector<const T*>& denotations) {
+    std::size_t num_distinct = 0;
+    double node_based_bytes = 0;
+    double pool_bytes = 0;
+    {
+        std::size_t num_bytes_before = num_live_bytes;
+        NodeBasedSet<T> set(
+            0,
+            [](const std::unique_ptr<T>& denotation){ return std::hash<T>()(*denotation); },
+            [](const std::unique_ptr<T>& left, const std::unique_ptr<T>& right){ return *left == *right; });
+        for (const auto denotation : denotations) set.insert(std::make_unique<T>(*denotation));
+        num_distinct = set.size();
+        node_based_bytes = static_cast<double>(num_live_bytes - num_bytes_before) / num_distinct;
+    }
+    {
+        std::size_t num_bytes_before = num_live_bytes;
+        utils::InterningPool<T> pool;
+        for (const auto denotation : denotations) pool.insert(T(*denotation));
+        pool_bytes = static_cast<double>(num_live_bytes - num_bytes_before) / pool.size();
+    }
+    return std::make_tuple(num_distinct, node_based_bytes, pool_bytes);
+}
+
+int main(int argc, char** argv) {
+    int num_states = (argc > 1) ? std::atoi(argv[1]) : 500;
+    int complexity_limit = (argc > 2) ? std::atoi(argv[2]) : 5;
+    // The generator logs its progress, hence we print the results at the end.
+    std::stringstream results;
+    results << std::left
+            << std::setw(16) << "domain"
+            << std::setw(10) << "states"
+            << std::setw(10) << "kind"
+            << std::setw(12) << "inserted"
+            << std::setw(12) << "distinct"
+            << std::setw(18) << "node-based [B]"
+            << std::setw(18) << "pool [B]" << std::endl;
+    auto report = [&](const std::string& domain_name, const std::string& kind, std::size_t num_inserted, const auto& measurement) {
+        results << std::left
+                << std::setw(16) << domain_name
+                << std::setw(10) << num_states
+                << std::setw(10) << kind
+                << std::setw(12) << num_inserted
+                << std::setw(12) << std::get<0>(measurement)
+                << std::setw(18) << std::fixed << std::setprecision(1) << std::get<1>(measurement)
+                << std::setw(18) << std::get<2>(measurement) << std::endl;
+    };
+    for (const auto& domain : {blocksworld(5), gripper(5), delivery(4, 3)}) {
+        auto vocabulary = std::make_shared<core::VocabularyInfo>();
+        for (const auto& predicate : domain.predicates) {
+            vocabulary->add_predicate(predicate.first, predicate.second);
+        }
+        auto instance = std::make_shared<core::InstanceInfo>(vocabulary, 0);
+        for (const auto& atom : domain.static_atoms) {
+            instance->add_static_atom(atom.first, atom.second);
+        }
+        std::mt19937 rng(0);
+        core::States states;
+        for (int state_idx = 0; state_idx < num_states; ++state_idx) {
+            std::vector<core::Atom> atoms;
+            for (const auto& atom : domain.sample_state(rng)) {
+                atoms.push_back(instance->add_atom(atom.first, atom.second));
+            }
+            states.emplace_back(instance, atoms, state_idx);
+        }
+
+        // Collect the denotations of all generated concepts and roles
+        // in the order in which the generator interns them.
+        core::SyntacticElementFactory factory(vocabulary);
+        auto reprs = generator::FeatureGenerator().generate(
+            factory, complexity_limit, complexity_limit, complexity_limit, complexity_limit, complexity_limit,
+            3600, 1000000, 1, states);
+        core::DenotationsCaches caches;
+        std::vector<const core::ConceptDenotation*> concept_denotations;
+        std::vector<const core::RoleDenotation*> role_denotations;
+        for (const auto& repr : reprs) {
+            if (repr.substr(0, 2) == "c_") {
+                for (const auto denotation : *factory.parse_concept(repr).evaluate(states, caches)) {
+                    concept_denotations.push_back(denotation);
+                }
+            } else if (repr.substr(0, 2) == "r_") {
+                for (const auto denotation : *factory.parse_role(repr).evaluate(states, caches)) {
+                    role_denotations.push_back(denotation);
+                }
+            }
+        }
+        report(domain.name, "concept", concept_denotations.size(), measure(concept_denotations));
+        report(domain.name, "role", role_denotations.size(), measure(role_denotations));
+    }
+    std::cout << results.str();
+    return 0;
+}
@@ -0,0 +1,113 @@
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../include/dlplan/utils/dynamic_bitset.h"
+
+using namespace dlplan::utils;
+
+/*
+  Microbenchmark for the DynamicBitset kernels.
+  For n objects we measure role denotations that consist of n^2 bits
+  and compare the portable 64-bit kernels against the kernels
+  that are selected for the executing CPU.
+*/
+
+static volatile std::size_t sink = 0;
+
+static double measure_ns(const std::function<void()>& operation, int num_repetitions) {
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < num_repetitions; ++i) {
+        operation();
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() / num_repetitions;
+}
+
+static DynamicBitset<std::uint64_t> random_bitset(std::size_t num_bits, double density, std::mt19937& rng) {
+    DynamicBitset<std::uint64_t> result(num_bits);
+    std::bernoulli_distribution distribution(density);
+    for (std::size_t pos = 0; pos < num_bits; ++pos) {
+        if (distribution(rng)) result.set(pos);
+    }
+    return result;
+}
+
+int main() {
+    const auto& scalar = kernels::get_kernels(kernels::InstructionSet::SCALAR);
+    const auto& best = kernels::get_kernels();
+    std::cout << "Selected instruction set: " << kernels::to_string(best.instruction_set) << std::endl;
+    std::cout << std::left
+              << std::setw(8) << "objects"
+              << std::setw(14) << "operation"
+              << std::setw(14) << "scalar [ns]"
+              << std::setw(14) << "best [ns]"
+              << std::setw(10) << "speedup" << std::endl;
+
+    std::mt19937 rng(0);
+    for (int num_objects : {16, 64, 256, 1024, 4096}) {
+        const std::size_t num_bits = static_cast<std::size_t>(num_objects) * num_objects;
+        const std::size_t num_blocks = (num_bits + 63) / 64;
+        // Keep the amount of work per measurement roughly constant.
+        const int num_repetitions = std::max<int>(10, static_cast<int>(50000000 / num_bits));
+        auto left = random_bitset(num_bits, 0.5, rng);
+        auto right = random_bitset(num_bits, 0.5, rng);
+        // Operands for which the predicates must scan all blocks.
+        auto subset = right;
+        auto complement = right;
+        ~complement;
+        std::vector<std::uint64_t> scratch(left.data(), left.data() + num_blocks);
+        auto bitset_scratch = left;
+
+        auto report = [&](const std::string& name, double scalar_ns, double best_ns) {
+            std::cout << std::left
+                      << std::setw(8) << num_objects
+                      << std::setw(14) << name
+                      << std::setw(14) << std::fixed << std::setprecision(1) << scalar_ns
+                      << std::setw(14) << best_ns
+                      << std::setw(10) << std::setprecision(2) << scalar_ns / best_ns << std::endl;
+        };
+
+        report("count(bits)",
+            measure_ns([&](){
+                std::size_t result = 0;
+                for (std::size_t pos = 0; pos < num_bits; ++pos) result += left.test(pos);
+                sink = sink + result;
+            }, std::max(1, num_repetitions / 64)),
+            measure_ns([&](){ sink = sink + left.count(); }, num_repetitions));
+        report("count",
+            measure_ns([&](){ sink = sink + scalar.count(left.data(), num_blocks); }, num_repetitions),
+            measure_ns([&](){ sink = sink + left.count(); }, num_repetitions));
+        report("&=",
+            measure_ns([&](){ scalar.bitwise_and(scratch.data(), right.data(), num_blocks); }, num_repetitions),
+            measure_ns([&](){ bitset_scratch &= right; }, num_repetitions));
+        report("|=",
+            measure_ns([&](){ scalar.bitwise_or(scratch.data(), right.data(), num_blocks); }, num_repetitions),
+            measure_ns([&](){ bitset_scratch |= right; }, num_repetitions));
+        report("-=",
+            measure_ns([&](){ scalar.bitwise_andnot(scratch.data(), right.data(), num_blocks); }, num_repetitions),
+            measure_ns([&](){ bitset_scratch -= right; }, num_repetitions));
+        report("~",
+            measure_ns([&](){ scalar.bitwise_not(scratch.data(), num_blocks); }, num_repetitions),
+            measure_ns([&](){ ~bitset_scratch; }, num_repetitions));
+        report("intersects",
+            measure_ns([&](){ sink = sink + scalar.intersects(complement.data(), right.data(), num_blocks); }, num_repetitions),
+            measure_ns([&](){ sink = sink + complement.intersects(right); }, num_repetitions));
+        report("is_subset_of",
+            measure_ns([&](){ sink = sink + scalar.is_subset_of(subset.data(), right.data(), num_blocks); }, num_repetitions),
+            measure_ns([&](){ sink = sink + subset.is_subset_of(right); }, num_repetitions));
+        DynamicBitset<std::uint64_t> empty(num_bits);
+        report("none",
+            measure_ns([&](){ sink = sink + scalar.none(empty.data(), num_blocks); }, num_repetitions),
+            measure_ns([&](){ sink = sink + empty.none(); }, num_repetitions));
+        report("==",
+            measure_ns([&](){ sink = sink + scalar.equal(subset.data(), right.data(), num_blocks); }, num_repetitions),
+            measure_ns([&](){ sink = sink + (subset == right); }, num_repetitions));
+    }
+    return 0;
+}
@@ -0,0 +1,121 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../include/dlplan/core.h"
+#include "../include/dlplan/generator.h"
+#include "../include/dlplan/policy.h"
+
+using namespace dlplan;
+
+/*
+  Measures the throughput of parsing generated features in features per second,
+  once as single elements and once as the features of a policy
+  with one rule per feature that is read by the PolicyReader.
+  Every repetition parses into a new factory such that all elements are constructed.
+  States are random blocksworld states with 5 blocks.
+*/
+
+static core::States sample_states(std::shared_ptr<core::InstanceInfo> instance, int num_blocks, int num_states) {
+    std::mt19937 rng(0);
+    core::States states;
+    for (int state_idx = 0; state_idx < num_states; ++state_idx) {
+        std::vector<std::string> blocks;
+        for (int i = 1; i <= num_blocks; ++i) blocks.push_back("b" + std::to_string(i));
+        std::shuffle(blocks.begin(), blocks.end(), rng);
+        std::vector<core::Atom> atoms;
+        if (std::bernoulli_distribution(0.5)(rng)) {
+            atoms.push_back(instance->add_atom("holding", {blocks.back()}));
+            blocks.pop_back();
+        } else {
+            atoms.push_back(instance->add_atom("arm-empty", {}));
+        }
+        for (std::size_t i = 0; i < blocks.size(); ++i) {
+            if (i == 0 || std::bernoulli_distribution(0.4)(rng)) {
+                atoms.push_back(instance->add_atom("on-table", {blocks[i]}));
+            } else {
+                atoms.push_back(instance->add_atom("on", {blocks[i], blocks[i - 1]}));
+            }
+            if (i + 1 == blocks.size() || std::bernoulli_distribution(0.4)(rng)) {
+                atoms.push_back(instance->add_atom("clear", {blocks[i]}));
+            }
+        }
+        states.emplace_back(instance, atoms, state_idx);
+    }
+    return states;
+}
+
+int main(int argc, char** argv) {
+    int complexity_limit = (argc > 1) ? std::atoi(argv[1]) : 5;
+    int num_repetitions = (argc > 2) ? std::atoi(argv[2]) : 10;
+    auto vocabulary = std::make_shared<core::VocabularyInfo>();
+    vocabulary->add_predicate("on", 2);
+    vocabulary->add_predicate("on-table", 1);
+    vocabulary->add_predicate("clear", 1);
+    vocabulary->add_predicate("holding", 1);
+    vocabulary->add_predicate("arm-empty", 0);
+    auto instance = std::make_shared<core::InstanceInfo>(vocabulary, 0);
+    core::States states = sample_states(instance, 5, 100);
+
+    std::vector<std::string> booleans;
+    std::vector<std::string> numericals;
+    {
+        core::SyntacticElementFactory factory(vocabulary);
+        for (const auto& repr : generator::FeatureGenerator().generate(
+            factory, complexity_limit, complexity_limit, complexity_limit, complexity_limit, complexity_limit,
+            3600, 1000000, 1, states)) {
+            if (repr.substr(0, 2) == "b_") {
+                booleans.push_back(repr);
+            } else if (repr.substr(0, 2) == "n_") {
+                numericals.push_back(repr);
+            }
+        }
+    }
+    const int num_features = booleans.size() + numericals.size();
+
+    std::stringstream policy;
+    policy << "(:policy\n(:boolean_features";
+    for (const auto& repr : booleans) policy << " \"" << repr << "\"";
+    policy << ")\n(:numerical_features";
+    for (const auto& repr : numericals) policy << " \"" << repr << "\"";
+    policy << ")\n";
+    for (std::size_t i = 0; i < booleans.size(); ++i) {
+        policy << "(:rule (:conditions (:c_b_pos " << i << ")) (:effects (:e_b_neg " << i << ")))\n";
+    }
+    for (std::size_t i = 0; i < numericals.size(); ++i) {
+        policy << "(:rule (:conditions (:c_n_gt " << i << ")) (:effects (:e_n_dec " << i << ")))\n";
+    }
+    policy << ")";
+    const std::string policy_textual = policy.str();
+
+    auto measure = [&](auto parse) {
+        auto start = std::chrono::steady_clock::now();
+        for (int r = 0; r < num_repetitions; ++r) {
+            core::SyntacticElementFactory factory(vocabulary);
+            parse(factory);
+        }
+        auto end = std::chrono::steady_clock::now();
+        return num_features * num_repetitions / std::chrono::duration<double>(end - start).count();
+    };
+    double elements_per_second = measure([&](core::SyntacticElementFactory& factory) {
+        std::vector<core::Boolean> parsed_booleans;
+        std::vector<core::Numerical> parsed_numericals;
+        for (const auto& repr : booleans) parsed_booleans.push_back(factory.parse_boolean(repr));
+        for (const auto& repr : numericals) parsed_numericals.push_back(factory.parse_numerical(repr));
+    });
+    double policy_features_per_second = measure([&](core::SyntacticElementFactory& factory) {
+        policy::PolicyReader().read(policy_textual, factory);
+    });
+
+    std::cout << "Features: " << num_features << ", policy size: " << policy_textual.size() << " bytes" << std::endl
+              << std::fixed << std::setprecision(0)
+              << "parse_boolean/parse_numerical [features/s]: " << elements_per_second << std::endl
+              << "PolicyReader::read [features/s]: " << policy_features_per_second << std::endl;
+    return 0;
+}
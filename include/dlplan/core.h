@@ -1,8 +1,18 @@
 #ifndef DLPLAN_INCLUDE_DLPLAN_CORE_H_
 #define DLPLAN_INCLUDE_DLPLAN_CORE_H_
 
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <limits>
+#include <stdexcept>
 #include <memory>
+#include <mutex>
+#include <shared_mutex>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <unordered_set>
 #include <unordered_map>
@@ -12,23 +22,34 @@
 #include "phmap/phmap.h"
 
 #include "utils/pimpl.h"
-#include "utils/dynamic_bitset.h"
+#include "utils/hybrid_bitset.h"
 #include "utils/cache.h"
+#include "utils/interning_pool.h"
+#include "utils/atomic_vector.h"
 #include "utils/hashing.h"
 
 /**
  * Forward declarations and usings
  */
+namespace dlplan::utils::threadpool {
+    class ThreadPool;
+}
+
 namespace dlplan::core {
     class SyntacticElementFactoryImpl;
+    class FeatureProgramImpl;
     class InstanceInfoImpl;
     class VocabularyInfoImpl;
     class SyntacticElementFactory;
     class InstanceInfo;
+    class AtomIndex;
+    class AtomTable;
+    class StaticAtomMasks;
     class VocabularyInfo;
     class State;
     class ConceptDenotation;
     class RoleDenotation;
+    class BitSlicedDenotations;
     namespace element {
         template<typename T>
         class Element;
@@ -57,29 +78,20 @@ namespace std {
     template<> struct hash<dlplan::core::State> {
         size_t operator()(const dlplan::core::State& state) const noexcept;
     };
-    template<>
-    struct hash<unique_ptr<dlplan::core::ConceptDenotation>> {
-        size_t operator()(const unique_ptr<dlplan::core::ConceptDenotation>& denotation) const noexcept;
+    template<> struct hash<dlplan::core::ConceptDenotation> {
+        size_t operator()(const dlplan::core::ConceptDenotation& denotation) const noexcept;
     };
-    template<>
-    struct hash<unique_ptr<dlplan::core::RoleDenotation>> {
-        size_t operator()(const unique_ptr<dlplan::core::RoleDenotation>& denotation) const noexcept;
+    template<> struct hash<dlplan::core::RoleDenotation> {
+        size_t operator()(const dlplan::core::RoleDenotation& denotation) const noexcept;
     };
-    template<>
-    struct hash<unique_ptr<dlplan::core::ConceptDenotations>> {
-        size_t operator()(const unique_ptr<dlplan::core::ConceptDenotations>& denotations) const noexcept;
+    template<> struct hash<dlplan::core::ConceptDenotations> {
+        size_t operator()(const dlplan::core::ConceptDenotations& denotations) const noexcept;
     };
-    template<>
-    struct hash<unique_ptr<dlplan::core::RoleDenotations>> {
-        size_t operator()(const unique_ptr<dlplan::core::RoleDenotations>& denotations) const noexcept;
+    template<> struct hash<dlplan::core::RoleDenotations> {
+        size_t operator()(const dlplan::core::RoleDenotations& denotations) const noexcept;
     };
-    template<>
-    struct hash<unique_ptr<dlplan::core::BooleanDenotations>> {
-        size_t operator()(const unique_ptr<dlplan::core::BooleanDenotations>& denotations) const noexcept;
-    };
-    template<>
-    struct hash<unique_ptr<dlplan::core::NumericalDenotations>> {
-        size_t operator()(const unique_ptr<dlplan::core::NumericalDenotations>& denotations) const noexcept;
+    template<> struct hash<dlplan::core::BitSlicedDenotations> {
+        size_t operator()(const dlplan::core::BitSlicedDenotations& denotations) const noexcept;
     };
     template<> struct hash<vector<unsigned>> {
         size_t operator()(const vector<unsigned>& data) const noexcept;
@@ -87,25 +99,42 @@ namespace std {
     template<> struct hash<vector<int>> {
         size_t operator()(const vector<int>& data) const noexcept;
     };
-    template<> struct hash<std::array<int, 3>> {
-        size_t operator()(const std::array<int, 3>& data) const noexcept;
+}
+
+namespace dlplan::utils {
+    template<> struct HeapBytes<dlplan::core::ConceptDenotation> {
+        std::size_t operator()(const dlplan::core::ConceptDenotation& denotation) const noexcept;
+    };
+    template<> struct HeapBytes<dlplan::core::RoleDenotation> {
+        std::size_t operator()(const dlplan::core::RoleDenotation& denotation) const noexcept;
+    };
+    template<> struct HeapBytes<dlplan::core::BitSlicedDenotations> {
+        std::size_t operator()(const dlplan::core::BitSlicedDenotations& denotations) const noexcept;
     };
 }
 
 
 namespace dlplan::core {
 
+/**
+ * Storage of denotations. Concepts over at most 256 objects
+ * and roles over at most 64 objects are stored without heap allocation.
+ */
+using ConceptBitset = utils::HybridBitset<256>;
+using RoleBitset = utils::HybridBitset<4096>;
+
+
 class ConceptDenotation {
 private:
     int m_num_objects;
-    utils::DynamicBitset<unsigned> m_data;
+    ConceptBitset m_data;
 
 public:
     // Special iterator for bitset representing set of integers
     class const_iterator {
         public:
             using iterator_category = std::forward_iterator_tag;
-            using value_type        = utils::DynamicBitset<unsigned>;
+            using value_type        = ConceptBitset;
             using const_reference   = const value_type&;
 
             const_iterator(const_reference data, int num_objects, bool end=false);
@@ -157,8 +186,18 @@ public:
     bool intersects(const ConceptDenotation& other) const;
     bool is_subset_of(const ConceptDenotation& other) const;
 
+    /**
+     * Calls visitor(object_idx) for every contained object in increasing order.
+     * Cheaper than the iterators because set bits are extracted blockwise.
+     */
+    template<typename Visitor>
+    void for_each(Visitor visitor) const {
+        m_data.for_each_set_bit([&](std::size_t pos) { visitor(static_cast<int>(pos)); });
+    }
+
     std::vector<int> to_sorted_vector() const;
-    const utils::DynamicBitset<unsigned>& get_bitset_ref() const;
+    ConceptBitset& get_bitset_ref();
+    const ConceptBitset& get_bitset_ref() const;
 
     std::size_t compute_hash() const;
 
@@ -169,14 +208,14 @@ public:
 class RoleDenotation {
 private:
     int m_num_objects;
-    utils::DynamicBitset<unsigned> m_data;
+    RoleBitset m_data;
 
 public:
     // Special iterator for bitset representing set of pairs of ints.
     class const_iterator {
         public:
             using iterator_category = std::forward_iterator_tag;
-            using value_type        = utils::DynamicBitset<unsigned>;
+            using value_type        = RoleBitset;
             using const_reference   = const value_type&;
 
             const_iterator(const_reference data, int num_objects, bool end=false);
@@ -198,6 +237,7 @@ public:
 
         private:
             void seek_next();
+            void set_position(std::size_t pos);
     };
 
     explicit RoleDenotation(int num_objects);
@@ -229,46 +269,554 @@ public:
     bool intersects(const RoleDenotation& other) const;
     bool is_subset_of(const RoleDenotation& other) const;
 
+    /**
+     * Calls generator(insert) where insert(first_idx, second_idx) inserts a pair.
+     * The pairs can be inserted in any order and are sorted once at the end
+     * instead of one sorted insertion per pair in the sparse representation.
+     */
+    template<typename Generator>
+    void insert_unsorted(Generator generator) {
+        generator([&](int first_idx, int second_idx) {
+            m_data.set_unordered(first_idx * m_num_objects + second_idx);
+        });
+        m_data.sort_unordered();
+    }
+
+    /**
+     * Calls visitor(first_idx, second_idx) for every contained pair in lexicographic order.
+     * Cheaper than the iterators because set bits are extracted blockwise
+     * and row and column are advanced incrementally instead of divided out.
+     */
+    template<typename Visitor>
+    void for_each(Visitor visitor) const {
+        m_data.for_each_nonzero_block([&](std::size_t block_idx, std::uint64_t block) {
+            const int base = static_cast<int>(block_idx) * 64;
+            int row = base / m_num_objects;
+            int col = base % m_num_objects;
+            int offset = 0;
+            while (block) {
+                int next_offset = utils::kernels::scalar::count_trailing_zeros(block);
+                col += next_offset - offset;
+                offset = next_offset;
+                while (col >= m_num_objects) {
+                    col -= m_num_objects;
+                    ++row;
+                }
+                visitor(row, col);
+                block &= block - 1;
+            }
+        });
+    }
+
     std::vector<std::pair<int, int>> to_sorted_vector() const;
-    const utils::DynamicBitset<unsigned>& get_bitset_ref() const;
+    RoleBitset& get_bitset_ref();
+    const RoleBitset& get_bitset_ref() const;
+
+    std::size_t compute_hash() const;
+
+    int get_num_objects() const;
+};
+
+
+/**
+ * Denotations of a concept or role in a collection of states of the same instance
+ * in bit-sliced layout: the bits of one position, i.e., object for concepts
+ * and pair of objects for roles, are stored consecutively for all states,
+ * 64 states per block. Set operations thereby process 64 states per block operation.
+ * Per-state denotations are only extracted on demand.
+ */
+class BitSlicedDenotations {
+private:
+    int m_num_objects;
+    int m_num_positions;
+    int m_num_states;
+    int m_num_blocks_per_position;
+    std::vector<std::uint64_t> m_blocks;
+
+    // Clears the bits of states beyond m_num_states in the last block of each position.
+    void zero_unused_bits();
+
+public:
+    /**
+     * Empty denotations with num_positions positions per state.
+     */
+    BitSlicedDenotations(int num_objects, int num_positions, int num_states);
+    /**
+     * Transposes per-state denotations.
+     */
+    BitSlicedDenotations(const ConceptDenotations& denotations, int num_objects);
+    BitSlicedDenotations(const RoleDenotations& denotations, int num_objects);
+    BitSlicedDenotations(const BitSlicedDenotations& other);
+    BitSlicedDenotations& operator=(const BitSlicedDenotations& other);
+    BitSlicedDenotations(BitSlicedDenotations&& other);
+    BitSlicedDenotations& operator=(BitSlicedDenotations&& other);
+    ~BitSlicedDenotations();
+
+    bool operator==(const BitSlicedDenotations& other) const;
+    bool operator!=(const BitSlicedDenotations& other) const;
+
+    BitSlicedDenotations& operator&=(const BitSlicedDenotations& other);
+    BitSlicedDenotations& operator|=(const BitSlicedDenotations& other);
+    BitSlicedDenotations& operator-=(const BitSlicedDenotations& other);
+    BitSlicedDenotations& operator~();
+
+    void set();
+    void insert(int state_idx, int position);
+    bool contains(int state_idx, int position) const;
+
+    /**
+     * Extracts the denotation of a single state.
+     */
+    ConceptDenotation get_concept_denotation(int state_idx) const;
+    RoleDenotation get_role_denotation(int state_idx) const;
+
+    /**
+     * Returns the blocks of a position, bit i of block j belongs to state 64*j+i.
+     */
+    std::uint64_t* get_slice(int position);
+    const std::uint64_t* get_slice(int position) const;
 
-    const std::vector<unsigned>& get_blocks() const;
     std::size_t compute_hash() const;
+    std::size_t get_num_heap_bytes() const;
 
     int get_num_objects() const;
+    int get_num_positions() const;
+    int get_num_states() const;
+    int get_num_blocks_per_position() const;
 };
 
 
 /**
- * Compares two std::unique_ptr<T>
- * by comparing objects T.
+ * Maps (instance index, state index, element index) to values of type T
+ * using one column per instance and element.
+ * A column is split into pages of PAGE_SIZE consecutive states
+ * that are allocated on first insertion and can be evicted in CLOCK order.
+ * Slots that were never assigned hold the sentinel NOT_COMPUTED.
+ * Indices start at -1, the default index of instances and states.
+ * Lookups take no locks, insertions lock the column.
+ */
+template<typename T, T NOT_COMPUTED>
+class PerStateMapping {
+private:
+    static constexpr std::size_t NUM_STRIPES = 64;
+    static constexpr std::size_t PAGE_SIZE = 64;
+
+    struct Page {
+        std::array<std::atomic<T>, PAGE_SIZE> values;
+        // Set by lookups and cleared when the clock hand passes.
+        std::atomic<bool> referenced;
+
+        Page() : referenced(true) {
+            for (auto& value : values) value.store(NOT_COMPUTED, std::memory_order_relaxed);
+        }
+    };
+
+    using Column = utils::AtomicVector<Page*, nullptr>;
+    using Columns = utils::AtomicVector<Column*, nullptr>;
+
+    struct ClockEntry {
+        Column* column;
+        std::size_t page_idx;
+        Page* page;
+    };
+
+    // Columns by instance and element.
+    utils::AtomicVector<Columns*, nullptr> m_columns;
+    // Serializes the creation of columns.
+    std::mutex m_columns_mutex;
+    // Serializes the writes into columns, striped by element.
+    std::array<std::mutex, NUM_STRIPES> m_column_mutexes;
+    // All pages in the order visited by the clock hand.
+    std::vector<ClockEntry> m_clock;
+    std::size_t m_clock_hand;
+    std::mutex m_clock_mutex;
+    std::atomic<std::size_t> m_num_pages;
+
+    Column* get_column(std::size_t instance_slot, std::size_t element_slot) const {
+        Columns* columns = m_columns.load(instance_slot);
+        return columns ? columns->load(element_slot) : nullptr;
+    }
+
+public:
+    static constexpr T not_computed = NOT_COMPUTED;
+
+    PerStateMapping() : m_clock_hand(0), m_num_pages(0) { }
+    PerStateMapping(const PerStateMapping& other) = delete;
+    PerStateMapping& operator=(const PerStateMapping& other) = delete;
+    ~PerStateMapping() {
+        for (const auto& entry : m_clock) delete entry.page;
+        m_columns.for_each([](Columns* columns){
+            if (!columns) return;
+            columns->for_each([](Column* column){ delete column; });
+            delete columns;
+        });
+    }
+
+    /**
+     * Returns the stored value or NOT_COMPUTED.
+     */
+    T find(int instance_idx, int state_idx, int element_idx) const {
+        // The offset maps -1 to 0 and all smaller indices beyond the bounds.
+        Column* column = get_column(static_cast<std::size_t>(instance_idx) + 1, static_cast<std::size_t>(element_idx) + 1);
+        if (!column) return NOT_COMPUTED;
+        std::size_t state_slot = static_cast<std::size_t>(state_idx) + 1;
+        Page* page = column->load(state_slot / PAGE_SIZE);
+        if (!page) return NOT_COMPUTED;
+        T value = page->values[state_slot % PAGE_SIZE].load(std::memory_order_acquire);
+        // Only write the flag if it changes such that hits do not invalidate the cache line.
+        if (value != NOT_COMPUTED && !page->referenced.load(std::memory_order_relaxed)) {
+            page->referenced.store(true, std::memory_order_relaxed);
+        }
+        return value;
+    }
+
+    /**
+     * Stores the value unless a value is stored already.
+     * Returns the stored value.
+     */
+    T insert(int instance_idx, int state_idx, int element_idx, T value) {
+        if (instance_idx < -1 || state_idx < -1 || element_idx < -1) {
+            throw std::runtime_error("PerStateMapping::insert - indices must be at least -1.");
+        }
+        std::size_t instance_slot = static_cast<std::size_t>(instance_idx) + 1;
+        std::size_t state_slot = static_cast<std::size_t>(state_idx) + 1;
+        std::size_t element_slot = static_cast<std::size_t>(element_idx) + 1;
+        Column* column = get_column(instance_slot, element_slot);
+        if (!column) {
+            std::lock_guard<std::mutex> hold(m_columns_mutex);
+            Columns* columns = m_columns.load(instance_slot);
+            if (!columns) {
+                columns = new Columns();
+                m_columns.store(instance_slot, columns);
+            }
+            column = columns->load(element_slot);
+            if (!column) {
+                column = new Column();
+                columns->store(element_slot, column);
+            }
+        }
+        std::lock_guard<std::mutex> hold(m_column_mutexes[element_slot % NUM_STRIPES]);
+        std::size_t page_idx = state_slot / PAGE_SIZE;
+        Page* page = column->load(page_idx);
+        if (!page) {
+            page = new Page();
+            {
+                std::lock_guard<std::mutex> hold_clock(m_clock_mutex);
+                m_clock.push_back(ClockEntry{column, page_idx, page});
+            }
+            column->store(page_idx, page);
+            m_num_pages.fetch_add(1, std::memory_order_relaxed);
+        }
+        auto& slot = page->values[state_slot % PAGE_SIZE];
+        T stored = slot.load(std::memory_order_relaxed);
+        if (stored != NOT_COMPUTED) return stored;
+        slot.store(value, std::memory_order_release);
+        return value;
+    }
+
+    /**
+     * Evicts the first page in CLOCK order that was not referenced
+     * since the hand passed it and calls release on each of its values.
+     * Returns false if there is no page left.
+     * Must not run concurrently with lookups or insertions.
+     */
+    template<typename F>
+    bool evict_page(F&& release) {
+        while (!m_clock.empty()) {
+            if (m_clock_hand >= m_clock.size()) m_clock_hand = 0;
+            ClockEntry& entry = m_clock[m_clock_hand];
+            if (entry.page->referenced.exchange(false, std::memory_order_relaxed)) {
+                ++m_clock_hand;
+                continue;
+            }
+            for (const auto& value : entry.page->values) {
+                T stored = value.load(std::memory_order_relaxed);
+                if (stored != NOT_COMPUTED) release(stored);
+            }
+            entry.column->store(entry.page_idx, nullptr);
+            delete entry.page;
+            entry = m_clock.back();
+            m_clock.pop_back();
+            m_num_pages.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+        return false;
+    }
+
+    /**
+     * Calls f on every stored value.
+     * Must not run concurrently with insertions.
+     */
+    template<typename F>
+    void for_each(F&& f) const {
+        for (const auto& entry : m_clock) {
+            for (const auto& value : entry.page->values) {
+                T stored = value.load(std::memory_order_relaxed);
+                if (stored != NOT_COMPUTED) f(stored);
+            }
+        }
+    }
+
+    /**
+     * Returns the number of bytes used by the pages.
+     */
+    std::size_t get_num_bytes() const {
+        return m_num_pages.load(std::memory_order_relaxed) * sizeof(Page);
+    }
+};
+
+/**
+ * Maps element indices to values of type T.
+ * Slots that were never assigned hold the sentinel NOT_COMPUTED.
+ * Lookups take no locks, insertions take a lock.
  */
-template<typename T>
-struct DerefEqual {
-    bool operator()(const T& left, const T& right) const {
-        return *left == *right;
+template<typename T, T NOT_COMPUTED>
+class PerElementMapping {
+private:
+    utils::AtomicVector<T, NOT_COMPUTED> m_values;
+    std::mutex m_mutex;
+
+public:
+    static constexpr T not_computed = NOT_COMPUTED;
+
+    /**
+     * Returns the stored value or NOT_COMPUTED.
+     */
+    T find(int element_idx) const {
+        return m_values.load(static_cast<std::size_t>(element_idx) + 1);
+    }
+
+    void insert(int element_idx, T value) {
+        if (element_idx < -1) {
+            throw std::runtime_error("PerElementMapping::insert - index must be at least -1.");
+        }
+        std::lock_guard<std::mutex> hold(m_mutex);
+        m_values.store(static_cast<std::size_t>(element_idx) + 1, value);
     }
 };
 
-struct DenotationsCaches {
+/**
+ * Counters for the cached evaluations of one element.
+ * Times and bytes of misses include the evaluation of subelements.
+ */
+struct EvaluationStatistics {
+    std::string repr;
+    std::atomic<std::uint64_t> num_calls;
+    std::atomic<std::uint64_t> num_hits;
+    std::atomic<std::uint64_t> num_misses;
+    // Time spent computing denotations on misses.
+    std::atomic<std::uint64_t> num_nanoseconds;
+    // Growth of the caches on misses.
+    std::atomic<std::uint64_t> num_bytes;
+
+    explicit EvaluationStatistics(std::string repr);
+};
+
+/**
+ * EvaluationStatistics by element type and index.
+ * The table is only filled if the library is compiled with DLPLAN_INSTRUMENTATION,
+ * see the CMake option ENABLE_INSTRUMENTATION.
+ */
+class EvaluationStatisticsTable {
+public:
+    enum class ElementType { CONCEPT, ROLE, NUMERICAL, BOOLEAN };
+
+private:
+    static constexpr std::size_t NUM_ELEMENT_TYPES = 4;
+
+    std::array<utils::AtomicVector<EvaluationStatistics*, nullptr>, NUM_ELEMENT_TYPES> m_statistics;
+    std::mutex m_mutex;
+
+    template<typename F>
+    void for_each(F&& f) const {
+        for (std::size_t type = 0; type < NUM_ELEMENT_TYPES; ++type) {
+            m_statistics[type].for_each([&](const EvaluationStatistics* statistics) {
+                if (statistics) f(static_cast<ElementType>(type), *statistics);
+            });
+        }
+    }
+
+public:
+    EvaluationStatisticsTable() = default;
+    EvaluationStatisticsTable(const EvaluationStatisticsTable& other) = delete;
+    EvaluationStatisticsTable& operator=(const EvaluationStatisticsTable& other) = delete;
+    ~EvaluationStatisticsTable();
+
+    /**
+     * Returns the statistics of the element and creates them on first access
+     * with the representation returned by compute_repr.
+     */
+    template<typename F>
+    EvaluationStatistics& get(ElementType type, int element_idx, F&& compute_repr) {
+        auto& statistics = m_statistics[static_cast<std::size_t>(type)];
+        std::size_t element_slot = static_cast<std::size_t>(element_idx) + 1;
+        EvaluationStatistics* result = statistics.load(element_slot);
+        if (!result) {
+            std::lock_guard<std::mutex> hold(m_mutex);
+            result = statistics.load(element_slot);
+            if (!result) {
+                result = new EvaluationStatistics(compute_repr());
+                statistics.store(element_slot, result);
+            }
+        }
+        return *result;
+    }
+
+    /**
+     * Returns one row per element sorted by decreasing time.
+     */
+    std::string compute_table() const;
+
+    /**
+     * Returns a JSON array with one object per element.
+     */
+    std::string compute_json() const;
+};
+
+/**
+ * Caches for denotations that are reused across elements and evaluations.
+ * Equal denotations are stored only once, see utils::InterningPool.
+ * A single instance can be shared by threads that evaluate elements concurrently.
+ * Cache hits take no locks.
+ *
+ * Caches with a byte budget evict pages of per-state entries in CLOCK order
+ * when an evaluation begins and the caches exceed the budget.
+ * The denotations of per-state entries are then owned by the entries
+ * instead of being interned such that eviction frees them.
+ * Interned denotations are referenced by the per-element collections
+ * and are never evicted.
+ * A pointer returned by an evaluation for a single state remains valid
+ * until the next evaluation with the same caches begins,
+ * or as long as a Pin of the caches is alive that was created before the evaluation.
+ */
+class DenotationsCaches {
+private:
+    std::size_t m_byte_budget;
+    // Bytes of the denotations owned by per-state entries.
+    std::atomic<std::size_t> m_num_owned_bytes;
+    // Shared by running evaluations and held exclusively during eviction.
+    std::shared_mutex m_evaluation_mutex;
+    // Eviction is skipped while there are pins.
+    std::atomic<int> m_num_pins;
+    // Evaluates chunks of collections of states if there are several threads.
+    std::unique_ptr<utils::threadpool::ThreadPool> m_thread_pool;
+    int m_num_threads;
+
+    void evict();
+
+    std::shared_lock<std::shared_mutex> begin_bounded_evaluation();
+
+public:
+    /**
+     * Prevents eviction while it is alive such that pointers returned
+     * by evaluations remain valid while other threads evaluate with the same caches.
+     * The caches can exceed their budget in the meantime.
+     */
+    class Pin {
+    private:
+        DenotationsCaches* m_caches;
+
+        explicit Pin(DenotationsCaches& caches);
+        friend class DenotationsCaches;
+
+    public:
+        Pin(const Pin& other) = delete;
+        Pin& operator=(const Pin& other) = delete;
+        Pin(Pin&& other);
+        Pin& operator=(Pin&& other) = delete;
+        ~Pin();
+    };
+
     // Cache for single denotations.
-    std::unordered_set<std::unique_ptr<ConceptDenotation>, std::hash<std::unique_ptr<ConceptDenotation>>, DerefEqual<std::unique_ptr<ConceptDenotation>>> m_c_denot_cache;
-    std::unordered_set<std::unique_ptr<RoleDenotation>, std::hash<std::unique_ptr<RoleDenotation>>, DerefEqual<std::unique_ptr<RoleDenotation>>> m_r_denot_cache;
+    utils::ShardedInterningPool<ConceptDenotation> m_c_denot_cache;
+    utils::ShardedInterningPool<RoleDenotation> m_r_denot_cache;
     // Cache for collections of denotations.
-    std::unordered_set<std::unique_ptr<BooleanDenotations>, std::hash<std::unique_ptr<BooleanDenotations>>, DerefEqual<std::unique_ptr<BooleanDenotations>>> m_b_denots_cache;
-    std::unordered_set<std::unique_ptr<NumericalDenotations>, std::hash<std::unique_ptr<NumericalDenotations>>, DerefEqual<std::unique_ptr<NumericalDenotations>>> m_n_denots_cache;
-    std::unordered_set<std::unique_ptr<ConceptDenotations>, std::hash<std::unique_ptr<ConceptDenotations>>, DerefEqual<std::unique_ptr<ConceptDenotations>>> m_c_denots_cache;
-    std::unordered_set<std::unique_ptr<RoleDenotations>, std::hash<std::unique_ptr<RoleDenotations>>, DerefEqual<std::unique_ptr<RoleDenotations>>> m_r_denots_cache;
+    utils::ShardedInterningPool<BooleanDenotations> m_b_denots_cache;
+    utils::ShardedInterningPool<NumericalDenotations> m_n_denots_cache;
+    utils::ShardedInterningPool<ConceptDenotations> m_c_denots_cache;
+    utils::ShardedInterningPool<RoleDenotations> m_r_denots_cache;
     // Mapping from element index to denotations.
-    std::unordered_map<int, BooleanDenotations*> m_b_denots_mapping;
-    std::unordered_map<int, NumericalDenotations*> m_n_denots_mapping;
-    std::unordered_map<int, ConceptDenotations*> m_c_denots_mapping;
-    std::unordered_map<int, RoleDenotations*> m_r_denots_mapping;
+    PerElementMapping<BooleanDenotations*, nullptr> m_b_denots_mapping;
+    PerElementMapping<NumericalDenotations*, nullptr> m_n_denots_mapping;
+    PerElementMapping<ConceptDenotations*, nullptr> m_c_denots_mapping;
+    PerElementMapping<RoleDenotations*, nullptr> m_r_denots_mapping;
+    // Cache and mappings for collections of states of one instance in bit-sliced layout.
+    utils::ShardedInterningPool<BitSlicedDenotations> m_sliced_denots_cache;
+    PerElementMapping<BitSlicedDenotations*, nullptr> m_c_sliced_denots_mapping;
+    PerElementMapping<BitSlicedDenotations*, nullptr> m_r_sliced_denots_mapping;
     // Mapping from instance, state, element index to denotations
-    std::unordered_map<std::array<int, 3>, int> m_n_denots_mapping_per_state;
-    std::unordered_map<std::array<int, 3>, bool> m_b_denots_mapping_per_state;
-    std::unordered_map<std::array<int, 3>, ConceptDenotation*> m_c_denots_mapping_per_state;
-    std::unordered_map<std::array<int, 3>, RoleDenotation*> m_r_denots_mapping_per_state;
+    // Booleans are stored as 0 or 1 such that -1 can mark missing values.
+    PerStateMapping<int, std::numeric_limits<int>::min()> m_n_denots_mapping_per_state;
+    PerStateMapping<signed char, -1> m_b_denots_mapping_per_state;
+    PerStateMapping<ConceptDenotation*, nullptr> m_c_denots_mapping_per_state;
+    PerStateMapping<RoleDenotation*, nullptr> m_r_denots_mapping_per_state;
+    // Counters per element, filled only with DLPLAN_INSTRUMENTATION.
+    EvaluationStatisticsTable m_statistics;
+
+    DenotationsCaches();
+    /**
+     * Caches that evict per-state entries when they use more than byte_budget bytes.
+     */
+    explicit DenotationsCaches(std::size_t byte_budget);
+    DenotationsCaches(const DenotationsCaches& other) = delete;
+    DenotationsCaches& operator=(const DenotationsCaches& other) = delete;
+    ~DenotationsCaches();
+
+    /**
+     * Evicts entries if the caches exceed the budget and returns a lock
+     * that prevents other threads from evicting during the evaluation.
+     * The lock is empty if the caches are unbounded.
+     * Defined inline such that unbounded caches only pay for a comparison.
+     */
+    std::shared_lock<std::shared_mutex> begin_evaluation() {
+        if (!is_bounded()) return std::shared_lock<std::shared_mutex>();
+        return begin_bounded_evaluation();
+    }
+
+    /**
+     * Returns a pin that must be created before the evaluations whose results it protects.
+     */
+    Pin pin();
+
+    /**
+     * Stores the denotation of an element in a state
+     * and returns the stored denotation.
+     */
+    ConceptDenotation* insert(int instance_idx, int state_idx, int element_idx, std::unique_ptr<ConceptDenotation>&& denotation);
+    RoleDenotation* insert(int instance_idx, int state_idx, int element_idx, std::unique_ptr<RoleDenotation>&& denotation);
+
+    /**
+     * Returns an estimate of the number of bytes used by all caches.
+     */
+    std::size_t compute_num_bytes() const;
+
+    /**
+     * Evaluates collections of states with num_threads threads.
+     * The default of 1 evaluates on the calling thread.
+     * Results do not depend on the number of threads.
+     * Must not be called during an evaluation.
+     */
+    void set_num_threads(int num_threads);
+    int get_num_threads() const;
+
+    /**
+     * Calls function(begin, end) for consecutive chunks of [0, size),
+     * in parallel if there are several threads, and returns when all calls returned.
+     */
+    void for_each_chunk(std::size_t size, const std::function<void(std::size_t, std::size_t)>& function);
+
+    /**
+     * Returns the evaluation statistics of all elements
+     * as a human-readable table or as JSON.
+     */
+    std::string compute_statistics_table() const;
+    std::string compute_statistics_json() const;
+
+    bool is_bounded() const {
+        return m_byte_budget != std::numeric_limits<std::size_t>::max();
+    }
+
+    std::size_t get_byte_budget() const;
 };
 
 
@@ -355,20 +903,16 @@ public:
 
 /**
  * An Atom belongs to a specific instance.
+ * It is a view into the AtomTable of the instance
+ * and shares ownership of it such that it stays valid after the instance is released.
  */
 class Atom {
 private:
-    std::string m_name;
+    std::shared_ptr<const AtomTable> m_atom_table;
     int m_index;
-    Predicate m_predicate;
-    std::vector<Object> m_objects;
     bool m_is_static;
 
-    Atom(const std::string& name,
-        int index,
-        const Predicate& predicate,
-        const std::vector<Object> &objects,
-        bool is_static);
+    Atom(std::shared_ptr<const AtomTable> atom_table, int index, bool is_static);
     friend class InstanceInfo;
 
 public:
@@ -387,7 +931,13 @@ public:
     const std::string& get_name_ref() const;
     int get_index() const;
     const Predicate& get_predicate_ref() const;
-    const std::vector<Object>& get_objects_ref() const;
+    std::vector<Object> get_objects() const;
+    /**
+     * Atoms no longer store their objects, hence they are returned by value.
+     * Code that binds the result to a const reference keeps compiling.
+     */
+    [[deprecated("Atom::get_objects_ref returns a copy, use Atom::get_objects instead.")]]
+    std::vector<Object> get_objects_ref() const;
     const Object& get_object_ref(int pos) const;
     bool get_is_static() const;
 };
@@ -402,8 +952,12 @@ public:
 class State {
 private:
     std::shared_ptr<const InstanceInfo> m_instance_info;
+    // Sorted such that equal states have equal atom indices.
     Index_Vec m_atom_idxs;
     int m_index;
+    size_t m_hash;
+    // Built on first use and shared by copies.
+    mutable std::shared_ptr<const AtomIndex> m_atom_index;
 
 public:
     State(std::shared_ptr<const InstanceInfo> instance_info, const std::vector<Atom>& atoms, int index=-1);
@@ -411,7 +965,7 @@ public:
      * Expert interface to construct states without the overhead
      * of copying Atoms but instead working on indices directly.
      */
-    State(std::shared_ptr<const InstanceInfo> instance_info, const Index_Vec& atom_idxs, int index=-1);
+    State(std::shared_ptr<const InstanceInfo> instance_info, Index_Vec atom_idxs, int index=-1);
     State(const State& other);
     State& operator=(const State& other);
     State(State&& other);
@@ -427,7 +981,7 @@ public:
     std::string str() const;
 
     /**
-     * Compute a 64-Bit hash value.
+     * Returns the 64-Bit hash value computed at construction.
      */
     size_t compute_hash() const;
 
@@ -441,8 +995,15 @@ public:
      */
     const InstanceInfo& get_instance_info_ref() const;
     std::shared_ptr<const InstanceInfo> get_instance_info() const;
+    /**
+     * Returns the atom indices in increasing order.
+     */
     const Index_Vec& get_atom_idxs_ref() const;
     Index_Vec compute_sorted_atom_idxs() const;
+    /**
+     * Returns the atoms grouped by predicate.
+     */
+    const AtomIndex& get_atom_index_ref() const;
     int get_index() const;
 };
 
@@ -483,6 +1044,83 @@ public:
 };
 
 
+/**
+ * Atoms of an instance in flat arrays indexed by atom index.
+ * Atom objects are views into it.
+ */
+class AtomTable {
+private:
+    // The predicates and objects of the instance, for the names of atoms.
+    std::shared_ptr<const VocabularyInfo> m_vocabulary_info;
+    std::shared_ptr<const std::vector<Object>> m_objects;
+
+    std::vector<int> m_predicate_idxs;
+    // The objects of atom i are at positions m_object_offsets[i] to m_object_offsets[i+1].
+    std::vector<int> m_object_offsets;
+    std::vector<int> m_object_idxs;
+
+    // Names of the first m_num_names atoms. Atoms added in bulk are named on demand.
+    // A deque does not move its elements, hence the keys of the name map stay valid.
+    mutable std::deque<std::string> m_names;
+    mutable phmap::flat_hash_map<std::string_view, int> m_name_to_atom_idx;
+    mutable std::atomic<int> m_num_names;
+    mutable std::mutex m_names_mutex;
+
+    std::string compute_name(int predicate_idx, const int* object_idxs, int arity) const;
+    void compute_names() const;
+
+    friend class Atom;
+    friend class InstanceInfo;
+
+public:
+    AtomTable(std::shared_ptr<const VocabularyInfo> vocabulary_info, std::shared_ptr<const std::vector<Object>> objects);
+    AtomTable(const AtomTable& other);
+    AtomTable& operator=(const AtomTable& other);
+    AtomTable(AtomTable&& other);
+    AtomTable& operator=(AtomTable&& other);
+    ~AtomTable();
+
+    /**
+     * Reserves storage for num_atoms more atoms with num_object_idxs objects in total.
+     */
+    void reserve(int num_atoms, int num_object_idxs);
+
+    /**
+     * Returns the index of the atom
+     * and whether it was inserted because no such atom existed.
+     */
+    std::pair<int, bool> insert(int predicate_idx, const std::vector<int>& object_idxs);
+
+    /**
+     * Appends an atom without computing its name or checking for duplicates.
+     */
+    int push_back(int predicate_idx, const int* object_idxs, int arity);
+
+    /**
+     * Returns the index of the atom with the name or -1 if there is no such atom.
+     */
+    int find(const std::string& name) const;
+
+    int size() const {
+        return static_cast<int>(m_predicate_idxs.size());
+    }
+
+    int get_predicate_idx(int atom_idx) const {
+        return m_predicate_idxs[atom_idx];
+    }
+
+    int get_arity(int atom_idx) const {
+        return m_object_offsets[atom_idx + 1] - m_object_offsets[atom_idx];
+    }
+
+    const int* get_object_idxs(int atom_idx) const {
+        return m_object_idxs.data() + m_object_offsets[atom_idx];
+    }
+
+    const std::string& get_name_ref(int atom_idx) const;
+};
+
+
 /**
  * InstanceInfo stores information related to the planning instance.
  */
@@ -491,18 +1129,28 @@ private:
     std::shared_ptr<const VocabularyInfo> m_vocabulary_info;
     int m_index;
 
-    std::unordered_map<std::string, unsigned> m_atom_name_to_atom_idx;
+    // The atoms are views into the tables. The tables and objects are shared with the atoms.
+    std::shared_ptr<AtomTable> m_atom_table;
     std::vector<Atom> m_atoms;
 
-    std::unordered_map<std::string, unsigned> m_static_atom_name_to_static_atom_idx;
+    std::shared_ptr<AtomTable> m_static_atom_table;
     std::vector<Atom> m_static_atoms;
     phmap::flat_hash_map<int, std::vector<int>> m_per_predicate_idx_static_atom_idxs;
+    // Built on first use and reset when static atoms or objects are added.
+    mutable std::shared_ptr<const StaticAtomMasks> m_static_atom_masks;
 
     std::unordered_map<std::string, unsigned> m_object_name_to_object_idx;
-    std::vector<Object> m_objects;
+    std::shared_ptr<std::vector<Object>> m_objects;
+    // Object index per constant of the vocabulary or -1 if the instance has no such object.
+    std::vector<int> m_constant_idx_to_object_idx;
 
     const Atom& add_atom(const std::string &predicate_name, const Name_Vec &object_names, bool is_static);
     const Atom& add_atom(const Predicate& predicate, const std::vector<Object>& objects, bool is_static);
+    const Atom& add_atom(const Predicate& predicate, const std::vector<int>& object_idxs, bool is_static);
+    int add_atoms(const Index_Vec& predicate_idxs, const Index_Vec& object_idxs, bool is_static);
+    void map_constant(const Object& object);
+    // Lets the atoms and tables view the tables and objects of this instance after it was copied.
+    void reset_atom_views();
 
 public:
     InstanceInfo() = delete;
@@ -526,6 +1174,19 @@ public:
     const Atom& add_atom(const std::string& predicate_name, const Name_Vec& object_names);
     const Atom& add_static_atom(const std::string& predicate_name, const Name_Vec& object_names);
 
+    /**
+     * Alternative 3 to add atoms: bulk construction from integer-grounded atoms.
+     * Atom i has predicate predicate_idxs[i] and the next arity many
+     * entries of object_idxs as objects, which are indices of objects of the instance.
+     * The atoms must be distinct and not exist in the instance yet.
+     * Their names are only computed when requested,
+     * which throws a runtime_error if the atoms are not distinct.
+     * Returns the index of the first added atom.
+     */
+    int add_objects(const Name_Vec& object_names);
+    int add_atoms(const Index_Vec& predicate_idxs, const Index_Vec& object_idxs);
+    int add_static_atoms(const Index_Vec& predicate_idxs, const Index_Vec& object_idxs);
+
     /**
      * Setters.
      */
@@ -538,6 +1199,8 @@ public:
     bool exists_atom(const Atom& atom) const;
     const std::vector<Atom>& get_atoms_ref() const;
     const std::vector<Atom>& get_static_atoms_ref() const;
+    const AtomTable& get_atom_table_ref() const;
+    const AtomTable& get_static_atom_table_ref() const;
     const Atom& get_atom_ref(int index) const;
     int get_atom_idx(const std::string& name) const;
     bool exists_object(const Object& object) const;
@@ -545,10 +1208,19 @@ public:
     const std::vector<Object>& get_objects_ref() const;
     const Object& get_object_ref(int index) const;
     int get_object_idx(const std::string& name) const;
+    /**
+     * Returns the index of the object that has the name of the constant
+     * without looking up the name or -1 if there is no such object.
+     */
+    int get_constant_object_idx(const Constant& constant) const;
     int get_num_objects() const;
     const VocabularyInfo& get_vocabulary_info_ref() const;
     std::shared_ptr<const VocabularyInfo> get_vocabulary_info() const;
     const phmap::flat_hash_map<int, std::vector<int>>& get_per_predicate_idx_static_atom_idxs_ref() const;
+    /**
+     * Returns the denotations of the static atoms per predicate and position.
+     */
+    const StaticAtomMasks& get_static_atom_masks_ref() const;
 };
 
 
@@ -612,6 +1284,10 @@ public:
     ConceptDenotation evaluate(const State& state) const;
     ConceptDenotation* evaluate(const State& state, DenotationsCaches& caches) const;
     ConceptDenotations* evaluate(const States& states, DenotationsCaches& caches) const;
+    /**
+     * Evaluate for a collection of states of the same instance in bit-sliced layout.
+     */
+    BitSlicedDenotations* evaluate_sliced(const States& states, DenotationsCaches& caches) const;
 
     int compute_complexity() const override;
 
@@ -642,6 +1318,10 @@ public:
     RoleDenotation evaluate(const State& state) const;
     RoleDenotation* evaluate(const State& state, DenotationsCaches& caches) const;
     RoleDenotations* evaluate(const States& states, DenotationsCaches& caches) const;
+    /**
+     * Evaluate for a collection of states of the same instance in bit-sliced layout.
+     */
+    BitSlicedDenotations* evaluate_sliced(const States& states, DenotationsCaches& caches) const;
 
     int compute_complexity() const override;
 
@@ -796,6 +1476,58 @@ public:
     Role make_transitive_reflexive_closure(const Role& role, int index=-1);
 };
 
+
+/**
+ * FeatureProgram compiles a set of Booleans and Numericals into a list of instructions,
+ * one per distinct element, ordered such that children come before their parents.
+ * Elements shared by several features are evaluated once per state.
+ * Denotations are written into registers that are allocated once per number of objects,
+ * hence evaluation requires no caches.
+ * A FeatureProgram must not be evaluated by several threads at once.
+ */
+class FeatureProgram {
+private:
+    utils::pimpl<FeatureProgramImpl> m_pImpl;
+
+public:
+    FeatureProgram(const std::vector<Boolean>& booleans, const std::vector<Numerical>& numericals);
+    /**
+     * Compiles the features of a policy, see Policy::get_boolean_features.
+     */
+    FeatureProgram(const std::vector<std::shared_ptr<const Boolean>>& booleans, const std::vector<std::shared_ptr<const Numerical>>& numericals);
+    FeatureProgram(const FeatureProgram& other);
+    FeatureProgram& operator=(const FeatureProgram& other);
+    FeatureProgram(FeatureProgram&& other);
+    FeatureProgram& operator=(FeatureProgram&& other);
+    ~FeatureProgram();
+
+    /**
+     * Evaluates all features in the state.
+     */
+    void evaluate(const State& state);
+
+    /**
+     * Evaluates all features in the state by updating the values of the last evaluated state,
+     * e.g., its parent in a search. Only elements that read a predicate of an atom
+     * in which both states differ and elements whose children changed are recomputed.
+     * Falls back to evaluate if the states belong to different instances.
+     */
+    void evaluate_incrementally(const State& state);
+
+    /**
+     * Returns the value of the feature at the given position
+     * of the constructor argument in the last evaluated state.
+     */
+    bool get_boolean_value(int boolean_idx) const;
+    int get_numerical_value(int numerical_idx) const;
+
+    int get_num_instructions() const;
+    /**
+     * Returns the number of instructions that the last evaluation executed.
+     */
+    int get_num_executed_instructions() const;
+};
+
 }
 
 #endif
@@ -0,0 +1,95 @@
+#ifndef DLPLAN_INCLUDE_DLPLAN_UTILS_ATOMIC_VECTOR_H_
+#define DLPLAN_INCLUDE_DLPLAN_UTILS_ATOMIC_VECTOR_H_
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <new>
+
+
+namespace dlplan::utils {
+
+/**
+ * A growable array whose slots can be read without locks
+ * while another thread writes to it.
+ * Writes must be serialized by the caller.
+ * Growing copies the slots into a larger buffer.
+ * The previous buffers stay alive until destruction,
+ * such that concurrent readers never access freed memory.
+ * Slots that were never written hold DEFAULT.
+ */
+template<typename T, T DEFAULT>
+class AtomicVector {
+private:
+    struct Buffer {
+        std::size_t size;
+        Buffer* previous;
+
+        std::atomic<T>* data() {
+            return reinterpret_cast<std::atomic<T>*>(this + 1);
+        }
+    };
+    static_assert(alignof(std::atomic<T>) <= alignof(Buffer), "Slots must fit the alignment of the buffer header.");
+
+    std::atomic<Buffer*> m_buffer;
+
+    static Buffer* allocate(std::size_t size, Buffer* previous) {
+        void* memory = ::operator new(sizeof(Buffer) + size * sizeof(std::atomic<T>));
+        Buffer* buffer = new (memory) Buffer{size, previous};
+        std::atomic<T>* data = buffer->data();
+        const std::size_t num_copied = previous ? previous->size : 0;
+        for (std::size_t i = 0; i < num_copied; ++i) {
+            new (&data[i]) std::atomic<T>(previous->data()[i].load(std::memory_order_relaxed));
+        }
+        for (std::size_t i = num_copied; i < size; ++i) {
+            new (&data[i]) std::atomic<T>(DEFAULT);
+        }
+        return buffer;
+    }
+
+public:
+    AtomicVector() : m_buffer(nullptr) { }
+    AtomicVector(const AtomicVector& other) = delete;
+    AtomicVector& operator=(const AtomicVector& other) = delete;
+    ~AtomicVector() {
+        Buffer* buffer = m_buffer.load(std::memory_order_relaxed);
+        while (buffer) {
+            Buffer* previous = buffer->previous;
+            ::operator delete(buffer);
+            buffer = previous;
+        }
+    }
+
+    T load(std::size_t index) const {
+        Buffer* buffer = m_buffer.load(std::memory_order_acquire);
+        if (!buffer || index >= buffer->size) return DEFAULT;
+        return buffer->data()[index].load(std::memory_order_acquire);
+    }
+
+    void store(std::size_t index, T value) {
+        Buffer* buffer = m_buffer.load(std::memory_order_relaxed);
+        if (!buffer || index >= buffer->size) {
+            std::size_t size = std::max<std::size_t>({8, index + 1, buffer ? 2 * buffer->size : 0});
+            buffer = allocate(size, buffer);
+            m_buffer.store(buffer, std::memory_order_release);
+        }
+        buffer->data()[index].store(value, std::memory_order_release);
+    }
+
+    /**
+     * Calls f on every slot value.
+     * Must not run concurrently with writes.
+     */
+    template<typename F>
+    void for_each(F&& f) const {
+        Buffer* buffer = m_buffer.load(std::memory_order_acquire);
+        if (!buffer) return;
+        for (std::size_t i = 0; i < buffer->size; ++i) {
+            f(buffer->data()[i].load(std::memory_order_relaxed));
+        }
+    }
+};
+
+}
+
+#endif
@@ -0,0 +1,575 @@
+#ifndef DLPLAN_INCLUDE_DLPLAN_UTILS_BITSET_KERNELS_H_
+#define DLPLAN_INCLUDE_DLPLAN_UTILS_BITSET_KERNELS_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define DLPLAN_BITSET_X86_KERNELS
+#include <immintrin.h>
+#endif
+
+
+/*
+  Word-parallel kernels over arrays of 64-bit blocks.
+  The best implementation for the executing CPU is selected once at runtime.
+  Every kernel assumes that the arrays do not overlap partially.
+*/
+namespace dlplan::utils::kernels {
+
+enum class InstructionSet {
+    SCALAR,
+    POPCNT,
+    AVX2,
+    AVX512,
+};
+
+struct BitsetKernels {
+    InstructionSet instruction_set;
+    void (*bitwise_and)(std::uint64_t* left, const std::uint64_t* right, std::size_t num_blocks);
+    void (*bitwise_or)(std::uint64_t* left, const std::uint64_t* right, std::size_t num_blocks);
+    void (*bitwise_andnot)(std::uint64_t* left, const std::uint64_t* right, std::size_t num_blocks);
+    void (*bitwise_not)(std::uint64_t* data, std::size_t num_blocks);
+    bool (*intersects)(const std::uint64_t* left, const std::uint64_t* right, std::size_t num_blocks);
+    bool (*is_subset_of)(const std::uint64_t* left, const std::uint64_t* right, std::size_t num_blocks);
+    bool (*none)(const std::uint64_t* data, std::size_t num_blocks);
+    bool (*equal)(const std::uint64_t* left, const std::uint64_t* right, std::size_t num_blocks);
+    std::size_t (*count)(const std::uint64_t* data, std::size_t num_blocks);
+};
+
+/**
+ * Below this number of blocks the call through a function pointer
+ * costs more than the operation itself, so callers should loop inline.
+ */
+const std::size_t MIN_BLOCKS_FOR_DISPATCH = 8;
+
+/**
+ * Whether scalar::popcount compiles to a hardware instruction.
+ * On x86 without -mpopcnt it calls into the compiler runtime once per block,
+ * so the dispatched count is faster for any number of blocks.
+ */
+#if defined(DLPLAN_BITSET_X86_KERNELS) && !defined(__POPCNT__)
+const bool HAS_INLINE_POPCOUNT = false;
+#else
+const bool HAS_INLINE_POPCOUNT = true;
+#endif
+
+
+namespace scalar {
+
+inline void bitwise_and(std::uint64_t* left, const std::uint64_t* right, std::size_t num_blocks) {
+    for (std::size_t i = 0; i < num_blocks; ++i) left[i] &= right[i];
+}
+
+inline void bitwise_or(std::uint64_t* left, const std::uint64_t* right, std::size_t num_blocks) {
+    for (std::size_t i = 0; i < num_blocks; ++i) left[i] |= right[i];
+}
+
+inline void bitwise_andnot(std::uint64_t* left, const std::uint64_t* right, std::size_t num_blocks) {
+    for (std::size_t i = 0; i < num_blocks; ++i) left[i] &= ~right[i];
+}
+
+inline void bitwise_not(std::uint64_t* data, std::size_t num_blocks) {
+    for (std::size_t i = 0; i < num_blocks; ++i) data[i] = ~data[i];
+}
+
+inline bool intersects(const std::uint64_t* left, const std::uint64_t* right, std::size_t num_blocks) {
+    for (std::size_t i = 0; i < num_blocks; ++i) {
+        if (left[i] & right[i]) return true;
+    }
+    return false;
+}
+
+inline bool is_subset_of(const std::uint64_t* left, const std::uint64_t* right, std::size_t num_blocks) {
+    for (std::size_t i = 0; i < num_blocks; ++i) {
+        if (left[i] & ~right[i]) return false;
+    }
+    return true;
+}
+
+inline bool none(const std::uint64_t* data, std::size_t num_blocks) {
+    for (std::size_t i = 0; i < num_blocks; ++i) {
+        if (data[i]) return false;
+    }
+    return true;
+}
+
+inline bool equal(const std::uint64_t* left, const std::uint64_t* right, std::size_t num_blocks) {
+    for (std::size_t i = 0; i < num_blocks; ++i) {
+        if (left[i] != right[i]) return false;
+    }
+    return true;
+}
+
+inline int popcount(std::uint64_t block) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_popcountll(block);
+#else
+    // https://en.wikipedia.org/wiki/Hamming_weight
+    block = block - ((block >> 1) & 0x5555555555555555ULL);
+    block = (block & 0x3333333333333333ULL) + ((block >> 2) & 0x3333333333333333ULL);
+    block = (block + (block >> 4)) & 0x0f0f0f0f0f0f0f0fULL;
+    return static_cast<int>((block * 0x0101010101010101ULL) >> 56);
+#endif
+}
+
+/**
+ * Returns the position of the least significant set bit. The block must not be zero.
+ */
+inline int count_trailing_zeros(std::uint64_t block) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(block);
+#else
+    int result = 0;
+    while (!(block & 1)) {
+        block >>= 1;
+        ++result;
+    }
+    return result;
+#endif
+}
+
+inline std::size_t count(const std::uint64_t* data, std::size_t num_blocks) {
+    std::size_t result = 0;
+    for (std::size_t i = 0; i < num_blocks; ++i) result += popcount(data[i]);
+    return result;
+}
+
+}
+
+
+/*
+  Kernels with a trip count that is known at compile time.
+  They are used for bitsets with inline storage, whose blocks are zero
+  beyond the used size, such that the size can be rounded up to a power of two.
+  The compiler unrolls the loops and keeps small bitsets in vector registers.
+*/
+namespace fixed {
+
+template<std::size_t N, typename Block>
+inline void bitwise_and(Block* left, const Block* right) {
+    for (std::size_t i = 0; i < N; ++i) left[i] &= right[i];
+}
+
+template<std::size_t N, typename Block>
+inline void bitwise_or(Block* left, const Block* right) {
+    for (std::size_t i = 0; i < N; ++i) left[i] |= right[i];
+}
+
+template<std::size_t N, typename Block>
+inline void bitwise_andnot(Block* left, const Block* right) {
+    for (std::size_t i = 0; i < N; ++i) left[i] &= static_cast<Block>(~right[i]);
+}
+
+template<std::size_t N, typename Block>
+inline bool intersects(const Block* left, const Block* right) {
+    Block result = 0;
+    for (std::size_t i = 0; i < N; ++i) result |= left[i] & right[i];
+    return result != 0;
+}
+
+template<std::size_t N, typename Block>
+inline bool is_subset_of(const Block* left, const Block* right) {
+    Block result = 0;
+    for (std::size_t i = 0; i < N; ++i) result |= left[i] & static_cast<Block>(~right[i]);
+    return result == 0;
+}
+
+template<std::size_t N, typename Block>
+inline bool none(const Block* data) {
+    Block result = 0;
+    for (std::size_t i = 0; i < N; ++i) result |= data[i];
+    return result == 0;
+}
+
+template<std::size_t N, typename Block>
+inline bool equal(const Block* left, const Block* right) {
+    Block result = 0;
+    for (std::size_t i = 0; i < N; ++i) result |= left[i] ^ right[i];
+    return result == 0;
+}
+
+template<std::size_t N, typename Block>
+inline std::size_t count(const Block* data) {
+    std::size_t result = 0;
+    for (std::size_t i = 0; i < N; ++i) result += scalar::popcount(data[i]);
+    return result;
+}
+
+}
+
+
+#ifdef DLPLAN_BITSET_X86_KERNELS
+
+namespace popcnt {
+
+__attribute__((target("popcnt")))
+inline std::size_t count(const std::uint64_t* data, std::size_t num_blocks) {
+    // Four independent accumulators hide the latency of popcnt.
+    std::uint64_t c0 = 0, c1 = 0, c2 = 0, c3 = 0;
+    std::size_t i = 0;
+    for (; i + 4 <= num_blocks; i += 4) {
+        c0 += _mm_popcnt_u64(data[i]);
+        c1 += _mm_popcnt_u64(data[i + 1]);
+        c2 += _mm_popcnt_u64(data[i + 2]);
+        c3 += _mm_popcnt_u64(data[i + 3]);
+    }
+    for (; i < num_blocks; ++i) c0 += _mm_popcnt_u64(data[i]);
+    return c0 + c1 + c2 + c3;
+}
+
+}
+
+
+namespace avx2 {
+
+#define DLPLAN_AVX2 __attribute__((target("avx2,popcnt")))
+
+DLPLAN_AVX2
+inline void bitwise_and(std::uint64_t* left, const std::uint64_t* right, std::size_t num_blocks) {
+    std::size_t i = 0;
+    for (; i + 4 <= num_blocks; i += 4) {
+        __m256i l = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(left + i));
+        __m256i r = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(right + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(left + i), _mm256_and_si256(l, r));
+    }
+    for (; i < num_blocks; ++i) left[i] &= right[i];
+}
+
+DLPLAN_AVX2
+inline void bitwise_or(std::uint64_t* left, const std::uint64_t* right, std::size_t num_blocks) {
+    std::size_t i = 0;
+    for (; i + 4 <= num_blocks; i += 4) {
+        __m256i l = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(left + i));
+        __m256i r = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(right + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(left + i), _mm256_or_si256(l, r));
+    }
+    for (; i < num_blocks; ++i) left[i] |= right[i];
+}
+
+DLPLAN_AVX2
+inline void bitwise_andnot(std::uint64_t* left, const std::uint64_t* right, std::size_t num_blocks) {
+    std::size_t i = 0;
+    for (; i + 4 <= num_blocks; i += 4) {
+        __m256i l = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(left + i));
+        __m256i r = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(right + i));
+        // _mm256_andnot_si256(a, b) computes ~a & b
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(left + i), _mm256_andnot_si256(r, l));
+    }
+    for (; i < num_blocks; ++i) left[i] &= ~right[i];
+}
+
+DLPLAN_AVX2
+inline void bitwise_not(std::uint64_t* data, std::size_t num_blocks) {
+    const __m256i ones = _mm256_set1_epi64x(-1);
+    std::size_t i = 0;
+    for (; i + 4 <= num_blocks; i += 4) {
+        __m256i d = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(data + i), _mm256_xor_si256(d, ones));
+    }
+    for (; i < num_blocks; ++i) data[i] = ~data[i];
+}
+
+DLPLAN_AVX2
+inline bool intersects(const std::uint64_t* left, const std::uint64_t* right, std::size_t num_blocks) {
+    std::size_t i = 0;
+    for (; i + 4 <= num_blocks; i += 4) {
+        __m256i l = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(left + i));
+        __m256i r = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(right + i));
+        if (!_mm256_testz_si256(l, r)) return true;
+    }
+    for (; i < num_blocks; ++i) {
+        if (left[i] & right[i]) return true;
+    }
+    return false;
+}
+
+DLPLAN_AVX2
+inline bool is_subset_of(const std::uint64_t* left, const std::uint64_t* right, std::size_t num_blocks) {
+    std::size_t i = 0;
+    for (; i + 4 <= num_blocks; i += 4) {
+        __m256i l = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(left + i));
+        __m256i r = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(right + i));
+        // _mm256_testc_si256(a, b) tests ~a & b == 0
+        if (!_mm256_testc_si256(r, l)) return false;
+    }
+    for (; i < num_blocks; ++i) {
+        if (left[i] & ~right[i]) return false;
+    }
+    return true;
+}
+
+DLPLAN_AVX2
+inline bool none(const std::uint64_t* data, std::size_t num_blocks) {
+    std::size_t i = 0;
+    for (; i + 4 <= num_blocks; i += 4) {
+        __m256i d = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        if (!_mm256_testz_si256(d, d)) return false;
+    }
+    for (; i < num_blocks; ++i) {
+        if (data[i]) return false;
+    }
+    return true;
+}
+
+DLPLAN_AVX2
+inline bool equal(const std::uint64_t* left, const std::uint64_t* right, std::size_t num_blocks) {
+    std::size_t i = 0;
+    for (; i + 4 <= num_blocks; i += 4) {
+        __m256i l = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(left + i));
+        __m256i r = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(right + i));
+        __m256i x = _mm256_xor_si256(l, r);
+        if (!_mm256_testz_si256(x, x)) return false;
+    }
+    for (; i < num_blocks; ++i) {
+        if (left[i] != right[i]) return false;
+    }
+    return true;
+}
+
+/*
+  Nibble lookup popcount of Mula, Kurz and Lemire:
+  "Faster Population Counts Using AVX2 Instructions", 2018.
+*/
+DLPLAN_AVX2
+inline __m256i popcount_bytes(__m256i v) {
+    const __m256i lookup = _mm256_setr_epi8(
+        0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+        0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    const __m256i low_mask = _mm256_set1_epi8(0x0f);
+    __m256i lo = _mm256_and_si256(v, low_mask);
+    __m256i hi = _mm256_and_si256(_mm256_srli_epi16(v, 4), low_mask);
+    return _mm256_add_epi8(_mm256_shuffle_epi8(lookup, lo), _mm256_shuffle_epi8(lookup, hi));
+}
+
+DLPLAN_AVX2
+inline std::size_t count(const std::uint64_t* data, std::size_t num_blocks) {
+    __m256i acc = _mm256_setzero_si256();
+    std::size_t i = 0;
+    for (; i + 4 <= num_blocks; i += 4) {
+        __m256i d = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        // Horizontal byte sums into four 64-bit lanes cannot overflow.
+        acc = _mm256_add_epi64(acc, _mm256_sad_epu8(popcount_bytes(d), _mm256_setzero_si256()));
+    }
+    std::size_t result =
+          static_cast<std::size_t>(_mm256_extract_epi64(acc, 0))
+        + static_cast<std::size_t>(_mm256_extract_epi64(acc, 1))
+        + static_cast<std::size_t>(_mm256_extract_epi64(acc, 2))
+        + static_cast<std::size_t>(_mm256_extract_epi64(acc, 3));
+    for (; i < num_blocks; ++i) result += _mm_popcnt_u64(data[i]);
+    return result;
+}
+
+#undef DLPLAN_AVX2
+
+}
+
+
+namespace avx512 {
+
+#define DLPLAN_AVX512 __attribute__((target("avx512f,popcnt")))
+
+DLPLAN_AVX512
+inline void bitwise_and(std::uint64_t* left, const std::uint64_t* right, std::size_t num_blocks) {
+    std::size_t i = 0;
+    for (; i + 8 <= num_blocks; i += 8) {
+        __m512i l = _mm512_loadu_si512(left + i);
+        __m512i r = _mm512_loadu_si512(right + i);
+        _mm512_storeu_si512(left + i, _mm512_and_si512(l, r));
+    }
+    for (; i < num_blocks; ++i) left[i] &= right[i];
+}
+
+DLPLAN_AVX512
+inline void bitwise_or(std::uint64_t* left, const std::uint64_t* right, std::size_t num_blocks) {
+    std::size_t i = 0;
+    for (; i + 8 <= num_blocks; i += 8) {
+        __m512i l = _mm512_loadu_si512(left + i);
+        __m512i r = _mm512_loadu_si512(right + i);
+        _mm512_storeu_si512(left + i, _mm512_or_si512(l, r));
+    }
+    for (; i < num_blocks; ++i) left[i] |= right[i];
+}
+
+DLPLAN_AVX512
+inline void bitwise_andnot(std::uint64_t* left, const std::uint64_t* right, std::size_t num_blocks) {
+    // _mm512_andnot_si512 triggers spurious -Wuninitialized warnings in GCC 12.
+    const __m512i ones = _mm512_set1_epi64(-1);
+    std::size_t i = 0;
+    for (; i + 8 <= num_blocks; i += 8) {
+        __m512i l = _mm512_loadu_si512(left + i);
+        __m512i r = _mm512_loadu_si512(right + i);
+        _mm512_storeu_si512(left + i, _mm512_and_si512(l, _mm512_xor_si512(r, ones)));
+    }
+    for (; i < num_blocks; ++i) left[i] &= ~right[i];
+}
+
+DLPLAN_AVX512
+inline void bitwise_not(std::uint64_t* data, std::size_t num_blocks) {
+    const __m512i ones = _mm512_set1_epi64(-1);
+    std::size_t i = 0;
+    for (; i + 8 <= num_blocks; i += 8) {
+        __m512i d = _mm512_loadu_si512(data + i);
+        _mm512_storeu_si512(data + i, _mm512_xor_si512(d, ones));
+    }
+    for (; i < num_blocks; ++i) data[i] = ~data[i];
+}
+
+DLPLAN_AVX512
+inline bool intersects(const std::uint64_t* left, const std::uint64_t* right, std::size_t num_blocks) {
+    std::size_t i = 0;
+    for (; i + 8 <= num_blocks; i += 8) {
+        __m512i l = _mm512_loadu_si512(left + i);
+        __m512i r = _mm512_loadu_si512(right + i);
+        if (_mm512_test_epi64_mask(l, r)) return true;
+    }
+    for (; i < num_blocks; ++i) {
+        if (left[i] & right[i]) return true;
+    }
+    return false;
+}
+
+DLPLAN_AVX512
+inline bool is_subset_of(const std::uint64_t* left, const std::uint64_t* right, std::size_t num_blocks) {
+    const __m512i ones = _mm512_set1_epi64(-1);
+    std::size_t i = 0;
+    for (; i + 8 <= num_blocks; i += 8) {
+        __m512i l = _mm512_loadu_si512(left + i);
+        __m512i r = _mm512_loadu_si512(right + i);
+        if (_mm512_test_epi64_mask(l, _mm512_xor_si512(r, ones))) return false;
+    }
+    for (; i < num_blocks; ++i) {
+        if (left[i] & ~right[i]) return false;
+    }
+    return true;
+}
+
+DLPLAN_AVX512
+inline bool none(const std::uint64_t* data, std::size_t num_blocks) {
+    std::size_t i = 0;
+    for (; i + 8 <= num_blocks; i += 8) {
+        __m512i d = _mm512_loadu_si512(data + i);
+        if (_mm512_test_epi64_mask(d, d)) return false;
+    }
+    for (; i < num_blocks; ++i) {
+        if (data[i]) return false;
+    }
+    return true;
+}
+
+DLPLAN_AVX512
+inline bool equal(const std::uint64_t* left, const std::uint64_t* right, std::size_t num_blocks) {
+    std::size_t i = 0;
+    for (; i + 8 <= num_blocks; i += 8) {
+        __m512i l = _mm512_loadu_si512(left + i);
+        __m512i r = _mm512_loadu_si512(right + i);
+        if (_mm512_cmpneq_epi64_mask(l, r)) return false;
+    }
+    for (; i < num_blocks; ++i) {
+        if (left[i] != right[i]) return false;
+    }
+    return true;
+}
+
+#undef DLPLAN_AVX512
+
+__attribute__((target("avx512f,avx512vpopcntdq,popcnt")))
+inline std::size_t count_vpopcntdq(const std::uint64_t* data, std::size_t num_blocks) {
+    __m512i acc = _mm512_setzero_si512();
+    std::size_t i = 0;
+    for (; i + 8 <= num_blocks; i += 8) {
+        acc = _mm512_add_epi64(acc, _mm512_popcnt_epi64(_mm512_loadu_si512(data + i)));
+    }
+    alignas(64) std::uint64_t lanes[8];
+    _mm512_store_si512(lanes, acc);
+    std::size_t result = 0;
+    for (std::uint64_t lane : lanes) result += lane;
+    for (; i < num_blocks; ++i) result += _mm_popcnt_u64(data[i]);
+    return result;
+}
+
+}
+
+#endif
+
+
+inline const BitsetKernels& get_kernels(InstructionSet instruction_set) {
+    static const BitsetKernels scalar_kernels = {
+        InstructionSet::SCALAR,
+        scalar::bitwise_and, scalar::bitwise_or, scalar::bitwise_andnot, scalar::bitwise_not,
+        scalar::intersects, scalar::is_subset_of, scalar::none, scalar::equal, scalar::count
+    };
+#ifdef DLPLAN_BITSET_X86_KERNELS
+    static const BitsetKernels popcnt_kernels = {
+        InstructionSet::POPCNT,
+        scalar::bitwise_and, scalar::bitwise_or, scalar::bitwise_andnot, scalar::bitwise_not,
+        scalar::intersects, scalar::is_subset_of, scalar::none, scalar::equal, popcnt::count
+    };
+    static const BitsetKernels avx2_kernels = {
+        InstructionSet::AVX2,
+        avx2::bitwise_and, avx2::bitwise_or, avx2::bitwise_andnot, avx2::bitwise_not,
+        avx2::intersects, avx2::is_subset_of, avx2::none, avx2::equal, avx2::count
+    };
+    // Without VPOPCNTDQ the AVX2 nibble lookup is the fastest population count.
+    static const BitsetKernels avx512_kernels = [] {
+        __builtin_cpu_init();
+        return BitsetKernels{
+            InstructionSet::AVX512,
+            avx512::bitwise_and, avx512::bitwise_or, avx512::bitwise_andnot, avx512::bitwise_not,
+            avx512::intersects, avx512::is_subset_of, avx512::none, avx512::equal,
+            __builtin_cpu_supports("avx512vpopcntdq") ? avx512::count_vpopcntdq : avx2::count
+        };
+    }();
+    switch (instruction_set) {
+        case InstructionSet::POPCNT: return popcnt_kernels;
+        case InstructionSet::AVX2: return avx2_kernels;
+        case InstructionSet::AVX512: return avx512_kernels;
+        default: break;
+    }
+#endif
+    return scalar_kernels;
+}
+
+/**
+ * Returns the most capable instruction set supported by the executing CPU.
+ */
+inline InstructionSet detect_instruction_set() {
+    static const InstructionSet instruction_set = [] {
+#ifdef DLPLAN_BITSET_X86_KERNELS
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx2") && __builtin_cpu_supports("popcnt")) {
+            return InstructionSet::AVX512;
+        }
+        if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("popcnt")) {
+            return InstructionSet::AVX2;
+        }
+        if (__builtin_cpu_supports("popcnt")) {
+            return InstructionSet::POPCNT;
+        }
+#endif
+        return InstructionSet::SCALAR;
+    }();
+    return instruction_set;
+}
+
+/**
+ * Returns the kernels selected for the executing CPU.
+ */
+inline const BitsetKernels& get_kernels() {
+    static const BitsetKernels& kernels = get_kernels(detect_instruction_set());
+    return kernels;
+}
+
+inline std::string to_string(InstructionSet instruction_set) {
+    switch (instruction_set) {
+        case InstructionSet::POPCNT: return "popcnt";
+        case InstructionSet::AVX2: return "avx2";
+        case InstructionSet::AVX512: return "avx512";
+        default: return "scalar";
+    }
+}
+
+}
+
+#endif
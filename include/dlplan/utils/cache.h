@@ -1,9 +1,12 @@
 #ifndef DLPLAN_INCLUDE_DLPLAN_UTILS_CACHE_H_
 #define DLPLAN_INCLUDE_DLPLAN_UTILS_CACHE_H_
 
+#include <array>
+#include <atomic>
 #include <unordered_map>
 #include <memory>
 #include <mutex>
+#include <shared_mutex>
 #include <iostream>
 
 
@@ -27,19 +30,92 @@ public:
 template<typename KEY, typename VALUE>
 class ReferenceCountedObjectCache : public std::enable_shared_from_this<ReferenceCountedObjectCache<KEY, VALUE>> {
 private:
-    std::unordered_map<KEY, std::weak_ptr<VALUE>> m_cache;
+    /**
+     * The keys are distributed over shards by their hash
+     * such that threads that access different keys rarely wait for each other.
+     * Lookups of live entries only take a shared lock of their shard.
+     */
+    struct Shard {
+        std::unordered_map<KEY, std::weak_ptr<VALUE>> m_cache;
+        mutable std::shared_mutex m_mutex;
+    };
+
+    static constexpr std::size_t NUM_SHARDS = 16;
+
+    std::array<Shard, NUM_SHARDS> m_shards;
 
     /**
      * A nonfragmented indexing scheme is obtained if no elements are deleted after insertion.
      * A nonfragmented indexing scheme is useful when caching Denotations in a vector.
      * A fragmented indexing scheme can still be used when caching denotation in an unordered_map.
      */
-    int m_index_counter;
+    std::atomic<int> m_index_counter;
+
+    Shard& get_shard(const KEY& key) {
+        return m_shards[std::hash<KEY>()(key) % NUM_SHARDS];
+    }
+
+    std::shared_ptr<VALUE> find(Shard& shard, const KEY& key) {
+        std::shared_lock<std::shared_mutex> hold(shard.m_mutex);
+        auto it = shard.m_cache.find(key);
+        return (it != shard.m_cache.end()) ? it->second.lock() : nullptr;
+    }
 
     /**
-     * For multi-threading purposes
+     * Takes ownership of the element and removes the entry of the key
+     * when the last reference to the element is released.
      */
-    mutable std::mutex m_mutex;
+    std::shared_ptr<VALUE> make_cached(const KEY& key, std::unique_ptr<VALUE>&& element) {
+        std::shared_ptr<VALUE> sp(
+            element.get(),
+            [key, parent=this->shared_from_this(), original_deleter=element.get_deleter()](VALUE* x)
+            {
+                {
+                    Shard& shard = parent->get_shard(key);
+                    std::unique_lock<std::shared_mutex> hold(shard.m_mutex);
+                    auto it = shard.m_cache.find(key);
+                    // Another thread may have cached a new element for the key in the meantime.
+                    if (it != shard.m_cache.end() && it->second.expired()) {
+                        shard.m_cache.erase(it);
+                    }
+                }
+                /* After cache removal, we can call the objects destructor
+                   and recursively call the deleter of children if their ref count goes to 0 */
+                original_deleter(x);
+            }
+        );
+        element.release();
+        return sp;
+    }
+
+    template<typename CREATE>
+    std::pair<std::shared_ptr<VALUE>, bool> get_or_create(const KEY& key, CREATE create, bool set_index) {
+        Shard& shard = get_shard(key);
+        /* we must declare sp before locking the mutex
+           s.t. the deleter is called after the mutex was released in case of stack unwinding. */
+        std::shared_ptr<VALUE> sp = find(shard, key);
+        if (sp) {
+            return std::make_pair(sp, false);
+        }
+        std::unique_lock<std::shared_mutex> hold(shard.m_mutex);
+        auto it = shard.m_cache.emplace(key, std::weak_ptr<VALUE>()).first;
+        sp = it->second.lock();
+        if (sp) {
+            return std::make_pair(sp, false);
+        }
+        std::unique_ptr<VALUE> element;
+        try {
+            element = create();
+        } catch (...) {
+            shard.m_cache.erase(it);
+            throw;
+        }
+        if (set_index) {
+            element->set_index(m_index_counter.fetch_add(1, std::memory_order_relaxed));
+        }
+        it->second = sp = make_cached(key, std::move(element));
+        return std::make_pair(sp, true);
+    }
 
 public:
     ReferenceCountedObjectCache() : m_index_counter(0) { }
@@ -47,8 +123,9 @@ public:
      * Retrieves a certain element.
      */
     std::shared_ptr<VALUE> at(const KEY& key) {
-        std::lock_guard<std::mutex> hold(m_mutex);
-        return m_cache.at(key).lock();
+        Shard& shard = get_shard(key);
+        std::shared_lock<std::shared_mutex> hold(shard.m_mutex);
+        return shard.m_cache.at(key).lock();
     }
 
     /**
@@ -56,73 +133,35 @@ public:
      */
     std::pair<std::shared_ptr<VALUE>, bool> insert(std::unique_ptr<VALUE>&& element) {
         KEY key = element->compute_repr();
-        /* we must declare sp before locking the mutex
-           s.t. the deleter is called after the mutex was released in case of stack unwinding. */
-        std::shared_ptr<VALUE> sp;
-        std::lock_guard<std::mutex> hold(m_mutex);
-        auto& cached = m_cache[key];
-        sp = cached.lock();
-        bool new_insertion = false;
-        if (!sp) {
-            new_insertion = true;
-            element->set_index(m_index_counter++);
-            cached = sp = std::shared_ptr<VALUE>(
-                element.get(),
-                [parent=this->shared_from_this(), original_deleter=element.get_deleter()](VALUE* x)
-                {
-                    {
-                        std::lock_guard<std::mutex> hold(parent->m_mutex);
-                        parent->m_cache.erase(x->compute_repr());
-                    }
-                    /* After cache removal, we can call the objects destructor
-                       and recursively call the deleter of children if their ref count goes to 0 */
-                    original_deleter(x);
-                }
-            );
-            element.release();
-        }
-        return std::make_pair(sp, new_insertion);
+        return get_or_create(key, [&]() { return std::move(element); }, true);
     }
 
     /**
      * Inserts a new (key, value) pair
      */
     std::pair<std::shared_ptr<VALUE>, bool> insert(KEY&& key, std::unique_ptr<VALUE>&& element) {
-        /* we must declare sp before locking the mutex
-           s.t. the deleter is called after the mutex was released in case of stack unwinding. */
-        std::shared_ptr<VALUE> sp;
-        std::lock_guard<std::mutex> hold(m_mutex);
-        auto& cached = m_cache[key];
-        sp = cached.lock();
-        bool new_insertion = false;
-        if (!sp) {
-            new_insertion = true;
-            cached = sp = std::shared_ptr<VALUE>(
-                element.get(),
-                // the key is stored in the field adding extra overhead.
-                [key, parent=this->shared_from_this(), original_deleter=element.get_deleter()](VALUE* x)
-                {
-                    {
-                        std::lock_guard<std::mutex> hold(parent->m_mutex);
-                        parent->m_cache.erase(key);
-                    }
-                    /* After cache removal, we can call the objects destructor
-                       and recursively call the deleter of children if their ref count goes to 0 */
-                    original_deleter(x);
-                }
-            );
-            element.release();
-        }
-        return std::make_pair(sp, new_insertion);
+        return get_or_create(key, [&]() { return std::move(element); }, false);
+    }
+
+    /**
+     * Retrieves the value of the key or inserts the value returned by create().
+     * In contrast to insert, duplicates are detected before the value is allocated.
+     */
+    template<typename CREATE>
+    std::pair<std::shared_ptr<VALUE>, bool> get_or_create(const KEY& key, CREATE create) {
+        return get_or_create(key, create, true);
     }
 
     size_t size() const {
-        std::lock_guard<std::mutex> hold(m_mutex);
-        return m_cache.size();
+        size_t size = 0;
+        for (const auto& shard : m_shards) {
+            std::shared_lock<std::shared_mutex> hold(shard.m_mutex);
+            size += shard.m_cache.size();
+        }
+        return size;
     }
 };
 
-
 }
 
 #endif
\ No newline at end of file
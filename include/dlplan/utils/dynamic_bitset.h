@@ -1,29 +1,194 @@
 #ifndef DLPLAN_INCLUDE_DLPLAN_UTILS_DYNAMIC_BITSET_H
 #define DLPLAN_INCLUDE_DLPLAN_UTILS_DYNAMIC_BITSET_H
 
+#include <algorithm>
 #include <cassert>
+#include <cstdint>
+#include <iterator>
 #include <limits>
-#include <vector>
+#include <type_traits>
+#include <utility>
+
+#include "bitset_kernels.h"
 
 
 /*
   Poor man's version of boost::dynamic_bitset, mostly copied from there.
+  Operations on 64-bit blocks are forwarded to word-parallel kernels
+  that are selected at runtime for the executing CPU.
+  Bitsets with at most InlineBits bits store their blocks inline.
 */
 namespace dlplan::utils {
 
-template<typename Block = unsigned int>
+/*
+  Storage for the blocks of a DynamicBitset.
+  Up to InlineBlocks blocks are stored inside of the object itself
+  such that small bitsets are created, copied and destroyed without heap allocation.
+  Inline blocks beyond size() are always zero.
+*/
+template<typename Block, std::size_t InlineBlocks>
+class BlockBuffer {
+    std::size_t m_size;
+    union {
+        Block m_inline[InlineBlocks > 0 ? InlineBlocks : 1];
+        Block* m_heap;
+    };
+
+    void release() {
+        if (!is_inline()) {
+            delete[] m_heap;
+        }
+    }
+
+    void initialize_from(const BlockBuffer& other) {
+        m_size = other.m_size;
+        if (is_inline()) {
+            std::copy(std::begin(other.m_inline), std::end(other.m_inline), m_inline);
+        } else {
+            m_heap = new Block[m_size];
+            std::copy(other.m_heap, other.m_heap + m_size, m_heap);
+        }
+    }
+
+    void steal_from(BlockBuffer& other) {
+        m_size = other.m_size;
+        if (is_inline()) {
+            std::copy(std::begin(other.m_inline), std::end(other.m_inline), m_inline);
+        } else {
+            m_heap = other.m_heap;
+            other.m_size = 0;
+            std::fill(std::begin(other.m_inline), std::end(other.m_inline), Block(0));
+        }
+    }
+
+public:
+    explicit BlockBuffer(std::size_t size) : m_size(size) {
+        if (is_inline()) {
+            std::fill(std::begin(m_inline), std::end(m_inline), Block(0));
+        } else {
+            m_heap = new Block[size]();
+        }
+    }
+
+    BlockBuffer(const BlockBuffer& other) {
+        initialize_from(other);
+    }
+
+    BlockBuffer& operator=(const BlockBuffer& other) {
+        if (this != &other) {
+            if (!is_inline() && m_size == other.m_size) {
+                // Reuse the allocation.
+                std::copy(other.m_heap, other.m_heap + m_size, m_heap);
+            } else {
+                release();
+                initialize_from(other);
+            }
+        }
+        return *this;
+    }
+
+    BlockBuffer(BlockBuffer&& other) noexcept {
+        steal_from(other);
+    }
+
+    BlockBuffer& operator=(BlockBuffer&& other) noexcept {
+        if (this != &other) {
+            release();
+            steal_from(other);
+        }
+        return *this;
+    }
+
+    ~BlockBuffer() {
+        release();
+    }
+
+    bool is_inline() const {
+        return m_size <= InlineBlocks;
+    }
+
+    std::size_t size() const {
+        return m_size;
+    }
+
+    Block* data() {
+        return is_inline() ? m_inline : m_heap;
+    }
+
+    const Block* data() const {
+        return is_inline() ? m_inline : m_heap;
+    }
+
+    Block* begin() {
+        return data();
+    }
+
+    Block* end() {
+        return data() + m_size;
+    }
+
+    Block& operator[](std::size_t idx) {
+        return data()[idx];
+    }
+
+    const Block& operator[](std::size_t idx) const {
+        return data()[idx];
+    }
+
+    Block& back() {
+        return data()[m_size - 1];
+    }
+};
+
+
+template<typename Block = std::uint64_t, std::size_t InlineBits = 256>
 class DynamicBitset {
     static_assert(
         !std::numeric_limits<Block>::is_signed,
         "Block type must be unsigned");
 
-    std::vector<Block> blocks;
+    static const int bits_per_block = std::numeric_limits<Block>::digits;
+
+    static constexpr std::size_t inline_blocks = InlineBits / bits_per_block;
+
+    static_assert(
+        (inline_blocks & (inline_blocks - 1)) == 0,
+        "Number of inline blocks must be a power of two");
+
+    BlockBuffer<Block, inline_blocks> blocks;
     std::size_t num_bits;
 
     static const Block zeros;
     static const Block ones;
 
-    static const int bits_per_block = std::numeric_limits<Block>::digits;
+    /*
+      The runtime dispatched kernels only exist for 64-bit blocks.
+      Short bitsets are processed inline because the indirect call dominates.
+    */
+    static constexpr bool has_kernels = std::is_same<Block, std::uint64_t>::value;
+
+    bool use_kernels() const {
+        return has_kernels && blocks.size() >= kernels::MIN_BLOCKS_FOR_DISPATCH;
+    }
+
+    /*
+      Calls function(std::integral_constant<std::size_t, N>()) for the smallest power of two N
+      that is at least num_blocks. Used for inline storage where the blocks up to N are zero.
+    */
+    template<std::size_t N, typename Function>
+    static decltype(auto) dispatch_fixed_size(std::size_t num_blocks, Function&& function) {
+        if constexpr (N > 1) {
+            if (num_blocks <= N / 2) {
+                return dispatch_fixed_size<N / 2>(num_blocks, std::forward<Function>(function));
+            }
+        }
+        return function(std::integral_constant<std::size_t, N>());
+    }
+
+    template<typename Function>
+    decltype(auto) with_fixed_size(Function&& function) const {
+        return dispatch_fixed_size<inline_blocks>(blocks.size(), std::forward<Function>(function));
+    }
 
     static int compute_num_blocks(std::size_t num_bits) {
         return num_bits / bits_per_block +
@@ -50,14 +215,29 @@ class DynamicBitset {
         const int bits_in_last_block = count_bits_in_last_block();
 
         if (bits_in_last_block != 0) {
-            assert(!blocks.empty());
+            assert(blocks.size() > 0);
             blocks.back() &= ~(ones << bits_in_last_block);
         }
     }
 
+    static int count_trailing_zeros(Block block) {
+        return kernels::scalar::count_trailing_zeros(block);
+    }
+
+    std::size_t find_from_block(std::size_t block_idx) const {
+        for (; block_idx < blocks.size(); ++block_idx) {
+            if (blocks[block_idx]) {
+                return block_idx * bits_per_block + count_trailing_zeros(blocks[block_idx]);
+            }
+        }
+        return npos;
+    }
+
 public:
+    static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
     explicit DynamicBitset(std::size_t num_bits)
-        : blocks(compute_num_blocks(num_bits), zeros),
+        : blocks(compute_num_blocks(num_bits)),
           num_bits(num_bits) {
     }
 
@@ -66,20 +246,51 @@ public:
     }
 
     /*
-      Count the number of set bits.
+      Whether the blocks are stored inside of the object without heap allocation.
+    */
+    bool is_inline() const {
+        return blocks.is_inline();
+    }
+
+    /*
+      Number of bytes of the blocks allocated on the heap.
+    */
+    std::size_t get_num_heap_bytes() const {
+        return is_inline() ? 0 : blocks.size() * sizeof(Block);
+    }
 
-      The computation could be made faster by using a more sophisticated
-      algorithm (see https://en.wikipedia.org/wiki/Hamming_weight).
+    /*
+      Count the number of set bits with the hardware population count.
     */
     int count() const {
+        if constexpr (has_kernels) {
+            if (use_kernels() || !kernels::HAS_INLINE_POPCOUNT) {
+                return kernels::get_kernels().count(blocks.data(), blocks.size());
+            }
+        }
+        if (is_inline()) {
+            return with_fixed_size([&](auto n) {
+                return static_cast<int>(kernels::fixed::count<decltype(n)::value>(blocks.data()));
+            });
+        }
         int result = 0;
-        for (std::size_t pos = 0; pos < num_bits; ++pos) {
-            result += static_cast<int>(test(pos));
+        for (std::size_t i = 0; i < blocks.size(); ++i) {
+            result += kernels::scalar::popcount(blocks[i]);
         }
         return result;
     }
 
     bool none() const {
+        if constexpr (has_kernels) {
+            if (use_kernels()) {
+                return kernels::get_kernels().none(blocks.data(), blocks.size());
+            }
+        }
+        if (is_inline()) {
+            return with_fixed_size([&](auto n) {
+                return kernels::fixed::none<decltype(n)::value>(blocks.data());
+            });
+        }
         for (std::size_t i = 0; i < blocks.size(); ++i) {
             if (blocks[i]) return false;
         }
@@ -114,11 +325,74 @@ public:
         return test(pos);
     }
 
+    /*
+      Bit scanning as in boost::dynamic_bitset.
+      Zero blocks are skipped and the next set bit inside of a block
+      is found with count trailing zeros.
+    */
+    std::size_t find_first() const {
+        return find_from_block(0);
+    }
+
+    std::size_t find_next(std::size_t pos) const {
+        ++pos;
+        if (pos >= num_bits) {
+            return npos;
+        }
+        const std::size_t block_idx = block_index(pos);
+        const Block remaining = blocks[block_idx] & (ones << bit_index(pos));
+        if (remaining) {
+            return block_idx * bits_per_block + count_trailing_zeros(remaining);
+        }
+        return find_from_block(block_idx + 1);
+    }
+
+    /**
+     * Calls visitor(block_index, block) for every block that contains a set bit.
+     */
+    template<typename Visitor>
+    void for_each_nonzero_block(Visitor visitor) const {
+        for (std::size_t block_idx = 0; block_idx < blocks.size(); ++block_idx) {
+            if (blocks[block_idx]) {
+                visitor(block_idx, blocks[block_idx]);
+            }
+        }
+    }
+
+    /**
+     * Calls visitor(pos) for every set bit in increasing order.
+     */
+    template<typename Visitor>
+    void for_each_set_bit(Visitor visitor) const {
+        for (std::size_t block_idx = 0; block_idx < blocks.size(); ++block_idx) {
+            Block block = blocks[block_idx];
+            const std::size_t offset = block_idx * bits_per_block;
+            while (block) {
+                visitor(offset + count_trailing_zeros(block));
+                // clear the lowest set bit
+                block &= block - 1;
+            }
+        }
+    }
+
     bool operator==(const DynamicBitset& other) const {
-        if (this != &other) {
-            return (blocks == other.blocks) && (num_bits == other.num_bits);
+        if (this == &other) {
+            return true;
         }
-        return true;
+        if (num_bits != other.num_bits) {
+            return false;
+        }
+        if constexpr (has_kernels) {
+            if (use_kernels()) {
+                return kernels::get_kernels().equal(blocks.data(), other.blocks.data(), blocks.size());
+            }
+        }
+        if (is_inline()) {
+            return with_fixed_size([&](auto n) {
+                return kernels::fixed::equal<decltype(n)::value>(blocks.data(), other.blocks.data());
+            });
+        }
+        return std::equal(blocks.data(), blocks.data() + blocks.size(), other.blocks.data());
     }
 
     bool operator!=(const DynamicBitset& other) const {
@@ -127,6 +401,18 @@ public:
 
     DynamicBitset& operator&=(const DynamicBitset& other) {
         assert(size() == other.size());
+        if constexpr (has_kernels) {
+            if (use_kernels()) {
+                kernels::get_kernels().bitwise_and(blocks.data(), other.blocks.data(), blocks.size());
+                return *this;
+            }
+        }
+        if (is_inline()) {
+            with_fixed_size([&](auto n) {
+                kernels::fixed::bitwise_and<decltype(n)::value>(blocks.data(), other.blocks.data());
+            });
+            return *this;
+        }
         for (std::size_t i = 0; i < blocks.size(); ++i) {
             blocks[i] &= other.blocks[i];
         }
@@ -135,6 +421,18 @@ public:
 
     DynamicBitset& operator|=(const DynamicBitset& other) {
         assert(size() == other.size());
+        if constexpr (has_kernels) {
+            if (use_kernels()) {
+                kernels::get_kernels().bitwise_or(blocks.data(), other.blocks.data(), blocks.size());
+                return *this;
+            }
+        }
+        if (is_inline()) {
+            with_fixed_size([&](auto n) {
+                kernels::fixed::bitwise_or<decltype(n)::value>(blocks.data(), other.blocks.data());
+            });
+            return *this;
+        }
         for (std::size_t i = 0; i < blocks.size(); ++i) {
             blocks[i] |= other.blocks[i];
         }
@@ -143,6 +441,18 @@ public:
 
     DynamicBitset& operator-=(const DynamicBitset& other) {
         assert(size() == other.size());
+        if constexpr (has_kernels) {
+            if (use_kernels()) {
+                kernels::get_kernels().bitwise_andnot(blocks.data(), other.blocks.data(), blocks.size());
+                return *this;
+            }
+        }
+        if (is_inline()) {
+            with_fixed_size([&](auto n) {
+                kernels::fixed::bitwise_andnot<decltype(n)::value>(blocks.data(), other.blocks.data());
+            });
+            return *this;
+        }
         for (std::size_t i = 0; i < blocks.size(); ++i) {
             blocks[i] = blocks[i] & ~other.blocks[i];
         }
@@ -150,6 +460,15 @@ public:
     }
 
     DynamicBitset& operator~() {
+        // Inline blocks beyond the used size must remain zero,
+        // so the complement is never computed with the fixed-size kernels.
+        if constexpr (has_kernels) {
+            if (use_kernels()) {
+                kernels::get_kernels().bitwise_not(blocks.data(), blocks.size());
+                zero_unused_bits();
+                return *this;
+            }
+        }
         for (std::size_t i = 0; i < blocks.size(); ++i) {
             blocks[i] = ~blocks[i];
         }
@@ -159,6 +478,16 @@ public:
 
     bool intersects(const DynamicBitset &other) const {
         assert(size() == other.size());
+        if constexpr (has_kernels) {
+            if (use_kernels()) {
+                return kernels::get_kernels().intersects(blocks.data(), other.blocks.data(), blocks.size());
+            }
+        }
+        if (is_inline()) {
+            return with_fixed_size([&](auto n) {
+                return kernels::fixed::intersects<decltype(n)::value>(blocks.data(), other.blocks.data());
+            });
+        }
         for (std::size_t i = 0; i < blocks.size(); ++i) {
             if (blocks[i] & other.blocks[i])
                 return true;
@@ -168,6 +497,16 @@ public:
 
     bool is_subset_of(const DynamicBitset &other) const {
         assert(size() == other.size());
+        if constexpr (has_kernels) {
+            if (use_kernels()) {
+                return kernels::get_kernels().is_subset_of(blocks.data(), other.blocks.data(), blocks.size());
+            }
+        }
+        if (is_inline()) {
+            return with_fixed_size([&](auto n) {
+                return kernels::fixed::is_subset_of<decltype(n)::value>(blocks.data(), other.blocks.data());
+            });
+        }
         for (std::size_t i = 0; i < blocks.size(); ++i) {
             if (blocks[i] & ~other.blocks[i])
                 return false;
@@ -175,19 +514,71 @@ public:
         return true;
     }
 
+    /*
+      Access to bit ranges that do not start at a block boundary,
+      e.g., the rows of a role denotation with n*n bits.
+      A block is assembled from two neighbouring blocks with shifts.
+    */
+    Block extract_bits(std::size_t pos, std::size_t len) const {
+        assert(len <= static_cast<std::size_t>(bits_per_block) && pos + len <= num_bits);
+        if (len == 0) {
+            return zeros;
+        }
+        const std::size_t block_idx = block_index(pos);
+        const std::size_t shift = bit_index(pos);
+        Block result = static_cast<Block>(blocks[block_idx] >> shift);
+        if (shift != 0 && shift + len > static_cast<std::size_t>(bits_per_block)) {
+            result |= static_cast<Block>(blocks[block_idx + 1] << (bits_per_block - shift));
+        }
+        if (len < static_cast<std::size_t>(bits_per_block)) {
+            result &= static_cast<Block>(~(ones << len));
+        }
+        return result;
+    }
+
+    void or_bits(std::size_t pos, Block bits, std::size_t len) {
+        assert(len <= static_cast<std::size_t>(bits_per_block) && pos + len <= num_bits);
+        assert(len == static_cast<std::size_t>(bits_per_block) || !(bits & (ones << len)));
+        const std::size_t block_idx = block_index(pos);
+        const std::size_t shift = bit_index(pos);
+        blocks[block_idx] |= static_cast<Block>(bits << shift);
+        if (shift != 0 && shift + len > static_cast<std::size_t>(bits_per_block)) {
+            blocks[block_idx + 1] |= static_cast<Block>(bits >> (bits_per_block - shift));
+        }
+    }
+
+    /**
+     * Sets the bits [pos, pos+len) to the union with the bits [other_pos, other_pos+len) of other.
+     */
+    template<std::size_t OtherInlineBits>
+    void or_range(std::size_t pos, const DynamicBitset<Block, OtherInlineBits>& other, std::size_t other_pos, std::size_t len) {
+        assert(pos + len <= num_bits && other_pos + len <= other.size());
+        for (std::size_t offset = 0; offset < len; offset += bits_per_block) {
+            const std::size_t chunk = std::min<std::size_t>(bits_per_block, len - offset);
+            const Block bits = other.extract_bits(other_pos + offset, chunk);
+            if (bits) {
+                or_bits(pos + offset, bits, chunk);
+            }
+        }
+    }
+
     /**
      * Useful for copying the underlying data when computing a hash for a collection of bitsets.
      */
-    const std::vector<Block>& get_blocks() const {
-        return blocks;
+    const Block* data() const {
+        return blocks.data();
+    }
+
+    std::size_t num_blocks() const {
+        return blocks.size();
     }
 };
 
-template<typename Block>
-const Block DynamicBitset<Block>::zeros = Block(0);
+template<typename Block, std::size_t InlineBits>
+const Block DynamicBitset<Block, InlineBits>::zeros = Block(0);
 
-template<typename Block>
-const Block DynamicBitset<Block>::ones = ~DynamicBitset<Block>::zeros;
+template<typename Block, std::size_t InlineBits>
+const Block DynamicBitset<Block, InlineBits>::ones = ~DynamicBitset<Block, InlineBits>::zeros;
 }
 
 /*
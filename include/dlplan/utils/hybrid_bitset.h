@@ -0,0 +1,418 @@
+#ifndef DLPLAN_INCLUDE_DLPLAN_UTILS_HYBRID_BITSET_H_
+#define DLPLAN_INCLUDE_DLPLAN_UTILS_HYBRID_BITSET_H_
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "dynamic_bitset.h"
+#include "hashing.h"
+
+
+namespace dlplan::utils {
+
+/**
+ * A set of integers in [0, size()) that is either stored as a dense bitset
+ * or as a sorted vector of positions, similar to the containers of roaring bitmaps.
+ *
+ * The representation is chosen per instance from the universe size and the density.
+ * Small universes are always dense because a few blocks are cheaper than any alternative.
+ * Large universes start sparse, become dense when the density exceeds 1/32
+ * (the break-even point of 32-bit positions) and return to sparse
+ * when an operation leaves the density below 1/64.
+ * The gap between both thresholds prevents alternating conversions.
+ *
+ * Equality and hashing do not depend on the representation.
+ * Dense sets with at most InlineBits bits are stored without heap allocation.
+ */
+template<std::size_t InlineBits = 256>
+class HybridBitset {
+public:
+    using Block = std::uint64_t;
+    using Position = std::uint32_t;
+    using Dense = DynamicBitset<Block, InlineBits>;
+
+    static constexpr std::size_t npos = Dense::npos;
+
+    /**
+     * Universes with fewer bits are always stored densely.
+     */
+    static constexpr std::size_t MIN_SPARSE_BITS = 4096;
+
+private:
+    static constexpr int bits_per_block = 64;
+
+    std::size_t m_num_bits;
+    bool m_is_dense;
+    Dense m_dense;
+    std::vector<Position> m_sparse;
+
+    bool allows_sparse() const {
+        return m_num_bits >= MIN_SPARSE_BITS;
+    }
+
+    bool exceeds_sparse_capacity(std::size_t cardinality) const {
+        return cardinality * 32 > m_num_bits;
+    }
+
+    bool fits_sparse(std::size_t cardinality) const {
+        return allows_sparse() && cardinality * 64 <= m_num_bits;
+    }
+
+    void make_dense() {
+        if (m_is_dense) return;
+        m_dense = to_dynamic_bitset();
+        std::vector<Position>().swap(m_sparse);
+        m_is_dense = true;
+    }
+
+    void make_sparse(std::size_t cardinality) {
+        if (!m_is_dense) return;
+        m_sparse.clear();
+        m_sparse.reserve(cardinality);
+        m_dense.for_each_set_bit([&](std::size_t pos) { m_sparse.push_back(static_cast<Position>(pos)); });
+        m_dense = Dense(0);
+        m_is_dense = false;
+    }
+
+    template<typename Predicate>
+    void filter_sparse(Predicate keep) {
+        m_sparse.erase(std::remove_if(m_sparse.begin(), m_sparse.end(), [&](Position pos) { return !keep(pos); }), m_sparse.end());
+    }
+
+public:
+    explicit HybridBitset(std::size_t num_bits)
+        : m_num_bits(num_bits),
+          m_is_dense(num_bits < MIN_SPARSE_BITS),
+          m_dense(m_is_dense ? num_bits : 0) { }
+
+    std::size_t size() const {
+        return m_num_bits;
+    }
+
+    /**
+     * Chooses the representation that fits the current density.
+     * Called after operations that can shrink the set.
+     */
+    void normalize() {
+        if (m_is_dense && allows_sparse()) {
+            std::size_t cardinality = m_dense.count();
+            if (fits_sparse(cardinality)) make_sparse(cardinality);
+        } else if (!m_is_dense && exceeds_sparse_capacity(m_sparse.size())) {
+            make_dense();
+        }
+    }
+
+    /**
+     * Replaces the content by the given strictly increasing positions.
+     */
+    void assign_sorted(std::vector<Position> positions) {
+        assert(std::adjacent_find(positions.begin(), positions.end(), std::greater_equal<Position>()) == positions.end());
+        m_dense = Dense(0);
+        m_sparse = std::move(positions);
+        m_is_dense = false;
+        if (!allows_sparse() || exceeds_sparse_capacity(m_sparse.size())) make_dense();
+    }
+
+    bool is_dense() const {
+        return m_is_dense;
+    }
+
+    /**
+     * Number of bytes allocated on the heap by either representation.
+     */
+    std::size_t get_num_heap_bytes() const {
+        return m_dense.get_num_heap_bytes() + m_sparse.capacity() * sizeof(Position);
+    }
+
+    int count() const {
+        return m_is_dense ? m_dense.count() : static_cast<int>(m_sparse.size());
+    }
+
+    bool none() const {
+        return m_is_dense ? m_dense.none() : m_sparse.empty();
+    }
+
+    void set() {
+        make_dense();
+        m_dense.set();
+    }
+
+    void reset() {
+        if (allows_sparse()) {
+            m_dense = Dense(0);
+            m_sparse.clear();
+            m_is_dense = false;
+        } else {
+            m_dense.reset();
+        }
+    }
+
+    void set(std::size_t pos) {
+        assert(pos < m_num_bits);
+        if (m_is_dense) {
+            m_dense.set(pos);
+            return;
+        }
+        // Positions that are set in increasing order are appended.
+        if (m_sparse.empty() || pos > m_sparse.back()) {
+            m_sparse.push_back(static_cast<Position>(pos));
+            if (exceeds_sparse_capacity(m_sparse.size())) make_dense();
+            return;
+        }
+        auto it = std::lower_bound(m_sparse.begin(), m_sparse.end(), static_cast<Position>(pos));
+        if (*it != pos) {
+            m_sparse.insert(it, static_cast<Position>(pos));
+            if (exceeds_sparse_capacity(m_sparse.size())) make_dense();
+        }
+    }
+
+    /**
+     * Sets a position without keeping the sparse representation sorted.
+     * Positions can be set in any order and more than once.
+     * Call sort_unordered() afterwards before any other operation.
+     */
+    void set_unordered(std::size_t pos) {
+        assert(pos < m_num_bits);
+        if (m_is_dense) {
+            m_dense.set(pos);
+            return;
+        }
+        m_sparse.push_back(static_cast<Position>(pos));
+        if (exceeds_sparse_capacity(m_sparse.size())) make_dense();
+    }
+
+    /**
+     * Restores the sorted sparse representation after set_unordered().
+     */
+    void sort_unordered() {
+        if (m_is_dense) return;
+        std::sort(m_sparse.begin(), m_sparse.end());
+        m_sparse.erase(std::unique(m_sparse.begin(), m_sparse.end()), m_sparse.end());
+    }
+
+    void reset(std::size_t pos) {
+        assert(pos < m_num_bits);
+        if (m_is_dense) {
+            m_dense.reset(pos);
+            return;
+        }
+        auto it = std::lower_bound(m_sparse.begin(), m_sparse.end(), static_cast<Position>(pos));
+        if (it != m_sparse.end() && *it == pos) m_sparse.erase(it);
+    }
+
+    bool test(std::size_t pos) const {
+        assert(pos < m_num_bits);
+        if (m_is_dense) return m_dense.test(pos);
+        return std::binary_search(m_sparse.begin(), m_sparse.end(), static_cast<Position>(pos));
+    }
+
+    bool operator[](std::size_t pos) const {
+        return test(pos);
+    }
+
+    bool operator==(const HybridBitset& other) const {
+        if (this == &other) return true;
+        if (m_num_bits != other.m_num_bits) return false;
+        if (m_is_dense && other.m_is_dense) return m_dense == other.m_dense;
+        if (!m_is_dense && !other.m_is_dense) return m_sparse == other.m_sparse;
+        const HybridBitset& sparse = m_is_dense ? other : *this;
+        const HybridBitset& dense = m_is_dense ? *this : other;
+        return dense.count() == sparse.count() && sparse.is_subset_of(dense);
+    }
+
+    bool operator!=(const HybridBitset& other) const {
+        return !(*this == other);
+    }
+
+    HybridBitset& operator&=(const HybridBitset& other) {
+        assert(size() == other.size());
+        if (m_is_dense && other.m_is_dense) {
+            m_dense &= other.m_dense;
+            normalize();
+        } else if (!m_is_dense && !other.m_is_dense) {
+            std::vector<Position> result;
+            std::set_intersection(m_sparse.begin(), m_sparse.end(), other.m_sparse.begin(), other.m_sparse.end(), std::back_inserter(result));
+            m_sparse = std::move(result);
+        } else if (!m_is_dense) {
+            filter_sparse([&](Position pos) { return other.m_dense.test(pos); });
+        } else {
+            // The result is a subset of the sparse operand.
+            std::vector<Position> result;
+            for (Position pos : other.m_sparse) {
+                if (m_dense.test(pos)) result.push_back(pos);
+            }
+            m_dense = Dense(0);
+            m_sparse = std::move(result);
+            m_is_dense = false;
+        }
+        return *this;
+    }
+
+    HybridBitset& operator|=(const HybridBitset& other) {
+        assert(size() == other.size());
+        if (!m_is_dense && !other.m_is_dense) {
+            std::vector<Position> result;
+            result.reserve(m_sparse.size() + other.m_sparse.size());
+            std::set_union(m_sparse.begin(), m_sparse.end(), other.m_sparse.begin(), other.m_sparse.end(), std::back_inserter(result));
+            m_sparse = std::move(result);
+            if (exceeds_sparse_capacity(m_sparse.size())) make_dense();
+            return *this;
+        }
+        make_dense();
+        if (other.m_is_dense) {
+            m_dense |= other.m_dense;
+        } else {
+            for (Position pos : other.m_sparse) m_dense.set(pos);
+        }
+        return *this;
+    }
+
+    HybridBitset& operator-=(const HybridBitset& other) {
+        assert(size() == other.size());
+        if (m_is_dense && other.m_is_dense) {
+            m_dense -= other.m_dense;
+            normalize();
+        } else if (!m_is_dense && !other.m_is_dense) {
+            std::vector<Position> result;
+            std::set_difference(m_sparse.begin(), m_sparse.end(), other.m_sparse.begin(), other.m_sparse.end(), std::back_inserter(result));
+            m_sparse = std::move(result);
+        } else if (!m_is_dense) {
+            filter_sparse([&](Position pos) { return !other.m_dense.test(pos); });
+        } else {
+            for (Position pos : other.m_sparse) m_dense.reset(pos);
+        }
+        return *this;
+    }
+
+    HybridBitset& operator~() {
+        make_dense();
+        ~m_dense;
+        normalize();
+        return *this;
+    }
+
+    bool intersects(const HybridBitset& other) const {
+        assert(size() == other.size());
+        if (m_is_dense && other.m_is_dense) return m_dense.intersects(other.m_dense);
+        if (!m_is_dense && !other.m_is_dense) {
+            auto it_left = m_sparse.begin();
+            auto it_right = other.m_sparse.begin();
+            while (it_left != m_sparse.end() && it_right != other.m_sparse.end()) {
+                if (*it_left < *it_right) ++it_left;
+                else if (*it_right < *it_left) ++it_right;
+                else return true;
+            }
+            return false;
+        }
+        const HybridBitset& sparse = m_is_dense ? other : *this;
+        const HybridBitset& dense = m_is_dense ? *this : other;
+        return std::any_of(sparse.m_sparse.begin(), sparse.m_sparse.end(), [&](Position pos) { return dense.m_dense.test(pos); });
+    }
+
+    bool is_subset_of(const HybridBitset& other) const {
+        assert(size() == other.size());
+        if (m_is_dense && other.m_is_dense) return m_dense.is_subset_of(other.m_dense);
+        if (!m_is_dense && !other.m_is_dense) return std::includes(other.m_sparse.begin(), other.m_sparse.end(), m_sparse.begin(), m_sparse.end());
+        if (!m_is_dense) return std::all_of(m_sparse.begin(), m_sparse.end(), [&](Position pos) { return other.m_dense.test(pos); });
+        if (count() > other.count()) return false;
+        bool result = true;
+        m_dense.for_each_set_bit([&](std::size_t pos) { result = result && other.test(pos); });
+        return result;
+    }
+
+    std::size_t find_first() const {
+        if (m_is_dense) return m_dense.find_first();
+        return m_sparse.empty() ? npos : m_sparse.front();
+    }
+
+    std::size_t find_next(std::size_t pos) const {
+        if (m_is_dense) return m_dense.find_next(pos);
+        if (pos + 1 >= m_num_bits) return npos;
+        auto it = std::lower_bound(m_sparse.begin(), m_sparse.end(), static_cast<Position>(pos + 1));
+        return (it == m_sparse.end()) ? npos : *it;
+    }
+
+    /**
+     * Calls visitor(block_index, block) for every 64-bit block that contains a set bit.
+     * In the sparse representation the blocks are assembled on the fly.
+     */
+    template<typename Visitor>
+    void for_each_nonzero_block(Visitor visitor) const {
+        if (m_is_dense) {
+            m_dense.for_each_nonzero_block(visitor);
+            return;
+        }
+        auto it = m_sparse.begin();
+        while (it != m_sparse.end()) {
+            const std::size_t block_idx = *it / bits_per_block;
+            Block block = 0;
+            for (; it != m_sparse.end() && *it / bits_per_block == block_idx; ++it) {
+                block |= Block(1) << (*it % bits_per_block);
+            }
+            visitor(block_idx, block);
+        }
+    }
+
+    /**
+     * Calls visitor(pos) for every set bit in increasing order.
+     */
+    template<typename Visitor>
+    void for_each_set_bit(Visitor visitor) const {
+        if (m_is_dense) {
+            m_dense.for_each_set_bit(visitor);
+            return;
+        }
+        for (Position pos : m_sparse) visitor(static_cast<std::size_t>(pos));
+    }
+
+    std::size_t compute_hash() const {
+        std::size_t seed = m_num_bits;
+        for_each_nonzero_block([&](std::size_t block_idx, Block block) {
+            hash_combine(seed, block_idx);
+            hash_combine(seed, block);
+        });
+        return seed;
+    }
+
+    /**
+     * A dense copy regardless of the current representation.
+     */
+    Dense to_dynamic_bitset() const {
+        if (m_is_dense) return m_dense;
+        Dense result(m_num_bits);
+        for (Position pos : m_sparse) result.set(pos);
+        return result;
+    }
+
+    /**
+     * Switches to the dense representation and returns it for direct modification,
+     * e.g., by blockwise kernels. Call normalize() afterwards.
+     */
+    Dense& to_dense() {
+        make_dense();
+        return m_dense;
+    }
+
+    /**
+     * The dense bitset. Only valid if is_dense() holds.
+     */
+    const Dense& get_dense_ref() const {
+        assert(m_is_dense);
+        return m_dense;
+    }
+
+    /**
+     * The sorted positions. Only valid if is_dense() does not hold.
+     */
+    const std::vector<Position>& get_sparse_ref() const {
+        assert(!m_is_dense);
+        return m_sparse;
+    }
+};
+
+}
+
+#endif
@@ -0,0 +1,273 @@
+#ifndef DLPLAN_INCLUDE_DLPLAN_UTILS_INTERNING_POOL_H_
+#define DLPLAN_INCLUDE_DLPLAN_UTILS_INTERNING_POOL_H_
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "../phmap/phmap.h"
+
+
+namespace dlplan::utils {
+
+/**
+ * Number of bytes that a value owns outside of its own object.
+ * Specialize for types that allocate such that pools can report their memory usage.
+ */
+template<typename T>
+struct HeapBytes {
+    std::size_t operator()(const T&) const noexcept {
+        return 0;
+    }
+};
+
+template<typename T, typename Allocator>
+struct HeapBytes<std::vector<T, Allocator>> {
+    std::size_t operator()(const std::vector<T, Allocator>& value) const noexcept {
+        return value.capacity() * sizeof(T);
+    }
+};
+
+template<typename Allocator>
+struct HeapBytes<std::vector<bool, Allocator>> {
+    std::size_t operator()(const std::vector<bool, Allocator>& value) const noexcept {
+        return value.capacity() / 8;
+    }
+};
+
+/**
+ * Stores unique objects of type T contiguously in slabs.
+ * Duplicates are detected with an open-addressing hash table
+ * that stores 32-bit indices into the slabs instead of pointers.
+ * Inserted objects never move and all slabs are released at once
+ * when the pool is destroyed.
+ */
+template<typename T, typename Hash = std::hash<T>, typename Equal = std::equal_to<T>>
+class InterningPool {
+private:
+    static constexpr std::size_t MAX_SLAB_BYTES = 1 << 14;
+
+    static constexpr std::uint32_t compute_max_slab_capacity() {
+        std::uint32_t capacity = 1;
+        while (2 * capacity * sizeof(T) <= MAX_SLAB_BYTES) capacity *= 2;
+        return capacity;
+    }
+
+    /**
+     * Slab k holds 2^k objects until the slab capacity reaches MAX_SLAB_CAPACITY
+     * such that small pools do not allocate a full slab.
+     */
+    static constexpr std::uint32_t MAX_SLAB_CAPACITY = compute_max_slab_capacity();
+    static constexpr std::uint32_t NUM_GROWING_SLOTS = 2 * MAX_SLAB_CAPACITY - 1;
+
+    struct alignas(T) Slot {
+        unsigned char bytes[sizeof(T)];
+    };
+
+    /**
+     * The slabs are owned through a pointer
+     * such that the hash table functors remain valid
+     * when the pool is moved.
+     */
+    struct Storage {
+        std::vector<std::unique_ptr<Slot[]>> slabs;
+        std::uint32_t size = 0;
+        // Bytes of the slabs and of the heap memory owned by the values.
+        std::size_t num_bytes = 0;
+
+        static std::pair<std::uint32_t, std::uint32_t> compute_slab_and_offset(std::uint32_t index) {
+            if (index < NUM_GROWING_SLOTS) {
+                std::uint32_t slab = 31 - __builtin_clz(index + 1);
+                return std::make_pair(slab, index + 1 - (1u << slab));
+            }
+            std::uint32_t remaining = index - NUM_GROWING_SLOTS;
+            return std::make_pair(
+                (31 - __builtin_clz(MAX_SLAB_CAPACITY)) + 1 + remaining / MAX_SLAB_CAPACITY,
+                remaining % MAX_SLAB_CAPACITY);
+        }
+
+        static std::uint32_t compute_slab_capacity(std::uint32_t slab) {
+            return std::min(std::uint32_t(1) << std::min<std::uint32_t>(slab, 31), MAX_SLAB_CAPACITY);
+        }
+
+        Slot* get_slot(std::uint32_t index) {
+            auto [slab, offset] = compute_slab_and_offset(index);
+            return &slabs[slab][offset];
+        }
+
+        T& at(std::uint32_t index) {
+            return *std::launder(reinterpret_cast<T*>(get_slot(index)));
+        }
+    };
+
+    struct IndexHash {
+        Storage* storage = nullptr;
+
+        std::size_t operator()(std::uint32_t index) const {
+            return Hash()(storage->at(index));
+        }
+    };
+
+    struct IndexEqual {
+        Storage* storage = nullptr;
+
+        bool operator()(std::uint32_t left, std::uint32_t right) const {
+            return Equal()(storage->at(left), storage->at(right));
+        }
+    };
+
+    std::unique_ptr<Storage> m_storage;
+    phmap::flat_hash_set<std::uint32_t, IndexHash, IndexEqual> m_indices;
+
+    void destroy() {
+        if (!m_storage) return;
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            for (std::uint32_t index = 0; index < m_storage->size; ++index) {
+                m_storage->at(index).~T();
+            }
+        }
+    }
+
+public:
+    InterningPool()
+        : m_storage(std::make_unique<Storage>()),
+          m_indices(0, IndexHash{m_storage.get()}, IndexEqual{m_storage.get()}) { }
+    InterningPool(const InterningPool& other) = delete;
+    InterningPool& operator=(const InterningPool& other) = delete;
+    InterningPool(InterningPool&& other) = default;
+    InterningPool& operator=(InterningPool&& other) {
+        if (this != &other) {
+            destroy();
+            m_storage = std::move(other.m_storage);
+            m_indices = std::move(other.m_indices);
+        }
+        return *this;
+    }
+    ~InterningPool() {
+        destroy();
+    }
+
+    /**
+     * Moves the value into the pool unless an equal value is stored already.
+     * Returns a pointer to the stored value and whether it was newly inserted.
+     */
+    std::pair<T*, bool> insert(T&& value) {
+        const std::size_t hash = Hash()(value);
+        return insert(std::move(value), hash);
+    }
+
+    /**
+     * Same as above for a value whose hash was already computed.
+     */
+    std::pair<T*, bool> insert(T&& value, std::size_t hash) {
+        Storage& storage = *m_storage;
+        if (storage.size == std::numeric_limits<std::uint32_t>::max()) {
+            throw std::runtime_error("InterningPool::insert - maximum number of values exceeded.");
+        }
+        const std::uint32_t index = storage.size;
+        const std::uint32_t slab = Storage::compute_slab_and_offset(index).first;
+        if (slab == storage.slabs.size()) {
+            storage.slabs.emplace_back(new Slot[Storage::compute_slab_capacity(slab)]);
+            storage.num_bytes += Storage::compute_slab_capacity(slab) * sizeof(Slot);
+        }
+        // Construct the candidate in the next free slot such that the table can compare it from there.
+        T* candidate = new (storage.get_slot(index)) T(std::move(value));
+        std::pair<typename decltype(m_indices)::iterator, bool> result;
+        try {
+            result = m_indices.emplace_with_hash(phmap::phmap_mix<sizeof(std::size_t)>()(hash), index);
+        } catch (...) {
+            candidate->~T();
+            throw;
+        }
+        if (!result.second) {
+            candidate->~T();
+            return std::make_pair(&storage.at(*result.first), false);
+        }
+        ++storage.size;
+        storage.num_bytes += HeapBytes<T>()(*candidate);
+        return std::make_pair(candidate, true);
+    }
+
+    std::size_t size() const {
+        return m_storage ? m_storage->size : 0;
+    }
+
+    /**
+     * Returns the number of bytes used by the slabs, the values, and the hash table.
+     */
+    std::size_t get_num_bytes() const {
+        if (!m_storage) return 0;
+        // The table stores one control byte per slot.
+        return m_storage->num_bytes + m_indices.capacity() * (sizeof(std::uint32_t) + 1);
+    }
+};
+
+/**
+ * An InterningPool that can be shared between threads.
+ * Values are distributed by hash over NUM_SHARDS pools with one mutex each
+ * such that threads rarely wait on each other.
+ */
+template<typename T, typename Hash = std::hash<T>, typename Equal = std::equal_to<T>, std::size_t NUM_SHARDS = 32>
+class ShardedInterningPool {
+private:
+    static_assert((NUM_SHARDS & (NUM_SHARDS - 1)) == 0, "NUM_SHARDS must be a power of two.");
+
+    struct alignas(64) Shard {
+        mutable std::mutex mutex;
+        InterningPool<T, Hash, Equal> pool;
+    };
+
+    std::array<Shard, NUM_SHARDS> m_shards;
+    std::atomic<std::size_t> m_num_bytes;
+
+public:
+    ShardedInterningPool() : m_num_bytes(0) { }
+
+    /**
+     * Moves the value into the pool unless an equal value is stored already.
+     * Returns a pointer to the stored value and whether it was newly inserted.
+     */
+    std::pair<T*, bool> insert(T&& value) {
+        const std::size_t hash = Hash()(value);
+        // The shard is chosen from high bits because the tables probe with the low bits.
+        Shard& shard = m_shards[(phmap::phmap_mix<sizeof(std::size_t)>()(hash) >> (sizeof(std::size_t) * 4)) & (NUM_SHARDS - 1)];
+        std::lock_guard<std::mutex> hold(shard.mutex);
+        const std::size_t num_bytes = shard.pool.get_num_bytes();
+        auto result = shard.pool.insert(std::move(value), hash);
+        if (result.second) {
+            m_num_bytes.fetch_add(shard.pool.get_num_bytes() - num_bytes, std::memory_order_relaxed);
+        }
+        return result;
+    }
+
+    std::size_t size() const {
+        std::size_t result = 0;
+        for (const auto& shard : m_shards) {
+            std::lock_guard<std::mutex> hold(shard.mutex);
+            result += shard.pool.size();
+        }
+        return result;
+    }
+
+    /**
+     * Returns the number of bytes used by all shards without locking them.
+     */
+    std::size_t get_num_bytes() const {
+        return m_num_bytes.load(std::memory_order_relaxed);
+    }
+};
+
+}
+
+#endif
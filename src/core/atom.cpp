@@ -10,14 +10,8 @@ using namespace std::string_literals;
 
 namespace dlplan::core {
 
-Atom::Atom(
-    const std::string& name,
-    int index,
-    const Predicate& predicate,
-    const std::vector<Object> &objects,
-    bool is_static)
-    : m_name(name), m_index(index),
-      m_predicate(predicate), m_objects(objects), m_is_static(is_static) {
+Atom::Atom(std::shared_ptr<const AtomTable> atom_table, int index, bool is_static)
+    : m_atom_table(std::move(atom_table)), m_index(index), m_is_static(is_static) {
 }
 
 Atom::Atom(const Atom& other) = default;
@@ -40,7 +34,7 @@ bool Atom::operator!=(const Atom& other) const {
 }
 
 const std::string& Atom::get_name_ref() const {
-    return m_name;
+    return m_atom_table->get_name_ref(m_index);
 }
 
 int Atom::get_index() const {
@@ -48,23 +42,36 @@ int Atom::get_index() const {
 }
 
 const Predicate& Atom::get_predicate_ref() const {
-    return m_predicate;
+    return m_atom_table->m_vocabulary_info->get_predicate_ref(m_atom_table->get_predicate_idx(m_index));
 }
 
-const std::vector<Object>& Atom::get_objects_ref() const {
-    return m_objects;
+std::vector<Object> Atom::get_objects() const {
+    const auto& atom_table = *m_atom_table;
+    const int* object_idxs = atom_table.get_object_idxs(m_index);
+    const auto& objects = *atom_table.m_objects;
+    std::vector<Object> result;
+    result.reserve(atom_table.get_arity(m_index));
+    for (int pos = 0; pos < atom_table.get_arity(m_index); ++pos) {
+        result.push_back(objects[object_idxs[pos]]);
+    }
+    return result;
+}
+
+std::vector<Object> Atom::get_objects_ref() const {
+    return get_objects();
 }
 
 const Object& Atom::get_object_ref(int pos) const {
-    assert(utils::in_bounds(pos, m_objects));
-    if (!utils::in_bounds(pos, m_objects)) {
+    const auto& atom_table = *m_atom_table;
+    assert(pos >= 0 && pos < atom_table.get_arity(m_index));
+    if (pos < 0 || pos >= atom_table.get_arity(m_index)) {
         throw std::runtime_error("Out of bounds (" + get_name_ref() + ")");
     }
-    return m_objects[pos];
+    return (*atom_table.m_objects)[atom_table.get_object_idxs(m_index)[pos]];
 }
 
 bool Atom::get_is_static() const {
     return m_is_static;
 }
 
-}
\ No newline at end of file
+}
@@ -0,0 +1,69 @@
+#include "atom_index.h"
+
+#include <algorithm>
+
+
+namespace dlplan::core {
+
+AtomIndex::AtomIndex(const InstanceInfo& instance_info, const Index_Vec& atom_idxs) {
+    const auto& atom_table = instance_info.get_atom_table_ref();
+    int num_predicates = 0;
+    for (int atom_idx : atom_idxs) {
+        num_predicates = std::max(num_predicates, atom_table.get_predicate_idx(atom_idx) + 1);
+    }
+    // Counting sort of the atoms by predicate.
+    m_atom_offsets.assign(num_predicates + 1, 0);
+    m_object_offsets.assign(num_predicates + 1, 0);
+    for (int atom_idx : atom_idxs) {
+        int predicate_idx = atom_table.get_predicate_idx(atom_idx);
+        ++m_atom_offsets[predicate_idx + 1];
+        m_object_offsets[predicate_idx + 1] += atom_table.get_arity(atom_idx);
+    }
+    for (int predicate_idx = 0; predicate_idx < num_predicates; ++predicate_idx) {
+        m_atom_offsets[predicate_idx + 1] += m_atom_offsets[predicate_idx];
+        m_object_offsets[predicate_idx + 1] += m_object_offsets[predicate_idx];
+    }
+    m_object_idxs.resize(m_object_offsets.back());
+    std::vector<int> positions(m_object_offsets.begin(), m_object_offsets.end() - 1);
+    for (int atom_idx : atom_idxs) {
+        int& position = positions[atom_table.get_predicate_idx(atom_idx)];
+        const int* object_idxs = atom_table.get_object_idxs(atom_idx);
+        for (int pos = 0; pos < atom_table.get_arity(atom_idx); ++pos) {
+            m_object_idxs[position++] = object_idxs[pos];
+        }
+    }
+}
+
+
+StaticAtomMasks::StaticAtomMasks(const InstanceInfo& instance_info) {
+    const int num_objects = instance_info.get_num_objects();
+    const auto& static_atom_table = instance_info.get_static_atom_table_ref();
+    for (const auto& [predicate_idx, atom_idxs] : instance_info.get_per_predicate_idx_static_atom_idxs_ref()) {
+        const int arity = instance_info.get_vocabulary_info_ref().get_predicate_ref(predicate_idx).get_arity();
+        auto& concept_masks = m_concept_masks.emplace(predicate_idx, std::vector<ConceptDenotation>(arity, ConceptDenotation(num_objects))).first->second;
+        auto& role_masks = m_role_masks.emplace(predicate_idx, std::vector<RoleDenotation>(arity * arity, RoleDenotation(num_objects))).first->second;
+        for (int atom_idx : atom_idxs) {
+            const int* object_idxs = static_atom_table.get_object_idxs(atom_idx);
+            for (int pos_1 = 0; pos_1 < arity; ++pos_1) {
+                concept_masks[pos_1].insert(object_idxs[pos_1]);
+                for (int pos_2 = 0; pos_2 < arity; ++pos_2) {
+                    role_masks[pos_1 * arity + pos_2].insert(std::make_pair(object_idxs[pos_1], object_idxs[pos_2]));
+                }
+            }
+        }
+    }
+}
+
+const ConceptDenotation* StaticAtomMasks::get_concept_mask(const Predicate& predicate, int pos) const {
+    auto it = m_concept_masks.find(predicate.get_index());
+    if (it == m_concept_masks.end()) return nullptr;
+    return &it->second[pos];
+}
+
+const RoleDenotation* StaticAtomMasks::get_role_mask(const Predicate& predicate, int pos_1, int pos_2) const {
+    auto it = m_role_masks.find(predicate.get_index());
+    if (it == m_role_masks.end()) return nullptr;
+    return &it->second[pos_1 * predicate.get_arity() + pos_2];
+}
+
+}
@@ -0,0 +1,72 @@
+#ifndef DLPLAN_SRC_CORE_ATOM_INDEX_H_
+#define DLPLAN_SRC_CORE_ATOM_INDEX_H_
+
+#include <vector>
+
+#include "../../include/dlplan/core.h"
+
+
+namespace dlplan::core {
+
+/**
+ * Atoms of a state grouped by predicate in flat arrays.
+ * It is built once per state and shared by all primitive elements,
+ * which then only visit the atoms of their own predicate.
+ */
+class AtomIndex {
+private:
+    // The atoms over predicate p are m_atom_offsets[p] to m_atom_offsets[p+1].
+    std::vector<int> m_atom_offsets;
+    // The object indices of these atoms, arity many per atom, start at m_object_offsets[p].
+    std::vector<int> m_object_offsets;
+    std::vector<int> m_object_idxs;
+
+public:
+    AtomIndex(const InstanceInfo& instance_info, const Index_Vec& atom_idxs);
+
+    int get_num_atoms(int predicate_idx) const {
+        if (predicate_idx + 1 >= static_cast<int>(m_atom_offsets.size())) return 0;
+        return m_atom_offsets[predicate_idx + 1] - m_atom_offsets[predicate_idx];
+    }
+
+    /**
+     * Calls visitor(object_idxs) with a pointer to the arity many object indices
+     * of every atom over the predicate in the state.
+     */
+    template<typename Visitor>
+    void for_each_atom(const Predicate& predicate, Visitor visitor) const {
+        const int predicate_idx = predicate.get_index();
+        const int arity = predicate.get_arity();
+        const int num_atoms = get_num_atoms(predicate_idx);
+        const int* object_idxs = m_object_idxs.data() + (num_atoms > 0 ? m_object_offsets[predicate_idx] : 0);
+        for (int i = 0; i < num_atoms; ++i, object_idxs += arity) {
+            visitor(object_idxs);
+        }
+    }
+};
+
+
+/**
+ * Denotations of the static atoms of an instance per predicate and position.
+ * Primitive elements OR them into their result
+ * instead of inserting the static atoms one by one.
+ */
+class StaticAtomMasks {
+private:
+    phmap::flat_hash_map<int, std::vector<ConceptDenotation>> m_concept_masks;
+    // Indexed by pos_1 * arity + pos_2.
+    phmap::flat_hash_map<int, std::vector<RoleDenotation>> m_role_masks;
+
+public:
+    explicit StaticAtomMasks(const InstanceInfo& instance_info);
+
+    /**
+     * Returns nullptr if there are no static atoms over the predicate.
+     */
+    const ConceptDenotation* get_concept_mask(const Predicate& predicate, int pos) const;
+    const RoleDenotation* get_role_mask(const Predicate& predicate, int pos_1, int pos_2) const;
+};
+
+}
+
+#endif
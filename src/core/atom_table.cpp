@@ -0,0 +1,133 @@
+#include "../../include/dlplan/core.h"
+
+#include <stdexcept>
+
+using namespace std::string_literals;
+
+
+namespace dlplan::core {
+
+AtomTable::AtomTable(std::shared_ptr<const VocabularyInfo> vocabulary_info, std::shared_ptr<const std::vector<Object>> objects)
+    : m_vocabulary_info(std::move(vocabulary_info)), m_objects(std::move(objects)), m_object_offsets({0}), m_num_names(0) { }
+
+AtomTable::AtomTable(const AtomTable& other)
+    : m_vocabulary_info(other.m_vocabulary_info),
+      m_objects(other.m_objects),
+      m_predicate_idxs(other.m_predicate_idxs),
+      m_object_offsets(other.m_object_offsets),
+      m_object_idxs(other.m_object_idxs) {
+    std::lock_guard<std::mutex> lock(other.m_names_mutex);
+    m_names = other.m_names;
+    m_num_names.store(other.m_num_names.load());
+    // The keys must view the copied names.
+    m_name_to_atom_idx.reserve(m_names.size());
+    for (int atom_idx = 0; atom_idx < static_cast<int>(m_names.size()); ++atom_idx) {
+        m_name_to_atom_idx.emplace(m_names[atom_idx], atom_idx);
+    }
+}
+
+AtomTable& AtomTable::operator=(const AtomTable& other) {
+    if (this != &other) {
+        AtomTable copy(other);
+        *this = std::move(copy);
+    }
+    return *this;
+}
+
+// Moving a deque keeps the addresses of its elements.
+AtomTable::AtomTable(AtomTable&& other)
+    : m_vocabulary_info(std::move(other.m_vocabulary_info)),
+      m_objects(std::move(other.m_objects)),
+      m_predicate_idxs(std::move(other.m_predicate_idxs)),
+      m_object_offsets(std::move(other.m_object_offsets)),
+      m_object_idxs(std::move(other.m_object_idxs)),
+      m_names(std::move(other.m_names)),
+      m_name_to_atom_idx(std::move(other.m_name_to_atom_idx)),
+      m_num_names(other.m_num_names.load()) { }
+
+AtomTable& AtomTable::operator=(AtomTable&& other) {
+    if (this != &other) {
+        m_vocabulary_info = std::move(other.m_vocabulary_info);
+        m_objects = std::move(other.m_objects);
+        m_predicate_idxs = std::move(other.m_predicate_idxs);
+        m_object_offsets = std::move(other.m_object_offsets);
+        m_object_idxs = std::move(other.m_object_idxs);
+        m_names = std::move(other.m_names);
+        m_name_to_atom_idx = std::move(other.m_name_to_atom_idx);
+        m_num_names.store(other.m_num_names.load());
+    }
+    return *this;
+}
+
+AtomTable::~AtomTable() = default;
+
+std::string AtomTable::compute_name(int predicate_idx, const int* object_idxs, int arity) const {
+    const auto& objects = *m_objects;
+    std::string name = m_vocabulary_info->get_predicate_ref(predicate_idx).get_name_ref();
+    name += "(";
+    for (int pos = 0; pos < arity; ++pos) {
+        name += objects[object_idxs[pos]].get_name_ref();
+        if (pos < arity - 1) name += ",";
+    }
+    name += ")";
+    return name;
+}
+
+void AtomTable::compute_names() const {
+    if (m_num_names.load(std::memory_order_acquire) == size()) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(m_names_mutex);
+    for (int atom_idx = m_num_names.load(std::memory_order_relaxed); atom_idx < size(); ++atom_idx) {
+        m_names.push_back(compute_name(m_predicate_idxs[atom_idx], get_object_idxs(atom_idx), get_arity(atom_idx)));
+        if (!m_name_to_atom_idx.emplace(m_names.back(), atom_idx).second) {
+            // Atoms added in bulk violated the precondition of being distinct.
+            std::string name = std::move(m_names.back());
+            m_names.pop_back();
+            m_num_names.store(atom_idx, std::memory_order_release);
+            throw std::runtime_error("AtomTable::compute_names - atom with name ("s + name + ") was added more than once.");
+        }
+    }
+    m_num_names.store(size(), std::memory_order_release);
+}
+
+void AtomTable::reserve(int num_atoms, int num_object_idxs) {
+    m_predicate_idxs.reserve(m_predicate_idxs.size() + num_atoms);
+    m_object_offsets.reserve(m_object_offsets.size() + num_atoms);
+    m_object_idxs.reserve(m_object_idxs.size() + num_object_idxs);
+}
+
+std::pair<int, bool> AtomTable::insert(int predicate_idx, const std::vector<int>& object_idxs) {
+    compute_names();
+    std::string name = compute_name(predicate_idx, object_idxs.data(), object_idxs.size());
+    auto it = m_name_to_atom_idx.find(std::string_view(name));
+    if (it != m_name_to_atom_idx.end()) {
+        return std::make_pair(it->second, false);
+    }
+    int atom_idx = push_back(predicate_idx, object_idxs.data(), object_idxs.size());
+    m_names.push_back(std::move(name));
+    m_name_to_atom_idx.emplace(m_names.back(), atom_idx);
+    m_num_names.store(size(), std::memory_order_release);
+    return std::make_pair(atom_idx, true);
+}
+
+int AtomTable::push_back(int predicate_idx, const int* object_idxs, int arity) {
+    int atom_idx = size();
+    m_predicate_idxs.push_back(predicate_idx);
+    m_object_idxs.insert(m_object_idxs.end(), object_idxs, object_idxs + arity);
+    m_object_offsets.push_back(m_object_idxs.size());
+    return atom_idx;
+}
+
+int AtomTable::find(const std::string& name) const {
+    compute_names();
+    auto it = m_name_to_atom_idx.find(std::string_view(name));
+    return (it != m_name_to_atom_idx.end()) ? it->second : -1;
+}
+
+const std::string& AtomTable::get_name_ref(int atom_idx) const {
+    compute_names();
+    return m_names[atom_idx];
+}
+
+}
@@ -6,29 +6,112 @@
 #include <iostream>
 #include <cassert>
 #include <mutex>
+#include <array>
+#include <cstdint>
+#include <type_traits>
+#include <typeindex>
+#include <typeinfo>
 
 #include "../../include/dlplan/core.h"
 
 
+namespace dlplan::core {
+
+/**
+ * Identifies an element by its class and the arguments of its constructor,
+ * where children are given by their process-wide unique id.
+ * Children are unique in the cache, hence equal keys describe equal elements,
+ * also if the children were constructed by another factory.
+ */
+struct ElementKey {
+    std::type_index type;
+    std::array<std::int64_t, 3> arguments;
+
+    bool operator==(const ElementKey& other) const {
+        return type == other.type && arguments == other.arguments;
+    }
+};
+
+}
+
+
+namespace std {
+    template<>
+    struct hash<dlplan::core::ElementKey> {
+        size_t operator()(const dlplan::core::ElementKey& key) const {
+            size_t seed = key.type.hash_code();
+            for (std::int64_t argument : key.arguments) {
+                seed ^= std::hash<std::int64_t>()(argument) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+            }
+            return seed;
+        }
+    };
+}
+
+
 namespace dlplan::core {
 
 /**
  * One cache for each template instantiated element.
  */
 struct Caches {
-    std::shared_ptr<utils::ReferenceCountedObjectCache<std::string, element::Concept>> m_concept_cache;
-    std::shared_ptr<utils::ReferenceCountedObjectCache<std::string, element::Role>> m_role_cache;
-    std::shared_ptr<utils::ReferenceCountedObjectCache<std::string, element::Numerical>> m_numerical_cache;
-    std::shared_ptr<utils::ReferenceCountedObjectCache<std::string, element::Boolean>> m_boolean_cache;
+    std::shared_ptr<utils::ReferenceCountedObjectCache<ElementKey, element::Concept>> m_concept_cache;
+    std::shared_ptr<utils::ReferenceCountedObjectCache<ElementKey, element::Role>> m_role_cache;
+    std::shared_ptr<utils::ReferenceCountedObjectCache<ElementKey, element::Numerical>> m_numerical_cache;
+    std::shared_ptr<utils::ReferenceCountedObjectCache<ElementKey, element::Boolean>> m_boolean_cache;
 
     Caches()
-        : m_concept_cache(std::make_shared<utils::ReferenceCountedObjectCache<std::string, element::Concept>>()),
-          m_role_cache(std::make_shared<utils::ReferenceCountedObjectCache<std::string, element::Role>>()),
-          m_numerical_cache(std::make_shared<utils::ReferenceCountedObjectCache<std::string, element::Numerical>>()),
-          m_boolean_cache(std::make_shared<utils::ReferenceCountedObjectCache<std::string, element::Boolean>>()) { }
+        : m_concept_cache(std::make_shared<utils::ReferenceCountedObjectCache<ElementKey, element::Concept>>()),
+          m_role_cache(std::make_shared<utils::ReferenceCountedObjectCache<ElementKey, element::Role>>()),
+          m_numerical_cache(std::make_shared<utils::ReferenceCountedObjectCache<ElementKey, element::Numerical>>()),
+          m_boolean_cache(std::make_shared<utils::ReferenceCountedObjectCache<ElementKey, element::Boolean>>()) { }
+
+    /**
+     * Retrieves the element T(vocabulary, args...) or constructs it if it is not cached.
+     */
+    template<typename T, typename... Args>
+    auto make(const VocabularyInfo& vocabulary, const Args&... args) {
+        ElementKey key{typeid(T), {-1, -1, -1}};
+        static_assert(sizeof...(Args) <= std::tuple_size<decltype(key.arguments)>::value);
+        int pos = 0;
+        ((key.arguments[pos++] = get_key_argument(args)), ...);
+        if (T::is_commutative && key.arguments[0] > key.arguments[1]) {
+            std::swap(key.arguments[0], key.arguments[1]);
+        }
+        auto create = [&]() { return std::make_unique<T>(vocabulary, args...); };
+        if constexpr (std::is_base_of_v<element::Concept, T>) {
+            return m_concept_cache->get_or_create(key, create).first;
+        } else if constexpr (std::is_base_of_v<element::Role, T>) {
+            return m_role_cache->get_or_create(key, create).first;
+        } else if constexpr (std::is_base_of_v<element::Numerical, T>) {
+            return m_numerical_cache->get_or_create(key, create).first;
+        } else {
+            static_assert(std::is_base_of_v<element::Boolean, T>);
+            return m_boolean_cache->get_or_create(key, create).first;
+        }
+    }
+
+private:
+    template<typename T>
+    static std::int64_t get_key_argument(const std::shared_ptr<const T>& element) {
+        // A missing child is reported by the constructor.
+        return element ? element->get_id() : -1;
+    }
+
+    static std::int64_t get_key_argument(const Predicate& predicate) {
+        return predicate.get_index();
+    }
+
+    static std::int64_t get_key_argument(const Constant& constant) {
+        return constant.get_index();
+    }
+
+    static std::int64_t get_key_argument(int value) {
+        return value;
+    }
 };
 
 
 }
 
-#endif
\ No newline at end of file
+#endif
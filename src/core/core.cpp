@@ -1,8 +1,10 @@
 #include "../../include/dlplan/core.h"
 
 #include <cassert>
+#include <iomanip>
 #include <iostream>
 #include <algorithm>
+#include <sstream>
 
 #include "elements/concept.h"
 #include "elements/role.h"
@@ -10,39 +12,39 @@
 #include "elements/boolean.h"
 
 #include "element_factory.h"
+#include "feature_program.h"
 #include "elements/types.h"
 
+#include "../utils/threadpool.h"
+
 
 
 namespace std {
     size_t hash<dlplan::core::State>::operator()(const dlplan::core::State& state) const noexcept {
         return state.compute_hash();
     }
-    size_t hash<unique_ptr<dlplan::core::ConceptDenotation>>::operator()(const unique_ptr<dlplan::core::ConceptDenotation>& denotation) const noexcept {
-        return denotation->compute_hash();
+    size_t hash<dlplan::core::ConceptDenotation>::operator()(const dlplan::core::ConceptDenotation& denotation) const noexcept {
+        return denotation.compute_hash();
     }
-    size_t hash<unique_ptr<dlplan::core::RoleDenotation>>::operator()(const unique_ptr<dlplan::core::RoleDenotation>& denotation) const noexcept {
-        return denotation->compute_hash();
+    size_t hash<dlplan::core::RoleDenotation>::operator()(const dlplan::core::RoleDenotation& denotation) const noexcept {
+        return denotation.compute_hash();
     }
-    size_t hash<unique_ptr<dlplan::core::ConceptDenotations>>::operator()(const unique_ptr<dlplan::core::ConceptDenotations>& denotations) const noexcept {
+    size_t hash<dlplan::core::ConceptDenotations>::operator()(const dlplan::core::ConceptDenotations& denotations) const noexcept {
         size_t seed = 0;
-        for (const auto denot_ptr : *denotations) {
+        for (const auto denot_ptr : denotations) {
             dlplan::utils::hash_combine(seed, denot_ptr);
         }
         return seed;
     }
-    size_t hash<unique_ptr<dlplan::core::RoleDenotations>>::operator()(const unique_ptr<dlplan::core::RoleDenotations>& denotations) const noexcept {
+    size_t hash<dlplan::core::RoleDenotations>::operator()(const dlplan::core::RoleDenotations& denotations) const noexcept {
         size_t seed = 0;
-        for (const auto denot_ptr : *denotations) {
+        for (const auto denot_ptr : denotations) {
             dlplan::utils::hash_combine(seed, denot_ptr);
         }
         return seed;
     }
-    size_t hash<unique_ptr<dlplan::core::BooleanDenotations>>::operator()(const unique_ptr<dlplan::core::BooleanDenotations>& denotations) const noexcept {
-        return hash<dlplan::core::BooleanDenotations>()(*denotations);
-    }
-    size_t hash<unique_ptr<dlplan::core::NumericalDenotations>>::operator()(const unique_ptr<dlplan::core::NumericalDenotations>& denotations) const noexcept {
-        return hash<dlplan::core::NumericalDenotations>()(*denotations);
+    size_t hash<dlplan::core::BitSlicedDenotations>::operator()(const dlplan::core::BitSlicedDenotations& denotations) const noexcept {
+        return denotations.compute_hash();
     }
     size_t hash<vector<unsigned>>::operator()(const vector<unsigned>& data) const noexcept {
         size_t seed = data.size();
@@ -58,12 +60,17 @@ namespace std {
         }
         return seed;
     }
-    size_t hash<std::array<int, 3>>::operator()(const std::array<int, 3>& data) const noexcept {
-        size_t seed = data.size();
-        for (int value : data) {
-            dlplan::utils::hash_combine(seed, value);
-        }
-        return seed;
+}
+
+namespace dlplan::utils {
+    std::size_t HeapBytes<dlplan::core::ConceptDenotation>::operator()(const dlplan::core::ConceptDenotation& denotation) const noexcept {
+        return denotation.get_bitset_ref().get_num_heap_bytes();
+    }
+    std::size_t HeapBytes<dlplan::core::RoleDenotation>::operator()(const dlplan::core::RoleDenotation& denotation) const noexcept {
+        return denotation.get_bitset_ref().get_num_heap_bytes();
+    }
+    std::size_t HeapBytes<dlplan::core::BitSlicedDenotations>::operator()(const dlplan::core::BitSlicedDenotations& denotations) const noexcept {
+        return denotations.get_num_heap_bytes();
     }
 }
 
@@ -71,7 +78,7 @@ namespace std {
 namespace dlplan::core {
 
 ConceptDenotation::ConceptDenotation(int num_objects)
-    : m_num_objects(num_objects), m_data(utils::DynamicBitset<unsigned>(num_objects)) { }
+    : m_num_objects(num_objects), m_data(ConceptBitset(num_objects)) { }
 
 ConceptDenotation::ConceptDenotation(const ConceptDenotation& other) = default;
 
@@ -84,15 +91,17 @@ ConceptDenotation& ConceptDenotation::operator=(ConceptDenotation&& other) = def
 ConceptDenotation::~ConceptDenotation() = default;
 
 void ConceptDenotation::const_iterator::seek_next() {
-    while (++m_index < m_num_objects) {
-        if (m_data.test(m_index)) break;
-    }
+    std::size_t next = m_data.find_next(m_index);
+    m_index = (next == value_type::npos) ? m_num_objects : static_cast<int>(next);
 }
 
 ConceptDenotation::const_iterator::const_iterator(
     ConceptDenotation::const_iterator::const_reference data, int num_objects, bool end)
-    : m_data(data), m_num_objects(num_objects), m_index(end ? num_objects : -1) {
-    if (!end) seek_next();
+    : m_data(data), m_num_objects(num_objects), m_index(num_objects) {
+    if (!end) {
+        std::size_t first = m_data.find_first();
+        if (first != value_type::npos) m_index = static_cast<int>(first);
+    }
 }
 
 bool ConceptDenotation::const_iterator::operator!=(const const_iterator& other) const {
@@ -198,20 +207,21 @@ bool ConceptDenotation::is_subset_of(const ConceptDenotation& other) const {
 
 std::vector<int> ConceptDenotation::to_sorted_vector() const {
     std::vector<int> result;
-    result.reserve(m_num_objects);
-    for (int i = 0; i < m_num_objects; ++i) {
-        if (m_data.test(i)) result.push_back(i);
-    }
-    result.shrink_to_fit();
+    result.reserve(count());
+    for_each([&](int value){ result.push_back(value); });
     return result;
 }
 
-const utils::DynamicBitset<unsigned>& ConceptDenotation::get_bitset_ref() const {
+ConceptBitset& ConceptDenotation::get_bitset_ref() {
+    return m_data;
+}
+
+const ConceptBitset& ConceptDenotation::get_bitset_ref() const {
     return m_data;
 }
 
 std::size_t ConceptDenotation::compute_hash() const {
-    return std::hash<std::vector<unsigned>>()(m_data.get_blocks());
+    return m_data.compute_hash();
 }
 
 int ConceptDenotation::get_num_objects() const {
@@ -220,7 +230,7 @@ int ConceptDenotation::get_num_objects() const {
 
 
 RoleDenotation::RoleDenotation(int num_objects)
-    : m_num_objects(num_objects), m_data(utils::DynamicBitset<unsigned>(num_objects * num_objects)) { }
+    : m_num_objects(num_objects), m_data(RoleBitset(num_objects * num_objects)) { }
 
 RoleDenotation::RoleDenotation(const RoleDenotation& other) = default;
 
@@ -233,25 +243,20 @@ RoleDenotation& RoleDenotation::operator=(RoleDenotation&& other) = default;
 RoleDenotation::~RoleDenotation() = default;
 
 void RoleDenotation::const_iterator::seek_next() {
-    int& i = m_indices.first;
-    int& j = m_indices.second;
-    int offset = i * m_num_objects;
-    while (i < m_num_objects) {
-        ++j;
-        if (j == m_num_objects) {  // end of row is reached
-            ++i;
-            offset += m_num_objects;
-            j = 0;
-            if (i == m_num_objects) break;  // reached last row
-        }
-        if (m_data.test(offset + j)) break;
+    set_position(m_data.find_next(m_indices.first * m_num_objects + m_indices.second));
+}
+
+void RoleDenotation::const_iterator::set_position(std::size_t pos) {
+    if (pos == value_type::npos) {
+        m_indices = std::make_pair(m_num_objects, 0);
+    } else {
+        m_indices = std::make_pair(static_cast<int>(pos / m_num_objects), static_cast<int>(pos % m_num_objects));
     }
-    assert(offset + j <= static_cast<int>(m_data.size()));
 }
 
 RoleDenotation::const_iterator::const_iterator(const_reference data, int num_objects, bool end)
-    : m_data(data), m_num_objects(num_objects), m_indices(end ? std::pair<size_t, size_t>(num_objects, 0) : std::pair<size_t, size_t>(0, -1)) {
-    if (!end) seek_next();
+    : m_data(data), m_num_objects(num_objects), m_indices(num_objects, 0) {
+    if (!end) set_position(m_data.find_first());
 }
 
 bool RoleDenotation::const_iterator::operator!=(const const_iterator& other) const {
@@ -358,28 +363,21 @@ bool RoleDenotation::is_subset_of(const RoleDenotation& other) const {
 
 std::vector<std::pair<int, int>> RoleDenotation::to_sorted_vector() const {
     std::vector<std::pair<int, int>> result;
-    result.reserve(m_num_objects * m_num_objects);
-    for (int i = 0; i < m_num_objects; ++i) {
-        for (int j = 0; j < m_num_objects; ++j) {
-            if (m_data.test(i * m_num_objects + j)) {
-                result.emplace_back(i, j);
-            }
-        }
-    }
-    result.shrink_to_fit();
+    result.reserve(count());
+    for_each([&](int first, int second){ result.emplace_back(first, second); });
     return result;
 }
 
-const utils::DynamicBitset<unsigned>& RoleDenotation::get_bitset_ref() const {
+RoleBitset& RoleDenotation::get_bitset_ref() {
     return m_data;
 }
 
-const std::vector<unsigned>& RoleDenotation::get_blocks() const {
-    return m_data.get_blocks();
+const RoleBitset& RoleDenotation::get_bitset_ref() const {
+    return m_data;
 }
 
 std::size_t RoleDenotation::compute_hash() const {
-    return std::hash<std::vector<unsigned>>()(m_data.get_blocks());
+    return m_data.compute_hash();
 }
 
 int RoleDenotation::get_num_objects() const {
@@ -387,6 +385,398 @@ int RoleDenotation::get_num_objects() const {
 }
 
 
+BitSlicedDenotations::BitSlicedDenotations(int num_objects, int num_positions, int num_states)
+    : m_num_objects(num_objects),
+      m_num_positions(num_positions),
+      m_num_states(num_states),
+      m_num_blocks_per_position((num_states + 63) / 64),
+      m_blocks(static_cast<std::size_t>(num_positions) * m_num_blocks_per_position, 0) { }
+
+template<typename Denotations>
+static void transpose(const Denotations& denotations, BitSlicedDenotations& result) {
+    for (int state_idx = 0; state_idx < static_cast<int>(denotations.size()); ++state_idx) {
+        denotations[state_idx]->get_bitset_ref().for_each_set_bit([&](std::size_t pos) {
+            result.insert(state_idx, static_cast<int>(pos));
+        });
+    }
+}
+
+BitSlicedDenotations::BitSlicedDenotations(const ConceptDenotations& denotations, int num_objects)
+    : BitSlicedDenotations(num_objects, num_objects, static_cast<int>(denotations.size())) {
+    transpose(denotations, *this);
+}
+
+BitSlicedDenotations::BitSlicedDenotations(const RoleDenotations& denotations, int num_objects)
+    : BitSlicedDenotations(num_objects, num_objects * num_objects, static_cast<int>(denotations.size())) {
+    transpose(denotations, *this);
+}
+
+BitSlicedDenotations::BitSlicedDenotations(const BitSlicedDenotations& other) = default;
+
+BitSlicedDenotations& BitSlicedDenotations::operator=(const BitSlicedDenotations& other) = default;
+
+BitSlicedDenotations::BitSlicedDenotations(BitSlicedDenotations&& other) = default;
+
+BitSlicedDenotations& BitSlicedDenotations::operator=(BitSlicedDenotations&& other) = default;
+
+BitSlicedDenotations::~BitSlicedDenotations() = default;
+
+void BitSlicedDenotations::zero_unused_bits() {
+    const int num_used_bits = m_num_states % 64;
+    if (num_used_bits == 0) return;
+    const std::uint64_t mask = (std::uint64_t(1) << num_used_bits) - 1;
+    for (int position = 0; position < m_num_positions; ++position) {
+        get_slice(position)[m_num_blocks_per_position - 1] &= mask;
+    }
+}
+
+bool BitSlicedDenotations::operator==(const BitSlicedDenotations& other) const {
+    return m_num_objects == other.m_num_objects
+        && m_num_positions == other.m_num_positions
+        && m_num_states == other.m_num_states
+        && m_blocks == other.m_blocks;
+}
+
+bool BitSlicedDenotations::operator!=(const BitSlicedDenotations& other) const {
+    return !(*this == other);
+}
+
+BitSlicedDenotations& BitSlicedDenotations::operator&=(const BitSlicedDenotations& other) {
+    assert(m_blocks.size() == other.m_blocks.size());
+    utils::kernels::get_kernels().bitwise_and(m_blocks.data(), other.m_blocks.data(), m_blocks.size());
+    return *this;
+}
+
+BitSlicedDenotations& BitSlicedDenotations::operator|=(const BitSlicedDenotations& other) {
+    assert(m_blocks.size() == other.m_blocks.size());
+    utils::kernels::get_kernels().bitwise_or(m_blocks.data(), other.m_blocks.data(), m_blocks.size());
+    return *this;
+}
+
+BitSlicedDenotations& BitSlicedDenotations::operator-=(const BitSlicedDenotations& other) {
+    assert(m_blocks.size() == other.m_blocks.size());
+    utils::kernels::get_kernels().bitwise_andnot(m_blocks.data(), other.m_blocks.data(), m_blocks.size());
+    return *this;
+}
+
+BitSlicedDenotations& BitSlicedDenotations::operator~() {
+    utils::kernels::get_kernels().bitwise_not(m_blocks.data(), m_blocks.size());
+    zero_unused_bits();
+    return *this;
+}
+
+void BitSlicedDenotations::set() {
+    std::fill(m_blocks.begin(), m_blocks.end(), ~std::uint64_t(0));
+    zero_unused_bits();
+}
+
+void BitSlicedDenotations::insert(int state_idx, int position) {
+    get_slice(position)[state_idx / 64] |= std::uint64_t(1) << (state_idx % 64);
+}
+
+bool BitSlicedDenotations::contains(int state_idx, int position) const {
+    return (get_slice(position)[state_idx / 64] >> (state_idx % 64)) & 1;
+}
+
+ConceptDenotation BitSlicedDenotations::get_concept_denotation(int state_idx) const {
+    if (state_idx < 0 || state_idx >= m_num_states || m_num_positions != m_num_objects) {
+        throw std::runtime_error("BitSlicedDenotations::get_concept_denotation - state index out of range or not a concept.");
+    }
+    ConceptDenotation result(m_num_objects);
+    for (int position = 0; position < m_num_positions; ++position) {
+        if (contains(state_idx, position)) result.get_bitset_ref().set(position);
+    }
+    return result;
+}
+
+RoleDenotation BitSlicedDenotations::get_role_denotation(int state_idx) const {
+    if (state_idx < 0 || state_idx >= m_num_states || m_num_positions != m_num_objects * m_num_objects) {
+        throw std::runtime_error("BitSlicedDenotations::get_role_denotation - state index out of range or not a role.");
+    }
+    RoleDenotation result(m_num_objects);
+    for (int position = 0; position < m_num_positions; ++position) {
+        if (contains(state_idx, position)) result.get_bitset_ref().set(position);
+    }
+    return result;
+}
+
+std::uint64_t* BitSlicedDenotations::get_slice(int position) {
+    return m_blocks.data() + static_cast<std::size_t>(position) * m_num_blocks_per_position;
+}
+
+const std::uint64_t* BitSlicedDenotations::get_slice(int position) const {
+    return m_blocks.data() + static_cast<std::size_t>(position) * m_num_blocks_per_position;
+}
+
+std::size_t BitSlicedDenotations::compute_hash() const {
+    std::size_t seed = m_num_positions;
+    utils::hash_combine(seed, m_num_states);
+    for (std::uint64_t block : m_blocks) {
+        utils::hash_combine(seed, block);
+    }
+    return seed;
+}
+
+std::size_t BitSlicedDenotations::get_num_heap_bytes() const {
+    return m_blocks.capacity() * sizeof(std::uint64_t);
+}
+
+int BitSlicedDenotations::get_num_objects() const {
+    return m_num_objects;
+}
+
+int BitSlicedDenotations::get_num_positions() const {
+    return m_num_positions;
+}
+
+int BitSlicedDenotations::get_num_states() const {
+    return m_num_states;
+}
+
+int BitSlicedDenotations::get_num_blocks_per_position() const {
+    return m_num_blocks_per_position;
+}
+
+
+EvaluationStatistics::EvaluationStatistics(std::string repr)
+    : repr(std::move(repr)), num_calls(0), num_hits(0), num_misses(0), num_nanoseconds(0), num_bytes(0) { }
+
+
+static const char* to_string(EvaluationStatisticsTable::ElementType type) {
+    switch (type) {
+        case EvaluationStatisticsTable::ElementType::CONCEPT: return "concept";
+        case EvaluationStatisticsTable::ElementType::ROLE: return "role";
+        case EvaluationStatisticsTable::ElementType::NUMERICAL: return "numerical";
+        case EvaluationStatisticsTable::ElementType::BOOLEAN: return "boolean";
+    }
+    return "unknown";
+}
+
+EvaluationStatisticsTable::~EvaluationStatisticsTable() {
+    for (auto& statistics : m_statistics) {
+        statistics.for_each([](EvaluationStatistics* element_statistics) { delete element_statistics; });
+    }
+}
+
+std::string EvaluationStatisticsTable::compute_table() const {
+    std::vector<std::pair<ElementType, const EvaluationStatistics*>> rows;
+    for_each([&](ElementType type, const EvaluationStatistics& statistics) {
+        rows.emplace_back(type, &statistics);
+    });
+    std::stable_sort(rows.begin(), rows.end(), [](const auto& left, const auto& right) {
+        return left.second->num_nanoseconds.load() > right.second->num_nanoseconds.load();
+    });
+    std::stringstream ss;
+    ss << std::left
+       << std::setw(11) << "type"
+       << std::setw(12) << "calls"
+       << std::setw(12) << "hits"
+       << std::setw(12) << "misses"
+       << std::setw(14) << "time [ms]"
+       << std::setw(14) << "bytes"
+       << "repr" << std::endl;
+    for (const auto& [type, statistics] : rows) {
+        ss << std::left
+           << std::setw(11) << to_string(type)
+           << std::setw(12) << statistics->num_calls.load()
+           << std::setw(12) << statistics->num_hits.load()
+           << std::setw(12) << statistics->num_misses.load()
+           << std::setw(14) << std::fixed << std::setprecision(3) << statistics->num_nanoseconds.load() / 1e6
+           << std::setw(14) << statistics->num_bytes.load()
+           << statistics->repr << std::endl;
+    }
+    return ss.str();
+}
+
+static void write_json_string(std::stringstream& out, const std::string& value) {
+    out << '"';
+    for (char c : value) {
+        if (c == '"' || c == '\\') {
+            out << '\\' << c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            out << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c) << std::dec << std::setfill(' ');
+        } else {
+            out << c;
+        }
+    }
+    out << '"';
+}
+
+std::string EvaluationStatisticsTable::compute_json() const {
+    std::stringstream ss;
+    ss << "[";
+    bool first = true;
+    for_each([&](ElementType type, const EvaluationStatistics& statistics) {
+        ss << (first ? "\n" : ",\n") << "  {\"type\": \"" << to_string(type) << "\", \"repr\": ";
+        write_json_string(ss, statistics.repr);
+        ss << ", \"calls\": " << statistics.num_calls.load()
+           << ", \"hits\": " << statistics.num_hits.load()
+           << ", \"misses\": " << statistics.num_misses.load()
+           << ", \"nanoseconds\": " << statistics.num_nanoseconds.load()
+           << ", \"bytes\": " << statistics.num_bytes.load() << "}";
+        first = false;
+    });
+    ss << (first ? "]" : "\n]");
+    return ss.str();
+}
+
+
+DenotationsCaches::DenotationsCaches()
+    : DenotationsCaches(std::numeric_limits<std::size_t>::max()) { }
+
+DenotationsCaches::DenotationsCaches(std::size_t byte_budget)
+    : m_byte_budget(byte_budget), m_num_owned_bytes(0), m_num_pins(0), m_num_threads(1) { }
+
+DenotationsCaches::~DenotationsCaches() {
+    if (!is_bounded()) return;
+    m_c_denots_mapping_per_state.for_each([](ConceptDenotation* denotation) { delete denotation; });
+    m_r_denots_mapping_per_state.for_each([](RoleDenotation* denotation) { delete denotation; });
+}
+
+template<typename T>
+static std::size_t compute_num_owned_bytes(const T& denotation) {
+    return sizeof(T) + utils::HeapBytes<T>()(denotation);
+}
+
+void DenotationsCaches::evict() {
+    // Evict below the budget such that the following evaluations do not evict immediately again.
+    const std::size_t target = m_byte_budget - m_byte_budget / 4;
+    auto release = [this](auto* denotation) {
+        m_num_owned_bytes.fetch_sub(compute_num_owned_bytes(*denotation), std::memory_order_relaxed);
+        delete denotation;
+    };
+    bool evicted = true;
+    while (evicted && compute_num_bytes() > target) {
+        evicted = m_c_denots_mapping_per_state.evict_page(release);
+        evicted |= m_r_denots_mapping_per_state.evict_page(release);
+        evicted |= m_n_denots_mapping_per_state.evict_page([](int) { });
+        evicted |= m_b_denots_mapping_per_state.evict_page([](signed char) { });
+    }
+}
+
+std::shared_lock<std::shared_mutex> DenotationsCaches::begin_bounded_evaluation() {
+    if (compute_num_bytes() > m_byte_budget) {
+        std::unique_lock<std::shared_mutex> hold(m_evaluation_mutex);
+        // Another thread may have evicted while this one waited.
+        if (m_num_pins.load(std::memory_order_relaxed) == 0 && compute_num_bytes() > m_byte_budget) evict();
+    }
+    return std::shared_lock<std::shared_mutex>(m_evaluation_mutex);
+}
+
+// The count is changed under the evaluation lock such that it is ordered with eviction.
+DenotationsCaches::Pin::Pin(DenotationsCaches& caches) : m_caches(&caches) {
+    std::shared_lock<std::shared_mutex> hold(caches.m_evaluation_mutex);
+    caches.m_num_pins.fetch_add(1, std::memory_order_relaxed);
+}
+
+DenotationsCaches::Pin::Pin(Pin&& other) : m_caches(other.m_caches) {
+    other.m_caches = nullptr;
+}
+
+DenotationsCaches::Pin::~Pin() {
+    if (m_caches) m_caches->m_num_pins.fetch_sub(1, std::memory_order_relaxed);
+}
+
+DenotationsCaches::Pin DenotationsCaches::pin() {
+    return Pin(*this);
+}
+
+template<typename T, typename Pool, typename Mapping>
+static T* insert_per_state(bool is_bounded, std::atomic<std::size_t>& num_owned_bytes, Pool& pool, Mapping& mapping,
+    int instance_idx, int state_idx, int element_idx, std::unique_ptr<T>&& denotation) {
+    if (!is_bounded) {
+        return mapping.insert(instance_idx, state_idx, element_idx, pool.insert(std::move(*denotation)).first);
+    }
+    T* owned = denotation.get();
+    T* stored = mapping.insert(instance_idx, state_idx, element_idx, owned);
+    if (stored == owned) {
+        num_owned_bytes.fetch_add(compute_num_owned_bytes(*owned), std::memory_order_relaxed);
+        denotation.release();
+    }
+    return stored;
+}
+
+ConceptDenotation* DenotationsCaches::insert(int instance_idx, int state_idx, int element_idx, std::unique_ptr<ConceptDenotation>&& denotation) {
+    return insert_per_state(is_bounded(), m_num_owned_bytes, m_c_denot_cache, m_c_denots_mapping_per_state,
+        instance_idx, state_idx, element_idx, std::move(denotation));
+}
+
+RoleDenotation* DenotationsCaches::insert(int instance_idx, int state_idx, int element_idx, std::unique_ptr<RoleDenotation>&& denotation) {
+    return insert_per_state(is_bounded(), m_num_owned_bytes, m_r_denot_cache, m_r_denots_mapping_per_state,
+        instance_idx, state_idx, element_idx, std::move(denotation));
+}
+
+std::size_t DenotationsCaches::compute_num_bytes() const {
+    return m_c_denot_cache.get_num_bytes()
+        + m_r_denot_cache.get_num_bytes()
+        + m_b_denots_cache.get_num_bytes()
+        + m_n_denots_cache.get_num_bytes()
+        + m_c_denots_cache.get_num_bytes()
+        + m_r_denots_cache.get_num_bytes()
+        + m_sliced_denots_cache.get_num_bytes()
+        + m_n_denots_mapping_per_state.get_num_bytes()
+        + m_b_denots_mapping_per_state.get_num_bytes()
+        + m_c_denots_mapping_per_state.get_num_bytes()
+        + m_r_denots_mapping_per_state.get_num_bytes()
+        + m_num_owned_bytes.load(std::memory_order_relaxed);
+}
+
+std::size_t DenotationsCaches::get_byte_budget() const {
+    return m_byte_budget;
+}
+
+void DenotationsCaches::set_num_threads(int num_threads) {
+    if (num_threads < 1) {
+        throw std::runtime_error("DenotationsCaches::set_num_threads - number of threads must be at least 1.");
+    }
+    if (num_threads == m_num_threads) return;
+    m_thread_pool.reset();
+    if (num_threads > 1) {
+        m_thread_pool = std::make_unique<utils::threadpool::ThreadPool>(num_threads);
+    }
+    m_num_threads = num_threads;
+}
+
+int DenotationsCaches::get_num_threads() const {
+    return m_num_threads;
+}
+
+// Smaller chunks cost more in scheduling than they gain in parallelism.
+static const std::size_t MIN_CHUNK_SIZE = 32;
+
+void DenotationsCaches::for_each_chunk(std::size_t size, const std::function<void(std::size_t, std::size_t)>& function) {
+    if (!m_thread_pool || size <= MIN_CHUNK_SIZE) {
+        function(0, size);
+        return;
+    }
+    // A few chunks per thread balance the load if the states differ in cost.
+    std::size_t chunk_size = std::max(MIN_CHUNK_SIZE, (size + 4 * m_num_threads - 1) / (4 * m_num_threads));
+    std::vector<utils::threadpool::ThreadPool::TaskFuture<void>> futures;
+    for (std::size_t begin = 0; begin < size; begin += chunk_size) {
+        std::size_t end = std::min(size, begin + chunk_size);
+        futures.push_back(m_thread_pool->submit([&function, begin, end]() { function(begin, end); }));
+    }
+    // Wait for all chunks before rethrowing because they reference the caller's data.
+    std::exception_ptr exception;
+    for (auto& future : futures) {
+        try {
+            future.get();
+        } catch (...) {
+            if (!exception) exception = std::current_exception();
+        }
+    }
+    if (exception) std::rethrow_exception(exception);
+}
+
+std::string DenotationsCaches::compute_statistics_table() const {
+    return m_statistics.compute_table();
+}
+
+std::string DenotationsCaches::compute_statistics_json() const {
+    return m_statistics.compute_json();
+}
+
+
 BaseElement::BaseElement(std::shared_ptr<const VocabularyInfo> vocabulary_info, int index)
     : m_vocabulary_info(vocabulary_info), m_index(index) { }
 
@@ -434,13 +824,29 @@ ConceptDenotation Concept::evaluate(const State& state) const {
 }
 
 ConceptDenotation* Concept::evaluate(const State& state, DenotationsCaches& caches) const {
+    auto evaluation = caches.begin_evaluation();
     return m_element->evaluate(state, caches);
 }
 
 ConceptDenotations* Concept::evaluate(const States& states, DenotationsCaches& caches) const {
+    auto evaluation = caches.begin_evaluation();
     return m_element->evaluate(states, caches);
 }
 
+static void check_same_instance(const States& states, const std::string& caller) {
+    for (const auto& state : states) {
+        if (&state.get_instance_info_ref() != &states.front().get_instance_info_ref()) {
+            throw std::runtime_error(caller + " - states must belong to the same instance.");
+        }
+    }
+}
+
+BitSlicedDenotations* Concept::evaluate_sliced(const States& states, DenotationsCaches& caches) const {
+    check_same_instance(states, "Concept::evaluate_sliced");
+    auto evaluation = caches.begin_evaluation();
+    return m_element->evaluate_sliced(states, caches);
+}
+
 int Concept::compute_complexity() const {
     return m_element->compute_complexity();
 }
@@ -483,13 +889,21 @@ RoleDenotation Role::evaluate(const State& state) const {
 }
 
 RoleDenotation* Role::evaluate(const State& state, DenotationsCaches& caches) const {
+    auto evaluation = caches.begin_evaluation();
     return m_element->evaluate(state, caches);
 }
 
 RoleDenotations* Role::evaluate(const States& states, DenotationsCaches& caches) const {
+    auto evaluation = caches.begin_evaluation();
     return m_element->evaluate(states, caches);
 }
 
+BitSlicedDenotations* Role::evaluate_sliced(const States& states, DenotationsCaches& caches) const {
+    check_same_instance(states, "Role::evaluate_sliced");
+    auto evaluation = caches.begin_evaluation();
+    return m_element->evaluate_sliced(states, caches);
+}
+
 int Role::compute_complexity() const {
     return m_element->compute_complexity();
 }
@@ -532,10 +946,12 @@ int Numerical::evaluate(const State& state) const {
 }
 
 int Numerical::evaluate(const State& state, DenotationsCaches& caches) const {
+    auto evaluation = caches.begin_evaluation();
     return m_element->evaluate(state, caches);
 }
 
 NumericalDenotations* Numerical::evaluate(const States& states, DenotationsCaches& caches) const {
+    auto evaluation = caches.begin_evaluation();
     return m_element->evaluate(states, caches);
 }
 
@@ -582,10 +998,12 @@ bool Boolean::evaluate(const State& state) const {
 }
 
 bool Boolean::evaluate(const State& state, DenotationsCaches& caches) const {
+    auto evaluation = caches.begin_evaluation();
     return m_element->evaluate(state, caches);
 }
 
 BooleanDenotations* Boolean::evaluate(const States& states, DenotationsCaches& caches) const {
+    auto evaluation = caches.begin_evaluation();
     return m_element->evaluate(states, caches);
 }
 
@@ -799,4 +1217,65 @@ Role SyntacticElementFactory::make_transitive_reflexive_closure(const Role& role
     return m_pImpl->make_transitive_reflexive_closure(role, index);
 }
 
+
+
+template<typename T>
+static std::vector<T> dereference(const std::vector<std::shared_ptr<const T>>& pointers) {
+    std::vector<T> result;
+    result.reserve(pointers.size());
+    for (const auto& pointer : pointers) result.push_back(*pointer);
+    return result;
+}
+
+FeatureProgram::FeatureProgram(const std::vector<Boolean>& booleans, const std::vector<Numerical>& numericals)
+    : m_pImpl(FeatureProgramImpl(booleans, numericals)) { }
+
+FeatureProgram::FeatureProgram(const std::vector<std::shared_ptr<const Boolean>>& booleans, const std::vector<std::shared_ptr<const Numerical>>& numericals)
+    : m_pImpl(FeatureProgramImpl(dereference(booleans), dereference(numericals))) { }
+
+FeatureProgram::FeatureProgram(const FeatureProgram& other) : m_pImpl(*other.m_pImpl) { }
+
+FeatureProgram& FeatureProgram::operator=(const FeatureProgram& other) {
+    if (this != &other) {
+        *m_pImpl = *other.m_pImpl;
+    }
+    return *this;
+}
+
+FeatureProgram::FeatureProgram(FeatureProgram&& other)
+    : m_pImpl(std::move(*other.m_pImpl)) { }
+
+FeatureProgram& FeatureProgram::operator=(FeatureProgram&& other) {
+    if (this != &other) {
+        std::swap(*m_pImpl, *other.m_pImpl);
+    }
+    return *this;
+}
+
+FeatureProgram::~FeatureProgram() = default;
+
+void FeatureProgram::evaluate(const State& state) {
+    m_pImpl->evaluate(state);
+}
+
+void FeatureProgram::evaluate_incrementally(const State& state) {
+    m_pImpl->evaluate_incrementally(state);
+}
+
+bool FeatureProgram::get_boolean_value(int boolean_idx) const {
+    return m_pImpl->get_boolean_value(boolean_idx);
+}
+
+int FeatureProgram::get_numerical_value(int numerical_idx) const {
+    return m_pImpl->get_numerical_value(numerical_idx);
+}
+
+int FeatureProgram::get_num_instructions() const {
+    return m_pImpl->get_num_instructions();
+}
+
+int FeatureProgram::get_num_executed_instructions() const {
+    return m_pImpl->get_num_executed_instructions();
+}
+
 }
@@ -59,181 +59,147 @@ Boolean SyntacticElementFactoryImpl::parse_boolean(const std::string &descriptio
 }
 
 Boolean SyntacticElementFactoryImpl::make_empty_boolean(const Concept& concept, int index) {
-    return Boolean(m_vocabulary_info, m_caches.m_boolean_cache->insert(
-        std::make_unique<element::EmptyBoolean<element::Concept>>(*m_vocabulary_info, concept.get_element())).first, index);
+    return Boolean(m_vocabulary_info, m_caches.make<element::EmptyBoolean<element::Concept>>(*m_vocabulary_info, concept.get_element()), index);
 }
 
 Boolean SyntacticElementFactoryImpl::make_empty_boolean(const Role& role, int index) {
-    return Boolean(m_vocabulary_info, m_caches.m_boolean_cache->insert(
-        std::make_unique<element::EmptyBoolean<element::Role>>(*m_vocabulary_info, role.get_element())).first, index);
+    return Boolean(m_vocabulary_info, m_caches.make<element::EmptyBoolean<element::Role>>(*m_vocabulary_info, role.get_element()), index);
 }
 
 Boolean SyntacticElementFactoryImpl::make_inclusion_boolean(const Concept& concept_left, const Concept& concept_right, int index) {
-    return Boolean(m_vocabulary_info, m_caches.m_boolean_cache->insert(
-        std::make_unique<element::InclusionBoolean<element::Concept>>(*m_vocabulary_info, concept_left.get_element(), concept_right.get_element())).first, index);
+    return Boolean(m_vocabulary_info, m_caches.make<element::InclusionBoolean<element::Concept>>(*m_vocabulary_info, concept_left.get_element(), concept_right.get_element()), index);
 }
 
 Boolean SyntacticElementFactoryImpl::make_inclusion_boolean(const Role& role_left, const Role& role_right, int index) {
-    return Boolean(m_vocabulary_info, m_caches.m_boolean_cache->insert(
-        std::make_unique<element::InclusionBoolean<element::Role>>(*m_vocabulary_info, role_left.get_element(), role_right.get_element())).first, index);
+    return Boolean(m_vocabulary_info, m_caches.make<element::InclusionBoolean<element::Role>>(*m_vocabulary_info, role_left.get_element(), role_right.get_element()), index);
 }
 
 Boolean SyntacticElementFactoryImpl::make_nullary_boolean(const Predicate& predicate, int index) {
-    return Boolean(m_vocabulary_info, m_caches.m_boolean_cache->insert(
-        std::make_unique<element::NullaryBoolean>(*m_vocabulary_info, predicate)).first, index);
+    return Boolean(m_vocabulary_info, m_caches.make<element::NullaryBoolean>(*m_vocabulary_info, predicate), index);
 }
 
 Concept SyntacticElementFactoryImpl::make_all_concept(const Role& role, const Concept& concept, int index) {
-    return Concept(m_vocabulary_info, m_caches.m_concept_cache->insert(
-        std::make_unique<element::AllConcept>(*m_vocabulary_info, role.get_element(), concept.get_element())).first, index);
+    return Concept(m_vocabulary_info, m_caches.make<element::AllConcept>(*m_vocabulary_info, role.get_element(), concept.get_element()), index);
 }
 
 Concept SyntacticElementFactoryImpl::make_and_concept(const Concept& concept_left, const Concept& concept_right, int index) {
-    return Concept(m_vocabulary_info, m_caches.m_concept_cache->insert(
-        std::make_unique<element::AndConcept>(*m_vocabulary_info, concept_left.get_element(), concept_right.get_element())).first, index);
+    return Concept(m_vocabulary_info, m_caches.make<element::AndConcept>(*m_vocabulary_info, concept_left.get_element(), concept_right.get_element()), index);
 }
 
 Concept SyntacticElementFactoryImpl::make_bot_concept(int index) {
-    return Concept(m_vocabulary_info, m_caches.m_concept_cache->insert(
-        std::make_unique<element::BotConcept>(*m_vocabulary_info)).first, index);
+    return Concept(m_vocabulary_info, m_caches.make<element::BotConcept>(*m_vocabulary_info), index);
 }
 
 Concept SyntacticElementFactoryImpl::make_diff_concept(const Concept& concept_left, const Concept& concept_right, int index) {
-    return Concept(m_vocabulary_info, m_caches.m_concept_cache->insert(
-        std::make_unique<element::DiffConcept>(*m_vocabulary_info, concept_left.get_element(), concept_right.get_element())).first, index);
+    return Concept(m_vocabulary_info, m_caches.make<element::DiffConcept>(*m_vocabulary_info, concept_left.get_element(), concept_right.get_element()), index);
 }
 
 Concept SyntacticElementFactoryImpl::make_equal_concept(const Role& role_left, const Role& role_right, int index) {
-    return Concept(m_vocabulary_info, m_caches.m_concept_cache->insert(
-        std::make_unique<element::EqualConcept>(*m_vocabulary_info, role_left.get_element(), role_right.get_element())).first, index);
+    return Concept(m_vocabulary_info, m_caches.make<element::EqualConcept>(*m_vocabulary_info, role_left.get_element(), role_right.get_element()), index);
 }
 
 Concept SyntacticElementFactoryImpl::make_not_concept(const Concept& concept, int index) {
-    return Concept(m_vocabulary_info, m_caches.m_concept_cache->insert(std::make_unique<element::NotConcept>(*m_vocabulary_info, concept.get_element())).first, index);
+    return Concept(m_vocabulary_info, m_caches.make<element::NotConcept>(*m_vocabulary_info, concept.get_element()), index);
 }
 
 Concept SyntacticElementFactoryImpl::make_one_of_concept(const Constant& constant, int index) {
-    return Concept(m_vocabulary_info, m_caches.m_concept_cache->insert(
-        std::make_unique<element::OneOfConcept>(*m_vocabulary_info, constant)).first, index);
+    return Concept(m_vocabulary_info, m_caches.make<element::OneOfConcept>(*m_vocabulary_info, constant), index);
 }
 
 Concept SyntacticElementFactoryImpl::make_or_concept(const Concept& concept_left, const Concept& concept_right, int index) {
-    return Concept(m_vocabulary_info, m_caches.m_concept_cache->insert(std::make_unique<element::OrConcept>(*m_vocabulary_info, concept_left.get_element(), concept_right.get_element())).first, index);
+    return Concept(m_vocabulary_info, m_caches.make<element::OrConcept>(*m_vocabulary_info, concept_left.get_element(), concept_right.get_element()), index);
 }
 
 Concept SyntacticElementFactoryImpl::make_projection_concept(const Role& role, int pos, int index) {
-    return Concept(m_vocabulary_info, m_caches.m_concept_cache->insert(
-        std::make_unique<element::ProjectionConcept>(*m_vocabulary_info, role.get_element(), pos)).first, index);
+    return Concept(m_vocabulary_info, m_caches.make<element::ProjectionConcept>(*m_vocabulary_info, role.get_element(), pos), index);
 }
 
 Concept SyntacticElementFactoryImpl::make_primitive_concept(const Predicate& predicate, int pos, int index) {
-    return Concept(m_vocabulary_info, m_caches.m_concept_cache->insert(
-        std::make_unique<element::PrimitiveConcept>(*m_vocabulary_info, predicate, pos)).first, index);
+    return Concept(m_vocabulary_info, m_caches.make<element::PrimitiveConcept>(*m_vocabulary_info, predicate, pos), index);
 }
 
 Concept SyntacticElementFactoryImpl::make_some_concept(const Role& role, const Concept& concept, int index) {
-    return Concept(m_vocabulary_info, m_caches.m_concept_cache->insert(
-        std::make_unique<element::SomeConcept>(*m_vocabulary_info, role.get_element(), concept.get_element())).first, index);
+    return Concept(m_vocabulary_info, m_caches.make<element::SomeConcept>(*m_vocabulary_info, role.get_element(), concept.get_element()), index);
 }
 
 Concept SyntacticElementFactoryImpl::make_subset_concept(const Role& role_left, const Role& role_right, int index) {
-    return Concept(m_vocabulary_info, m_caches.m_concept_cache->insert(
-        std::make_unique<element::SubsetConcept>(*m_vocabulary_info, role_left.get_element(), role_right.get_element())).first, index);
+    return Concept(m_vocabulary_info, m_caches.make<element::SubsetConcept>(*m_vocabulary_info, role_left.get_element(), role_right.get_element()), index);
 }
 
 Concept SyntacticElementFactoryImpl::make_top_concept(int index) {
-    return Concept(m_vocabulary_info, m_caches.m_concept_cache->insert(
-        std::make_unique<element::TopConcept>(*m_vocabulary_info)).first, index);
+    return Concept(m_vocabulary_info, m_caches.make<element::TopConcept>(*m_vocabulary_info), index);
 }
 
 Numerical SyntacticElementFactoryImpl::make_concept_distance_numerical(const Concept& concept_from, const Role& role, const Concept& concept_to, int index) {
-    return Numerical(m_vocabulary_info, m_caches.m_numerical_cache->insert(
-        std::make_unique<element::ConceptDistanceNumerical>(*m_vocabulary_info, concept_from.get_element(), role.get_element(), concept_to.get_element())).first, index);
+    return Numerical(m_vocabulary_info, m_caches.make<element::ConceptDistanceNumerical>(*m_vocabulary_info, concept_from.get_element(), role.get_element(), concept_to.get_element()), index);
 }
 
 Numerical SyntacticElementFactoryImpl::make_count_numerical(const Concept& concept, int index) {
-    return Numerical(m_vocabulary_info, m_caches.m_numerical_cache->insert(
-        std::make_unique<element::CountNumerical<element::Concept_Ptr>>(*m_vocabulary_info, concept.get_element())).first, index);
+    return Numerical(m_vocabulary_info, m_caches.make<element::CountNumerical<element::Concept_Ptr>>(*m_vocabulary_info, concept.get_element()), index);
 }
 
 Numerical SyntacticElementFactoryImpl::make_count_numerical(const Role& role, int index) {
-    return Numerical(m_vocabulary_info, m_caches.m_numerical_cache->insert(
-        std::make_unique<element::CountNumerical<element::Role_Ptr>>(*m_vocabulary_info, role.get_element())).first, index);
+    return Numerical(m_vocabulary_info, m_caches.make<element::CountNumerical<element::Role_Ptr>>(*m_vocabulary_info, role.get_element()), index);
 }
 
 Numerical SyntacticElementFactoryImpl::make_role_distance_numerical(const Role& role_from, const Role& role, const Role& role_to, int index) {
-    return Numerical(m_vocabulary_info, m_caches.m_numerical_cache->insert(
-        std::make_unique<element::RoleDistanceNumerical>(*m_vocabulary_info, role_from.get_element(), role.get_element(), role_to.get_element())).first, index);
+    return Numerical(m_vocabulary_info, m_caches.make<element::RoleDistanceNumerical>(*m_vocabulary_info, role_from.get_element(), role.get_element(), role_to.get_element()), index);
 }
 
 Numerical SyntacticElementFactoryImpl::make_sum_concept_distance_numerical(const Concept& concept_from, const Role& role, const Concept& concept_to, int index) {
-    return Numerical(m_vocabulary_info, m_caches.m_numerical_cache->insert(
-        std::make_unique<element::SumConceptDistanceNumerical>(*m_vocabulary_info, concept_from.get_element(), role.get_element(), concept_to.get_element())).first, index);
+    return Numerical(m_vocabulary_info, m_caches.make<element::SumConceptDistanceNumerical>(*m_vocabulary_info, concept_from.get_element(), role.get_element(), concept_to.get_element()), index);
 }
 
 Numerical SyntacticElementFactoryImpl::make_sum_role_distance_numerical(const Role& role_from, const Role& role, const Role& role_to, int index) {
-    return Numerical(m_vocabulary_info, m_caches.m_numerical_cache->insert(
-        std::make_unique<element::SumRoleDistanceNumerical>(*m_vocabulary_info, role_from.get_element(), role.get_element(), role_to.get_element())).first, index);
+    return Numerical(m_vocabulary_info, m_caches.make<element::SumRoleDistanceNumerical>(*m_vocabulary_info, role_from.get_element(), role.get_element(), role_to.get_element()), index);
 }
 
 Role SyntacticElementFactoryImpl::make_and_role(const Role& role_left, const Role& role_right, int index) {
-    return Role(m_vocabulary_info, m_caches.m_role_cache->insert(
-        std::make_unique<element::AndRole>(*m_vocabulary_info, role_left.get_element(), role_right.get_element())).first, index);
+    return Role(m_vocabulary_info, m_caches.make<element::AndRole>(*m_vocabulary_info, role_left.get_element(), role_right.get_element()), index);
 }
 
 Role SyntacticElementFactoryImpl::make_compose_role(const Role& role_left, const Role& role_right, int index) {
-    return Role(m_vocabulary_info, m_caches.m_role_cache->insert(
-        std::make_unique<element::ComposeRole>(*m_vocabulary_info, role_left.get_element(), role_right.get_element())).first, index);
+    return Role(m_vocabulary_info, m_caches.make<element::ComposeRole>(*m_vocabulary_info, role_left.get_element(), role_right.get_element()), index);
 }
 
 Role SyntacticElementFactoryImpl::make_diff_role(const Role& role_left, const Role& role_right, int index) {
-    return Role(m_vocabulary_info, m_caches.m_role_cache->insert(
-        std::make_unique<element::DiffRole>(*m_vocabulary_info, role_left.get_element(), role_right.get_element())).first, index);
+    return Role(m_vocabulary_info, m_caches.make<element::DiffRole>(*m_vocabulary_info, role_left.get_element(), role_right.get_element()), index);
 }
 
 Role SyntacticElementFactoryImpl::make_identity_role(const Concept& concept, int index) {
-    return Role(m_vocabulary_info, m_caches.m_role_cache->insert(
-        std::make_unique<element::IdentityRole>(*m_vocabulary_info, concept.get_element())).first, index);
+    return Role(m_vocabulary_info, m_caches.make<element::IdentityRole>(*m_vocabulary_info, concept.get_element()), index);
 }
 
 Role SyntacticElementFactoryImpl::make_inverse_role(const Role& role, int index) {
-    return Role(m_vocabulary_info, m_caches.m_role_cache->insert(
-        std::make_unique<element::InverseRole>(*m_vocabulary_info, role.get_element())).first, index);
+    return Role(m_vocabulary_info, m_caches.make<element::InverseRole>(*m_vocabulary_info, role.get_element()), index);
 }
 
 Role SyntacticElementFactoryImpl::make_not_role(const Role& role, int index) {
-    return Role(m_vocabulary_info, m_caches.m_role_cache->insert(
-        std::make_unique<element::NotRole>(*m_vocabulary_info, role.get_element())).first, index);
+    return Role(m_vocabulary_info, m_caches.make<element::NotRole>(*m_vocabulary_info, role.get_element()), index);
 }
 
 Role SyntacticElementFactoryImpl::make_or_role(const Role& role_left, const Role& role_right, int index) {
-    return Role(m_vocabulary_info, m_caches.m_role_cache->insert(
-        std::make_unique<element::OrRole>(*m_vocabulary_info, role_left.get_element(), role_right.get_element())).first, index);
+    return Role(m_vocabulary_info, m_caches.make<element::OrRole>(*m_vocabulary_info, role_left.get_element(), role_right.get_element()), index);
 }
 
 Role SyntacticElementFactoryImpl::make_primitive_role(const Predicate& predicate, int pos_1, int pos_2, int index) {
-    return Role(m_vocabulary_info, m_caches.m_role_cache->insert(
-        std::make_unique<element::PrimitiveRole>(*m_vocabulary_info, predicate, pos_1, pos_2)).first, index);
+    return Role(m_vocabulary_info, m_caches.make<element::PrimitiveRole>(*m_vocabulary_info, predicate, pos_1, pos_2), index);
 }
 
 Role SyntacticElementFactoryImpl::make_restrict_role(const Role& role, const Concept& concept, int index) {
-    return Role(m_vocabulary_info, m_caches.m_role_cache->insert(
-        std::make_unique<element::RestrictRole>(*m_vocabulary_info, role.get_element(), concept.get_element())).first, index);
+    return Role(m_vocabulary_info, m_caches.make<element::RestrictRole>(*m_vocabulary_info, role.get_element(), concept.get_element()), index);
 }
 
 Role SyntacticElementFactoryImpl::make_top_role(int index) {
-    return Role(m_vocabulary_info, m_caches.m_role_cache->insert(
-        std::make_unique<element::TopRole>(*m_vocabulary_info)).first, index);
+    return Role(m_vocabulary_info, m_caches.make<element::TopRole>(*m_vocabulary_info), index);
 }
 
 Role SyntacticElementFactoryImpl::make_transitive_closure(const Role& role, int index) {
-    return Role(m_vocabulary_info, m_caches.m_role_cache->insert(
-        std::make_unique<element::TransitiveClosureRole>(*m_vocabulary_info, role.get_element())).first, index);
+    return Role(m_vocabulary_info, m_caches.make<element::TransitiveClosureRole>(*m_vocabulary_info, role.get_element()), index);
 }
 
 Role SyntacticElementFactoryImpl::make_transitive_reflexive_closure(const Role& role, int index) {
-    return Role(m_vocabulary_info, m_caches.m_role_cache->insert(
-        std::make_unique<element::TransitiveReflexiveClosureRole>(*m_vocabulary_info, role.get_element())).first, index);
+    return Role(m_vocabulary_info, m_caches.make<element::TransitiveReflexiveClosureRole>(*m_vocabulary_info, role.get_element()), index);
 }
 
 const VocabularyInfo& SyntacticElementFactoryImpl::get_vocabulary_info_ref() const {
@@ -2,6 +2,8 @@
 #define DLPLAN_SRC_CORE_ELEMENTS_BOOLEAN_H_
 
 #include "element.h"
+#include "instrumentation.h"
+#include "program.h"
 
 
 namespace dlplan::core::element {
@@ -11,6 +13,22 @@ protected:
     virtual bool evaluate_impl(const State& state, DenotationsCaches& caches) const = 0;
     virtual std::unique_ptr<BooleanDenotations> evaluate_impl(const States& states, DenotationsCaches& caches) const = 0;
 
+    /**
+     * Computes the denotation in each state with compute(state_idx).
+     * Chunks of states are computed in parallel if the caches use several threads.
+     */
+    template<typename Compute>
+    std::unique_ptr<BooleanDenotations> compute_denotations(const States& states, DenotationsCaches& caches, Compute compute) const {
+        // Elements of std::vector<bool> cannot be written concurrently.
+        std::vector<char> buffer(states.size());
+        caches.for_each_chunk(states.size(), [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                buffer[i] = compute(i);
+            }
+        });
+        return std::make_unique<BooleanDenotations>(buffer.begin(), buffer.end());
+    }
+
 public:
     explicit Boolean(const VocabularyInfo& vocabulary) : Element<bool>(vocabulary) { }
     ~Boolean() override = default;
@@ -20,18 +38,34 @@ public:
      */
     virtual bool evaluate(const State& state) const = 0;
 
+    /**
+     * Compiles the children into the program and returns their registers.
+     */
+    virtual Operands compile(ProgramCompiler& compiler) const = 0;
+
+    /**
+     * Evaluate for a single state with the denotations of the children taken from the registers.
+     */
+    virtual bool execute(const State& state, const Registers& registers, const Operands& operands) const = 0;
+
     /**
      * Evaluate with caching for a single state.
      */
     bool evaluate(const State& state, DenotationsCaches& caches) const {
+        EvaluationRecorder recorder(caches, EvaluationStatisticsTable::ElementType::BOOLEAN, *this, get_index());
         // check if denotations is cached.
-        auto key = std::array<int, 3>({state.get_instance_info_ref().get_index(), state.get_index(), get_index()});
-        auto cached = caches.m_b_denots_mapping_per_state.find(key);
-        if (cached != caches.m_b_denots_mapping_per_state.end()) return cached->second;
+        int instance_idx = state.get_instance_info_ref().get_index();
+        auto cached = caches.m_b_denots_mapping_per_state.find(instance_idx, state.get_index(), get_index());
+        if (cached != caches.m_b_denots_mapping_per_state.not_computed) {
+            recorder.record_hit();
+            return cached;
+        }
         // compute denotation
+        recorder.begin_miss();
         bool denotation = evaluate_impl(state, caches);
         // register denotation and return it
-        caches.m_b_denots_mapping_per_state.emplace(key, denotation);
+        caches.m_b_denots_mapping_per_state.insert(instance_idx, state.get_index(), get_index(), denotation);
+        recorder.end_miss();
         return denotation;
     }
 
@@ -39,14 +73,20 @@ public:
      * Evaluate with caching for a collection of states.
      */
     BooleanDenotations* evaluate(const States& states, DenotationsCaches& caches) const {
+        EvaluationRecorder recorder(caches, EvaluationStatisticsTable::ElementType::BOOLEAN, *this, get_index());
         // check if denotations is cached.
         auto cached = caches.m_b_denots_mapping.find(get_index());
-        if (cached != caches.m_b_denots_mapping.end()) return cached->second;
+        if (cached != caches.m_b_denots_mapping.not_computed) {
+            recorder.record_hit();
+            return cached;
+        }
         // compute denotations
+        recorder.begin_miss();
         auto denotations = evaluate_impl(states, caches);
         // register denotations and return it.
-        auto result_denotations = caches.m_b_denots_cache.insert(std::move(denotations)).first->get();
-        caches.m_b_denots_mapping.emplace(get_index(), result_denotations);
+        auto result_denotations = caches.m_b_denots_cache.insert(std::move(*denotations)).first;
+        caches.m_b_denots_mapping.insert(get_index(), result_denotations);
+        recorder.end_miss();
         return result_denotations;
     }
 };
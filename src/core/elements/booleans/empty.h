@@ -26,16 +26,14 @@ private:
 
     std::unique_ptr<BooleanDenotations>
     evaluate_impl(const States& states, DenotationsCaches& caches) const override {
-        auto denotations = std::make_unique<BooleanDenotations>();
         auto element_denotations = m_element->evaluate(states, caches);
-        for (size_t i = 0; i < states.size(); ++i) {
+        return compute_denotations(states, caches, [&](size_t i) {
             bool denotation;
             compute_result(
                 *(*element_denotations)[i],
                 denotation);
-            denotations->push_back(denotation);
-        }
-        return denotations;
+            return denotation;
+        });
     }
 
 protected:
@@ -52,6 +50,16 @@ public:
         return denotation;
     }
 
+    Operands compile(ProgramCompiler& compiler) const override {
+        return {compiler.compile(*m_element), -1, -1};
+    }
+
+    bool execute(const State&, const Registers& registers, const Operands& operands) const override {
+        bool denotation;
+        compute_result(registers.get(*m_element, operands[0]), denotation);
+        return denotation;
+    }
+
     int compute_complexity() const override {
         return m_element->compute_complexity() + 1;
     }
@@ -29,18 +29,16 @@ private:
 
     std::unique_ptr<BooleanDenotations>
     evaluate_impl(const States& states, DenotationsCaches& caches) const override {
-        auto denotations = std::make_unique<BooleanDenotations>();
         auto element_left_denotations = m_element_left->evaluate(states, caches);
-        auto element_right_denotations = m_element_left->evaluate(states, caches);
-        for (size_t i = 0; i < states.size(); ++i) {
+        auto element_right_denotations = m_element_right->evaluate(states, caches);
+        return compute_denotations(states, caches, [&](size_t i) {
             bool denotation;
             compute_result(
                 *(*element_left_denotations)[i],
                 *(*element_right_denotations)[i],
                 denotation);
-            denotations->push_back(denotation);
-        }
-        return denotations;
+            return denotation;
+        });
     }
 
 protected:
@@ -61,6 +59,19 @@ public:
         return denotation;
     }
 
+    Operands compile(ProgramCompiler& compiler) const override {
+        return {compiler.compile(*m_element_left), compiler.compile(*m_element_right), -1};
+    }
+
+    bool execute(const State&, const Registers& registers, const Operands& operands) const override {
+        bool denotation;
+        compute_result(
+            registers.get(*m_element_left, operands[0]),
+            registers.get(*m_element_right, operands[1]),
+            denotation);
+        return denotation;
+    }
+
     int compute_complexity() const override {
         return m_element_left->compute_complexity() + m_element_right->compute_complexity() + 1;
     }
@@ -2,6 +2,7 @@
 #define DLPLAN_SRC_CORE_ELEMENTS_BOOLEANS_NULLARY_H_
 
 #include "../boolean.h"
+#include "../../atom_index.h"
 
 
 
@@ -10,21 +11,13 @@ namespace dlplan::core::element {
 class NullaryBoolean : public Boolean {
 private:
     void compute_result(const State& state, bool& result) const {
-        const auto& atoms = state.get_instance_info_ref().get_atoms_ref();
-        for (int atom_idx : state.get_atom_idxs_ref()) {
-            const auto& atom = atoms[atom_idx];
-            if (atom.get_predicate_ref().get_index() == m_predicate.get_index()) {
-                result = true;
-                return;
-            }
+        if (state.get_atom_index_ref().get_num_atoms(m_predicate.get_index()) > 0) {
+            result = true;
+            return;
         }
         const auto& per_predicate_idx_static_atom_idxs = state.get_instance_info_ref().get_per_predicate_idx_static_atom_idxs_ref();
         auto it = per_predicate_idx_static_atom_idxs.find(m_predicate.get_index());
-        if (it != per_predicate_idx_static_atom_idxs.end()) {
-            result = !it->second.empty();
-            return;
-        }
-        result = false;
+        result = (it != per_predicate_idx_static_atom_idxs.end()) && !it->second.empty();
     }
 
     bool evaluate_impl(const State& state, DenotationsCaches&) const override {
@@ -32,12 +25,10 @@ private:
     }
 
     std::unique_ptr<BooleanDenotations>
-    evaluate_impl(const States& states, DenotationsCaches&) const override {
-        auto denotations = std::make_unique<BooleanDenotations>();
-        for (size_t i = 0; i < states.size(); ++i) {
-            denotations->push_back(evaluate(states[i]));
-        }
-        return denotations;
+    evaluate_impl(const States& states, DenotationsCaches& caches) const override {
+        return compute_denotations(states, caches, [&](size_t i) {
+            return evaluate(states[i]);
+        });
     }
 
 protected:
@@ -60,6 +51,17 @@ public:
         return denotation;
     }
 
+    Operands compile(ProgramCompiler& compiler) const override {
+        compiler.read_predicate(m_predicate);
+        return {-1, -1, -1};
+    }
+
+    bool execute(const State& state, const Registers&, const Operands&) const override {
+        bool denotation;
+        compute_result(state, denotation);
+        return denotation;
+    }
+
     int compute_complexity() const override {
         return 1;
     }
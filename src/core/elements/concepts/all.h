@@ -31,20 +31,14 @@ private:
     }
 
     std::unique_ptr<ConceptDenotations> evaluate_impl(const States& states, DenotationsCaches& caches) const override {
-        auto denotations = std::make_unique<ConceptDenotations>();
-        denotations->reserve(states.size());
         auto role_denotations = m_role->evaluate(states, caches);
         auto concept_denotations = m_concept->evaluate(states, caches);
-        for (size_t i = 0; i < states.size(); ++i) {
-            auto denotation = std::make_unique<ConceptDenotation>(
-                ConceptDenotation(states[i].get_instance_info_ref().get_num_objects()));
+        return compute_denotations(states, caches, [&](size_t i, ConceptDenotation& denotation) {
             compute_result(
                 *(*role_denotations)[i],
                 *(*concept_denotations)[i],
-                *denotation);
-            denotations->push_back(caches.m_c_denot_cache.insert(std::move(denotation)).first->get());
-        }
-        return denotations;
+                denotation);
+        });
     }
 
 protected:
@@ -68,6 +62,17 @@ public:
         return denotation;
     }
 
+    Operands compile(ProgramCompiler& compiler) const override {
+        return {compiler.compile(*m_role), compiler.compile(*m_concept), -1};
+    }
+
+    void execute(const State&, const Registers& registers, const Operands& operands, ConceptDenotation& result) const override {
+        compute_result(
+            registers.roles[operands[0]],
+            registers.concepts[operands[1]],
+            result);
+    }
+
     int compute_complexity() const override {
         return m_role->compute_complexity() + m_concept->compute_complexity() + 1;
     }
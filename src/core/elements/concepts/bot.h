@@ -15,14 +15,12 @@ private:
     }
 
     std::unique_ptr<ConceptDenotations> evaluate_impl(const States& states, DenotationsCaches& caches) const override {
-        auto denotations = std::make_unique<ConceptDenotations>();
-        denotations->reserve(states.size());
-        for (size_t i = 0; i < states.size(); ++i) {
-            auto denotation = std::make_unique<ConceptDenotation>(
-                ConceptDenotation(states[i].get_instance_info_ref().get_num_objects()));
-            denotations->push_back(caches.m_c_denot_cache.insert(std::move(denotation)).first->get());
-        }
-        return denotations;
+        return compute_denotations(states, caches, [](size_t, ConceptDenotation&) { });
+    }
+
+    std::unique_ptr<BitSlicedDenotations> evaluate_sliced_impl(const States& states, DenotationsCaches&) const override {
+        int num_objects = states.empty() ? 0 : states.front().get_instance_info_ref().get_num_objects();
+        return std::make_unique<BitSlicedDenotations>(num_objects, num_objects, static_cast<int>(states.size()));
     }
 
 public:
@@ -33,6 +31,14 @@ public:
         return ConceptDenotation(state.get_instance_info_ref().get_num_objects());
     }
 
+    Operands compile(ProgramCompiler&) const override {
+        return {-1, -1, -1};
+    }
+
+    void execute(const State&, const Registers&, const Operands&, ConceptDenotation&) const override {
+        // The result is empty initially.
+    }
+
     int compute_complexity() const override {
         return 1;
     }
@@ -24,19 +24,19 @@ private:
     }
 
     std::unique_ptr<ConceptDenotations> evaluate_impl(const States& states, DenotationsCaches& caches) const override {
-        auto denotations = std::make_unique<ConceptDenotations>();
-        denotations->reserve(states.size());
         auto concept_left_denotations = m_concept_left->evaluate(states, caches);
         auto concept_right_denotations = m_concept_right->evaluate(states, caches);
-        for (size_t i = 0; i < states.size(); ++i) {
-            auto denotation = std::make_unique<ConceptDenotation>(
-                ConceptDenotation(states[i].get_instance_info_ref().get_num_objects()));
+        return compute_denotations(states, caches, [&](size_t i, ConceptDenotation& denotation) {
             compute_result(
                 *(*concept_left_denotations)[i],
                 *(*concept_right_denotations)[i],
-                *denotation);
-            denotations->push_back(caches.m_c_denot_cache.insert(std::move(denotation)).first->get());
-        }
+                denotation);
+        });
+    }
+
+    std::unique_ptr<BitSlicedDenotations> evaluate_sliced_impl(const States& states, DenotationsCaches& caches) const override {
+        auto denotations = std::make_unique<BitSlicedDenotations>(*m_concept_left->evaluate_sliced(states, caches));
+        *denotations -= *m_concept_right->evaluate_sliced(states, caches);
         return denotations;
     }
 
@@ -61,6 +61,17 @@ public:
         return result;
     }
 
+    Operands compile(ProgramCompiler& compiler) const override {
+        return {compiler.compile(*m_concept_left), compiler.compile(*m_concept_right), -1};
+    }
+
+    void execute(const State&, const Registers& registers, const Operands& operands, ConceptDenotation& result) const override {
+        compute_result(
+            registers.concepts[operands[0]],
+            registers.concepts[operands[1]],
+            result);
+    }
+
     int compute_complexity() const override {
         return m_concept_left->compute_complexity() + m_concept_right->compute_complexity() + 1;
     }
@@ -23,18 +23,18 @@ private:
     }
 
     std::unique_ptr<ConceptDenotations> evaluate_impl(const States& states, DenotationsCaches& caches) const override {
-        auto denotations = std::make_unique<ConceptDenotations>();
-        denotations->reserve(states.size());
         // get denotations of children
         auto concept_denotations = m_concept->evaluate(states, caches);
-        for (size_t i = 0; i < states.size(); ++i) {
-            auto denotation = std::make_unique<ConceptDenotation>(
-                ConceptDenotation(states[i].get_instance_info_ref().get_num_objects()));
+        return compute_denotations(states, caches, [&](size_t i, ConceptDenotation& denotation) {
             compute_result(
                 *(*concept_denotations)[i],
-                *denotation);
-            denotations->push_back(caches.m_c_denot_cache.insert(std::move(denotation)).first->get());
-        }
+                denotation);
+        });
+    }
+
+    std::unique_ptr<BitSlicedDenotations> evaluate_sliced_impl(const States& states, DenotationsCaches& caches) const override {
+        auto denotations = std::make_unique<BitSlicedDenotations>(*m_concept->evaluate_sliced(states, caches));
+        ~*denotations;
         return denotations;
     }
 
@@ -57,6 +57,16 @@ public:
         return denotation;
     }
 
+    Operands compile(ProgramCompiler& compiler) const override {
+        return {compiler.compile(*m_concept), -1, -1};
+    }
+
+    void execute(const State&, const Registers& registers, const Operands& operands, ConceptDenotation& result) const override {
+        compute_result(
+            registers.concepts[operands[0]],
+            result);
+    }
+
     int compute_complexity() const override {
         return m_concept->compute_complexity() + 1;
     }
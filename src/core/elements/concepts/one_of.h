@@ -9,7 +9,11 @@ namespace dlplan::core::element {
 class OneOfConcept : public Concept {
 private:
     void compute_result(const State& state, ConceptDenotation& result) const {
-        result.insert(state.get_instance_info_ref().get_object_idx(m_constant.get_name_ref()));
+        int object_idx = state.get_instance_info_ref().get_constant_object_idx(m_constant);
+        if (object_idx == -1) {
+            throw std::runtime_error("OneOfConcept::compute_result - no object with name of constant exists in instance: (" + m_constant.get_name_ref() + ")");
+        }
+        result.insert(object_idx);
     }
 
     std::unique_ptr<ConceptDenotation> evaluate_impl(const State& state, DenotationsCaches&) const override {
@@ -22,17 +26,11 @@ private:
     }
 
     std::unique_ptr<ConceptDenotations> evaluate_impl(const States& states, DenotationsCaches& caches) const override {
-        auto denotations = std::make_unique<ConceptDenotations>();
-        denotations->reserve(states.size());
-        for (size_t i = 0; i < states.size(); ++i) {
-            auto denotation = std::make_unique<ConceptDenotation>(
-                ConceptDenotation(states[i].get_instance_info_ref().get_num_objects()));
+        return compute_denotations(states, caches, [&](size_t i, ConceptDenotation& denotation) {
             compute_result(
                 states[i],
-                *denotation);
-            denotations->push_back(caches.m_c_denot_cache.insert(std::move(denotation)).first->get());
-        }
-        return denotations;
+                denotation);
+        });
     }
 
 protected:
@@ -44,14 +42,19 @@ public:
     }
 
     ConceptDenotation evaluate(const State& state) const override {
-        if (!state.get_instance_info_ref().exists_object(m_constant.get_name_ref())) {
-            throw std::runtime_error("OneOfConcept::evaluate - no object with name of constant exists in instance: (" + m_constant.get_name_ref() + ")");
-        }
         ConceptDenotation result(state.get_instance_info_ref().get_num_objects());
         compute_result(state, result);
         return result;
     }
 
+    Operands compile(ProgramCompiler&) const override {
+        return {-1, -1, -1};
+    }
+
+    void execute(const State& state, const Registers&, const Operands&, ConceptDenotation& result) const override {
+        compute_result(state, result);
+    }
+
     int compute_complexity() const override {
         return 1;
     }
@@ -25,20 +25,19 @@ private:
     }
 
     std::unique_ptr<ConceptDenotations> evaluate_impl(const States& states, DenotationsCaches& caches) const override {
-        auto denotations = std::make_unique<ConceptDenotations>();
-        denotations->reserve(states.size());
         auto concept_left_denotations = m_concept_left->evaluate(states, caches);
         auto concept_right_denotations = m_concept_right->evaluate(states, caches);
-        for (size_t i = 0; i < states.size(); ++i) {
-            const auto& state = states[i];
-            int num_objects = state.get_instance_info_ref().get_num_objects();
-            auto denotation = std::make_unique<ConceptDenotation>(ConceptDenotation(num_objects));
+        return compute_denotations(states, caches, [&](size_t i, ConceptDenotation& denotation) {
             compute_result(
                 *(*concept_left_denotations)[i],
                 *(*concept_right_denotations)[i],
-                *denotation);
-            denotations->push_back(caches.m_c_denot_cache.insert(std::move(denotation)).first->get());
-        }
+                denotation);
+        });
+    }
+
+    std::unique_ptr<BitSlicedDenotations> evaluate_sliced_impl(const States& states, DenotationsCaches& caches) const override {
+        auto denotations = std::make_unique<BitSlicedDenotations>(*m_concept_left->evaluate_sliced(states, caches));
+        *denotations |= *m_concept_right->evaluate_sliced(states, caches);
         return denotations;
     }
 
@@ -47,6 +46,8 @@ protected:
     Concept_Ptr m_concept_right;
 
 public:
+    static constexpr bool is_commutative = true;
+
     OrConcept(const VocabularyInfo& vocabulary, Concept_Ptr concept_1, Concept_Ptr concept_2)
     : Concept(vocabulary),
       m_concept_left(concept_1),
@@ -54,11 +55,7 @@ public:
         if (!(concept_1 && concept_2)) {
             throw std::runtime_error("OrConcept::OrConcept - at least one child is a nullptr.");
         }
-        std::stringstream ss1;
-        m_concept_left->compute_repr(ss1);
-        std::stringstream ss2;
-        m_concept_right->compute_repr(ss2);
-        if (ss1.str() > ss2.str()) swap(m_concept_left, m_concept_right);
+        if (m_concept_left->get_id() > m_concept_right->get_id()) swap(m_concept_left, m_concept_right);
     }
 
     ConceptDenotation evaluate(const State& state) const override {
@@ -70,6 +67,17 @@ public:
         return result;
     }
 
+    Operands compile(ProgramCompiler& compiler) const override {
+        return {compiler.compile(*m_concept_left), compiler.compile(*m_concept_right), -1};
+    }
+
+    void execute(const State&, const Registers& registers, const Operands& operands, ConceptDenotation& result) const override {
+        compute_result(
+            registers.concepts[operands[0]],
+            registers.concepts[operands[1]],
+            result);
+    }
+
     int compute_complexity() const override {
         return m_concept_left->compute_complexity() + m_concept_right->compute_complexity() + 1;
     }
@@ -4,28 +4,19 @@
 #include <sstream>
 
 #include "../concept.h"
+#include "../../atom_index.h"
 
 namespace dlplan::core::element {
 
 class PrimitiveConcept : public Concept {
 private:
     void compute_result(const State& state, ConceptDenotation& result) const {
-        const auto& instance_info = state.get_instance_info_ref();
-        const auto& atoms = instance_info.get_atoms_ref();
-        for (int atom_idx : state.get_atom_idxs_ref()) {
-            const auto& atom = atoms[atom_idx];
-            if (atom.get_predicate_ref().get_index() == m_predicate.get_index()) {
-                result.insert(atom.get_object_ref(m_pos).get_index());
-            }
-        }
-        const auto& static_atoms = instance_info.get_static_atoms_ref();
-        const auto& per_predicate_idx_static_atom_idxs = instance_info.get_per_predicate_idx_static_atom_idxs_ref();
-        auto it = per_predicate_idx_static_atom_idxs.find(m_predicate.get_index());
-        if (it != per_predicate_idx_static_atom_idxs.end()) {
-            for (int atom_idx : it->second) {
-                const auto& atom = static_atoms[atom_idx];
-                result.insert(atom.get_object_ref(m_pos).get_index());
-            }
+        state.get_atom_index_ref().for_each_atom(m_predicate, [&](const int* object_idxs) {
+            result.insert(object_idxs[m_pos]);
+        });
+        const auto* static_mask = state.get_instance_info_ref().get_static_atom_masks_ref().get_concept_mask(m_predicate, m_pos);
+        if (static_mask) {
+            result |= *static_mask;
         }
     }
 
@@ -39,17 +30,11 @@ private:
     }
 
     std::unique_ptr<ConceptDenotations> evaluate_impl(const States& states, DenotationsCaches& caches) const override {
-        auto denotations = std::make_unique<ConceptDenotations>();
-        denotations->reserve(states.size());
-        for (size_t i = 0; i < states.size(); ++i) {
-            auto denotation = std::make_unique<ConceptDenotation>(
-                ConceptDenotation(states[i].get_instance_info_ref().get_num_objects()));
+        return compute_denotations(states, caches, [&](size_t i, ConceptDenotation& denotation) {
             compute_result(
                 states[i],
-                *denotation);
-            denotations->push_back(caches.m_c_denot_cache.insert(std::move(denotation)).first->get());
-        }
-        return denotations;
+                denotation);
+        });
     }
 
 protected:
@@ -73,6 +58,15 @@ public:
         return denotation;
     }
 
+    Operands compile(ProgramCompiler& compiler) const override {
+        compiler.read_predicate(m_predicate);
+        return {-1, -1, -1};
+    }
+
+    void execute(const State& state, const Registers&, const Operands&, ConceptDenotation& result) const override {
+        compute_result(state, result);
+    }
+
     int compute_complexity() const override {
         return 1;
     }
@@ -28,21 +28,14 @@ private:
     }
 
     std::unique_ptr<ConceptDenotations> evaluate_impl(const States& states, DenotationsCaches& caches) const override {
-        auto denotations = std::make_unique<ConceptDenotations>();
-        denotations->reserve(states.size());
         auto role_left_denotations = m_role_left->evaluate(states, caches);
         auto role_right_denotations = m_role_right->evaluate(states, caches);
-        for (size_t i = 0; i < states.size(); ++i) {
-            auto denotation = std::make_unique<ConceptDenotation>(
-                ConceptDenotation(states[i].get_instance_info_ref().get_num_objects()));
+        return compute_denotations(states, caches, [&](size_t i, ConceptDenotation& denotation) {
             compute_result(
                 *(*role_left_denotations)[i],
                 *(*role_right_denotations)[i],
-                *denotation);
-            // register denotation and append it to denotations.
-            denotations->push_back(caches.m_c_denot_cache.insert(std::move(denotation)).first->get());
-        }
-        return denotations;
+                denotation);
+        });
     }
 
 protected:
@@ -66,6 +59,17 @@ public:
         return denotation;
     }
 
+    Operands compile(ProgramCompiler& compiler) const override {
+        return {compiler.compile(*m_role_left), compiler.compile(*m_role_right), -1};
+    }
+
+    void execute(const State&, const Registers& registers, const Operands& operands, ConceptDenotation& result) const override {
+        compute_result(
+            registers.roles[operands[0]],
+            registers.roles[operands[1]],
+            result);
+    }
+
     int compute_complexity() const override {
         return m_role_left->compute_complexity() + m_role_right->compute_complexity() + 1;
     }
@@ -4,7 +4,9 @@
 #include <iostream>
 #include <sstream>
 #include <mutex>
+#include <atomic>
 #include <cassert>
+#include <cstdint>
 #include <memory>
 
 #include "types.h"
@@ -17,6 +19,15 @@ using namespace std::string_literals;
 
 namespace dlplan::core::element {
 
+/**
+ * Returns an id that is unique among all elements of the process,
+ * independent of the factory that constructed them.
+ */
+inline std::int64_t make_element_id() {
+    static std::atomic<std::int64_t> counter(0);
+    return counter.fetch_add(1, std::memory_order_relaxed);
+}
+
 template<typename T>
 class Element : public utils::Cachable {
 protected:
@@ -25,9 +36,25 @@ protected:
      */
     int m_index;
 
+    /**
+     * Identifies the element in the keys of its parents and orders commutative children.
+     */
+    const std::int64_t m_id;
+
+    /**
+     * The repr is computed on the first request only.
+     */
+    mutable std::once_flag m_repr_flag;
+    mutable std::string m_repr;
+
 public:
+    /**
+     * Whether the first two children can be swapped without changing the element.
+     */
+    static constexpr bool is_commutative = false;
+
     // Elements are not copieable because they must live in the cache.
-    explicit Element(const VocabularyInfo&) : m_index(-1) { }
+    explicit Element(const VocabularyInfo&) : m_index(-1), m_id(make_element_id()) { }
     Element(const Element& other) = delete;
     Element& operator=(const Element& other) = delete;
     Element(Element&& other) = delete;
@@ -42,15 +69,22 @@ public:
         m_index = index;
     }
 
-    virtual std::string compute_repr() const {
-        std::stringstream ss;
-        compute_repr(ss);
-        return ss.str();
+    std::string compute_repr() const override {
+        std::call_once(m_repr_flag, [this]() {
+            std::stringstream ss;
+            compute_repr(ss);
+            m_repr = ss.str();
+        });
+        return m_repr;
     }
 
     int get_index() const {
         return m_index;
     }
+
+    std::int64_t get_id() const {
+        return m_id;
+    }
 };
 
 
@@ -0,0 +1,66 @@
+#ifndef DLPLAN_SRC_CORE_ELEMENTS_INSTRUMENTATION_H_
+#define DLPLAN_SRC_CORE_ELEMENTS_INSTRUMENTATION_H_
+
+#include <chrono>
+
+#include "../../../include/dlplan/core.h"
+
+
+namespace dlplan::core::element {
+
+#ifdef DLPLAN_INSTRUMENTATION
+/**
+ * Records one cached evaluation of an element in the EvaluationStatistics of the caches.
+ */
+class EvaluationRecorder {
+private:
+    DenotationsCaches& m_caches;
+    EvaluationStatistics& m_statistics;
+    std::chrono::steady_clock::time_point m_start;
+    std::size_t m_num_bytes;
+
+public:
+    EvaluationRecorder(DenotationsCaches& caches, EvaluationStatisticsTable::ElementType type, const utils::Cachable& element, int element_idx)
+        : m_caches(caches),
+          m_statistics(caches.m_statistics.get(type, element_idx, [&](){ return element.compute_repr(); })),
+          m_num_bytes(0) {
+        m_statistics.num_calls.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void record_hit() {
+        m_statistics.num_hits.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void begin_miss() {
+        m_num_bytes = m_caches.compute_num_bytes();
+        m_start = std::chrono::steady_clock::now();
+    }
+
+    void end_miss() {
+        auto end = std::chrono::steady_clock::now();
+        m_statistics.num_misses.fetch_add(1, std::memory_order_relaxed);
+        m_statistics.num_nanoseconds.fetch_add(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(end - m_start).count(), std::memory_order_relaxed);
+        // Eviction cannot run during an evaluation, hence the caches only grew.
+        m_statistics.num_bytes.fetch_add(m_caches.compute_num_bytes() - m_num_bytes, std::memory_order_relaxed);
+    }
+};
+#else
+/**
+ * Does nothing such that evaluation pays nothing without DLPLAN_INSTRUMENTATION.
+ */
+class EvaluationRecorder {
+public:
+    EvaluationRecorder(DenotationsCaches&, EvaluationStatisticsTable::ElementType, const utils::Cachable&, int) { }
+
+    void record_hit() { }
+
+    void begin_miss() { }
+
+    void end_miss() { }
+};
+#endif
+
+}
+
+#endif
@@ -2,6 +2,8 @@
 #define DLPLAN_SRC_CORE_ELEMENTS_NUMERICAL_H_
 
 #include "element.h"
+#include "instrumentation.h"
+#include "program.h"
 
 
 namespace dlplan::core::element {
@@ -11,6 +13,21 @@ protected:
     virtual int evaluate_impl(const State& state, DenotationsCaches& caches) const = 0;
     virtual std::unique_ptr<NumericalDenotations> evaluate_impl(const States& states, DenotationsCaches& caches) const = 0;
 
+    /**
+     * Computes the denotation in each state with compute(state_idx).
+     * Chunks of states are computed in parallel if the caches use several threads.
+     */
+    template<typename Compute>
+    std::unique_ptr<NumericalDenotations> compute_denotations(const States& states, DenotationsCaches& caches, Compute compute) const {
+        auto denotations = std::make_unique<NumericalDenotations>(states.size());
+        caches.for_each_chunk(states.size(), [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                (*denotations)[i] = compute(i);
+            }
+        });
+        return denotations;
+    }
+
 public:
     explicit Numerical(const VocabularyInfo& vocabulary) : Element<int>(vocabulary) { }
     ~Numerical() override = default;
@@ -20,18 +37,34 @@ public:
      */
     virtual int evaluate(const State& state) const = 0;
 
+    /**
+     * Compiles the children into the program and returns their registers.
+     */
+    virtual Operands compile(ProgramCompiler& compiler) const = 0;
+
+    /**
+     * Evaluate for a single state with the denotations of the children taken from the registers.
+     */
+    virtual int execute(const State& state, const Registers& registers, const Operands& operands) const = 0;
+
     /**
      * Evaluate with caching for a single state.
      */
     int evaluate(const State& state, DenotationsCaches& caches) const {
+        EvaluationRecorder recorder(caches, EvaluationStatisticsTable::ElementType::NUMERICAL, *this, get_index());
         // check if denotations is cached.
-        auto key = std::array<int, 3>({state.get_instance_info_ref().get_index(), state.get_index(), get_index()});
-        auto cached = caches.m_n_denots_mapping_per_state.find(key);
-        if (cached != caches.m_n_denots_mapping_per_state.end()) return cached->second;
+        int instance_idx = state.get_instance_info_ref().get_index();
+        auto cached = caches.m_n_denots_mapping_per_state.find(instance_idx, state.get_index(), get_index());
+        if (cached != caches.m_n_denots_mapping_per_state.not_computed) {
+            recorder.record_hit();
+            return cached;
+        }
         // compute denotation
+        recorder.begin_miss();
         auto denotation = evaluate_impl(state, caches);
         // register denotation and return it
-        caches.m_n_denots_mapping_per_state.emplace(key, denotation);
+        caches.m_n_denots_mapping_per_state.insert(instance_idx, state.get_index(), get_index(), denotation);
+        recorder.end_miss();
         return denotation;
     }
 
@@ -39,14 +72,20 @@ public:
      * Evaluate with caching for a collection of states.
      */
     NumericalDenotations* evaluate(const States& states, DenotationsCaches& caches) const {
+        EvaluationRecorder recorder(caches, EvaluationStatisticsTable::ElementType::NUMERICAL, *this, get_index());
         // check if denotations is cached.
         auto cached = caches.m_n_denots_mapping.find(get_index());
-        if (cached != caches.m_n_denots_mapping.end()) return cached->second;
+        if (cached != caches.m_n_denots_mapping.not_computed) {
+            recorder.record_hit();
+            return cached;
+        }
         // compute denotations
+        recorder.begin_miss();
         auto denotations = evaluate_impl(states, caches);
         // register denotations and return it.
-        auto result_denotations = caches.m_n_denots_cache.insert(std::move(denotations)).first->get();
-        caches.m_n_denots_mapping.emplace(get_index(), result_denotations);
+        auto result_denotations = caches.m_n_denots_cache.insert(std::move(*denotations)).first;
+        caches.m_n_denots_mapping.insert(get_index(), result_denotations);
+        recorder.end_miss();
         return result_denotations;
     }
 };
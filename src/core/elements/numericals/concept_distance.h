@@ -37,19 +37,15 @@ private:
     }
 
     std::unique_ptr<NumericalDenotations> evaluate_impl(const States& states, DenotationsCaches& caches) const override {
-        auto denotations = std::make_unique<NumericalDenotations>();
-        denotations->reserve(states.size());
         auto concept_from_denots = m_concept_from->evaluate(states, caches);
         auto role_denots = m_role->evaluate(states, caches);
         auto concept_to_denots = m_concept_to->evaluate(states, caches);
-        for (size_t i = 0; i < states.size(); ++i) {
+        return compute_denotations(states, caches, [&](size_t i) {
             if ((*concept_from_denots)[i]->empty()) {
-                denotations->push_back(INF);
-                continue;
+                return INF;
             }
             if ((*concept_to_denots)[i]->empty()) {
-                denotations->push_back(INF);
-                continue;
+                return INF;
             }
             int denotation;
             compute_result(
@@ -57,9 +53,8 @@ private:
                 *(*role_denots)[i],
                 *(*concept_to_denots)[i],
                 denotation);
-            denotations->push_back(denotation);
-        }
-        return denotations;
+            return denotation;
+        });
     }
 
 protected:
@@ -93,6 +88,27 @@ public:
         return denotation;
     }
 
+    Operands compile(ProgramCompiler& compiler) const override {
+        return {compiler.compile(*m_concept_from), compiler.compile(*m_role), compiler.compile(*m_concept_to)};
+    }
+
+    int execute(const State&, const Registers& registers, const Operands& operands) const override {
+        const auto& concept_from_denot = registers.concepts[operands[0]];
+        if (concept_from_denot.empty()) {
+            return INF;
+        }
+        const auto& concept_to_denot = registers.concepts[operands[2]];
+        if (concept_to_denot.empty()) {
+            return INF;
+        }
+        if (concept_from_denot.intersects(concept_to_denot)) {
+            return 0;
+        }
+        int denotation;
+        compute_result(concept_from_denot, registers.roles[operands[1]], concept_to_denot, denotation);
+        return denotation;
+    }
+
     int compute_complexity() const override {
         return m_concept_from->compute_complexity() + m_role->compute_complexity() + m_concept_to->compute_complexity() + 1;
     }
@@ -23,17 +23,14 @@ private:
     }
 
     std::unique_ptr<NumericalDenotations> evaluate_impl(const States& states, DenotationsCaches& caches) const override {
-        auto denotations = std::make_unique<NumericalDenotations>();
-        denotations->reserve(states.size());
         auto element_denotations = m_element->evaluate(states, caches);
-        for (size_t i = 0; i < states.size(); ++i) {
+        return compute_denotations(states, caches, [&](size_t i) {
             int denotation;
             compute_result(
                 *(*element_denotations)[i],
                 denotation);
-            denotations->push_back(denotation);
-        }
-        return denotations;
+            return denotation;
+        });
     }
 
 protected:
@@ -51,6 +48,16 @@ public:
         return result;
     }
 
+    Operands compile(ProgramCompiler& compiler) const override {
+        return {compiler.compile(*m_element), -1, -1};
+    }
+
+    int execute(const State&, const Registers& registers, const Operands& operands) const override {
+        int denotation;
+        compute_result(registers.get(*m_element, operands[0]), denotation);
+        return denotation;
+    }
+
     int compute_complexity() const override {
         return m_element->compute_complexity() + 1;
     }
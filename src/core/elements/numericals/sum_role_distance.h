@@ -12,22 +12,7 @@ namespace dlplan::core::element {
 class SumRoleDistanceNumerical : public Numerical {
 private:
     void compute_result(const RoleDenotation& role_from_denot, const RoleDenotation& role_denot, const RoleDenotation& role_to_denot, int& result) const {
-        utils::PairwiseDistances pairwise_distances = utils::compute_floyd_warshall(role_denot);
-        result = 0;
-        int num_objects = role_denot.get_num_objects();
-        for (int k = 0; k < num_objects; ++k) {  // property
-            for (int i = 0; i < num_objects; ++i) {  // source
-                if (role_from_denot.contains(std::make_pair(k, i))) {
-                    int min_distance = INF;
-                    for (int j = 0; j < num_objects; ++j) {  // target
-                        if (role_to_denot.contains(std::make_pair(k, j))) {
-                            min_distance = std::min<int>(min_distance, pairwise_distances[i][j]);
-                        }
-                    }
-                    result = utils::path_addition(result, min_distance);
-                }
-            }
-        }
+        result = utils::compute_sum_role_distance(role_from_denot, role_denot, role_to_denot);
     }
 
     int evaluate_impl(const State& state, DenotationsCaches& caches) const override {
@@ -46,19 +31,15 @@ private:
     }
 
     std::unique_ptr<NumericalDenotations> evaluate_impl(const States& states, DenotationsCaches& caches) const override {
-        auto denotations = std::make_unique<NumericalDenotations>();
-        denotations->reserve(states.size());
         auto role_from_denots = m_role_from->evaluate(states, caches);
         auto role_denots = m_role->evaluate(states, caches);
         auto role_to_denots = m_role_to->evaluate(states, caches);
-        for (size_t i = 0; i < states.size(); ++i) {
+        return compute_denotations(states, caches, [&](size_t i) {
             if ((*role_from_denots)[i]->empty()) {
-                denotations->push_back(INF);
-                continue;
+                return INF;
             }
             if ((*role_to_denots)[i]->empty()) {
-                denotations->push_back(INF);
-                continue;
+                return INF;
             }
             int denotation;
             compute_result(
@@ -66,9 +47,8 @@ private:
                 *(*role_denots)[i],
                 *(*role_to_denots)[i],
                 denotation);
-            denotations->push_back(denotation);
-        }
-        return denotations;
+            return denotation;
+        });
     }
 
 protected:
@@ -99,6 +79,24 @@ public:
         return denotation;
     }
 
+    Operands compile(ProgramCompiler& compiler) const override {
+        return {compiler.compile(*m_role_from), compiler.compile(*m_role), compiler.compile(*m_role_to)};
+    }
+
+    int execute(const State&, const Registers& registers, const Operands& operands) const override {
+        const auto& role_from_denot = registers.roles[operands[0]];
+        if (role_from_denot.empty()) {
+            return INF;
+        }
+        const auto& role_to_denot = registers.roles[operands[2]];
+        if (role_to_denot.empty()) {
+            return INF;
+        }
+        int denotation;
+        compute_result(role_from_denot, registers.roles[operands[1]], role_to_denot, denotation);
+        return denotation;
+    }
+
     int compute_complexity() const override {
         return m_role_from->compute_complexity() + m_role->compute_complexity() + m_role_to->compute_complexity() + 1;
     }
@@ -0,0 +1,99 @@
+#ifndef DLPLAN_SRC_CORE_ELEMENTS_PROGRAM_H_
+#define DLPLAN_SRC_CORE_ELEMENTS_PROGRAM_H_
+
+#include <array>
+#include <memory>
+#include <vector>
+
+#include "../../../include/dlplan/core.h"
+#include "../../../include/dlplan/phmap/phmap.h"
+
+
+namespace dlplan::core::element {
+class Concept;
+class Role;
+class Numerical;
+class Boolean;
+
+/**
+ * Registers of the children of an element in the order of its members.
+ * Unused operands are -1.
+ */
+using Operands = std::array<int, 3>;
+
+/**
+ * Denotations computed by a FeatureProgram, one register per element.
+ */
+struct Registers {
+    std::vector<ConceptDenotation> concepts;
+    std::vector<RoleDenotation> roles;
+    std::vector<int> numericals;
+    // char instead of bool because std::vector<bool> has no addressable elements.
+    std::vector<char> booleans;
+
+    const ConceptDenotation& get(const Concept&, int reg) const {
+        return concepts[reg];
+    }
+
+    const RoleDenotation& get(const Role&, int reg) const {
+        return roles[reg];
+    }
+};
+
+/**
+ * Evaluates one element from the registers of its children
+ * and writes the result into its own register.
+ */
+struct Instruction {
+    enum class Type { CONCEPT, ROLE, NUMERICAL, BOOLEAN };
+
+    Type type;
+    const void* element;
+    int result;
+    Operands operands;
+    // Predicate of the state atoms that the element reads or -1.
+    int predicate_idx;
+    // Instructions that compute the children.
+    std::vector<int> dependencies;
+};
+
+/**
+ * Compiles elements into a list of instructions.
+ * Each element is compiled once and after its children,
+ * such that executing the instructions in order evaluates all elements.
+ */
+class ProgramCompiler {
+private:
+    std::vector<Instruction> m_instructions;
+    // Registers and instructions of compiled elements, separately per type.
+    std::array<phmap::flat_hash_map<const void*, std::pair<int, int>>, 4> m_registers;
+    // Instructions of the children of the element that is being compiled.
+    std::vector<int> m_dependencies;
+    int m_predicate_idx;
+
+    template<typename T>
+    int compile(const T& element, Instruction::Type type);
+
+public:
+    ProgramCompiler();
+
+    /**
+     * Returns the register that holds the denotation of the element.
+     */
+    int compile(const Concept& concept);
+    int compile(const Role& role);
+    int compile(const Numerical& numerical);
+    int compile(const Boolean& boolean);
+
+    /**
+     * Called by elements that read the atoms of a predicate from the state.
+     */
+    void read_predicate(const Predicate& predicate);
+
+    const std::vector<Instruction>& get_instructions_ref() const;
+    int get_num_registers(Instruction::Type type) const;
+};
+
+}
+
+#endif
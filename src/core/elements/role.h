@@ -2,6 +2,8 @@
 #define DLPLAN_SRC_CORE_ELEMENTS_ROLE_H_
 
 #include "element.h"
+#include "instrumentation.h"
+#include "program.h"
 
 
 namespace dlplan::core::element {
@@ -11,6 +13,50 @@ protected:
     virtual std::unique_ptr<RoleDenotation> evaluate_impl(const State& state, DenotationsCaches& caches) const = 0;
     virtual std::unique_ptr<RoleDenotations> evaluate_impl(const States& states, DenotationsCaches& caches) const = 0;
 
+    /**
+     * Computes the denotation in each state with compute(state_idx, denotation),
+     * where the denotation is empty initially, and interns them in the order of the states.
+     * Chunks of states are computed in parallel if the caches use several threads.
+     */
+    template<typename Compute>
+    std::unique_ptr<RoleDenotations> compute_denotations(const States& states, DenotationsCaches& caches, Compute compute) const {
+        auto denotations = std::make_unique<RoleDenotations>();
+        denotations->reserve(states.size());
+        if (caches.get_num_threads() == 1) {
+            for (size_t i = 0; i < states.size(); ++i) {
+                RoleDenotation denotation(states[i].get_instance_info_ref().get_num_objects());
+                compute(i, denotation);
+                denotations->push_back(caches.m_r_denot_cache.insert(std::move(denotation)).first);
+            }
+            return denotations;
+        }
+        std::vector<RoleDenotation> buffer;
+        buffer.reserve(states.size());
+        for (const auto& state : states) {
+            buffer.emplace_back(state.get_instance_info_ref().get_num_objects());
+        }
+        caches.for_each_chunk(states.size(), [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                compute(i, buffer[i]);
+            }
+        });
+        // Interning in the order of the states keeps the caches independent of the scheduling.
+        for (auto& denotation : buffer) {
+            denotations->push_back(caches.m_r_denot_cache.insert(std::move(denotation)).first);
+        }
+        return denotations;
+    }
+
+    /**
+     * Evaluate for a collection of states of one instance in bit-sliced layout.
+     * Transposes the denotations of the collection unless overridden
+     * by elements that combine the bit-sliced denotations of their children blockwise.
+     */
+    virtual std::unique_ptr<BitSlicedDenotations> evaluate_sliced_impl(const States& states, DenotationsCaches& caches) const {
+        int num_objects = states.empty() ? 0 : states.front().get_instance_info_ref().get_num_objects();
+        return std::make_unique<BitSlicedDenotations>(*evaluate(states, caches), num_objects);
+    }
+
 public:
     explicit Role(const VocabularyInfo& vocabulary) : Element<RoleDenotation>(vocabulary) { }
     ~Role() override = default;
@@ -20,19 +66,35 @@ public:
      */
     virtual RoleDenotation evaluate(const State& state) const = 0;
 
+    /**
+     * Compiles the children into the program and returns their registers.
+     */
+    virtual Operands compile(ProgramCompiler& compiler) const = 0;
+
+    /**
+     * Evaluate for a single state with the denotations of the children taken from the registers.
+     * The result is empty initially.
+     */
+    virtual void execute(const State& state, const Registers& registers, const Operands& operands, RoleDenotation& result) const = 0;
+
     /**
      * Evaluate with caching for a single state.
      */
     RoleDenotation* evaluate(const State& state, DenotationsCaches& caches) const {
+        EvaluationRecorder recorder(caches, EvaluationStatisticsTable::ElementType::ROLE, *this, get_index());
         // check if denotations is cached.
-        std::array<int, 3> key({state.get_instance_info_ref().get_index(), state.get_index(), get_index()});
-        auto cached = caches.m_r_denots_mapping_per_state.find(key);
-        if (cached != caches.m_r_denots_mapping_per_state.end()) return cached->second;
+        int instance_idx = state.get_instance_info_ref().get_index();
+        auto cached = caches.m_r_denots_mapping_per_state.find(instance_idx, state.get_index(), get_index());
+        if (cached != caches.m_r_denots_mapping_per_state.not_computed) {
+            recorder.record_hit();
+            return cached;
+        }
         // compute denotation
+        recorder.begin_miss();
         auto denotation = evaluate_impl(state, caches);
-        // register denotation and append it to denotations.
-        auto result_denotation = caches.m_r_denot_cache.insert(std::move(denotation)).first->get();
-        caches.m_r_denots_mapping_per_state.emplace(key, result_denotation);
+        // register denotation and return it.
+        auto result_denotation = caches.insert(instance_idx, state.get_index(), get_index(), std::move(denotation));
+        recorder.end_miss();
         return result_denotation;
     }
 
@@ -40,14 +102,41 @@ public:
      * Evaluate with caching for a collection of states.
      */
     RoleDenotations* evaluate(const States& states, DenotationsCaches& caches) const {
+        EvaluationRecorder recorder(caches, EvaluationStatisticsTable::ElementType::ROLE, *this, get_index());
         // check if denotations is cached.
         auto cached = caches.m_r_denots_mapping.find(get_index());
-        if (cached != caches.m_r_denots_mapping.end()) return cached->second;
+        if (cached != caches.m_r_denots_mapping.not_computed) {
+            recorder.record_hit();
+            return cached;
+        }
         // compute denotations
+        recorder.begin_miss();
         auto denotations = evaluate_impl(states, caches);
         // register denotations and return it.
-        auto result_denotations = caches.m_r_denots_cache.insert(std::move(denotations)).first->get();
-        caches.m_r_denots_mapping.emplace(get_index(), result_denotations);
+        auto result_denotations = caches.m_r_denots_cache.insert(std::move(*denotations)).first;
+        caches.m_r_denots_mapping.insert(get_index(), result_denotations);
+        recorder.end_miss();
+        return result_denotations;
+    }
+
+    /**
+     * Evaluate with caching for a collection of states of one instance in bit-sliced layout.
+     */
+    BitSlicedDenotations* evaluate_sliced(const States& states, DenotationsCaches& caches) const {
+        EvaluationRecorder recorder(caches, EvaluationStatisticsTable::ElementType::ROLE, *this, get_index());
+        // check if denotations is cached.
+        auto cached = caches.m_r_sliced_denots_mapping.find(get_index());
+        if (cached != caches.m_r_sliced_denots_mapping.not_computed) {
+            recorder.record_hit();
+            return cached;
+        }
+        // compute denotations
+        recorder.begin_miss();
+        auto denotations = evaluate_sliced_impl(states, caches);
+        // register denotations and return it.
+        auto result_denotations = caches.m_sliced_denots_cache.insert(std::move(*denotations)).first;
+        caches.m_r_sliced_denots_mapping.insert(get_index(), result_denotations);
+        recorder.end_miss();
         return result_denotations;
     }
 };
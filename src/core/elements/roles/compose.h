@@ -9,19 +9,8 @@ namespace dlplan::core::element {
 
 class ComposeRole : public Role {
 private:
-    void compute_result(const RoleDenotation& left_denot, const RoleDenotation& right_denot, int num_objects, RoleDenotation& result) const {
-        const auto left_bitset = element::utils::role_denot_to_bitset(left_denot);
-        const auto right_bitset = element::utils::role_denot_to_bitset(right_denot);
-        for (int i = 0; i < num_objects; ++i) {  // source
-            for (int j = 0; j < num_objects; ++j) {  // target
-                for (int k = 0; k < num_objects; ++k) {  // middle
-                    if (left_bitset.test(i * num_objects + k) && right_bitset.test(k * num_objects + j)) {
-                        result.insert(std::make_pair(i, j));
-                        break;
-                    }
-                }
-            }
-        }
+    void compute_result(const RoleDenotation& left_denot, const RoleDenotation& right_denot, RoleDenotation& result) const {
+        utils::compute_role_composition(left_denot, right_denot, result);
     }
 
     std::unique_ptr<RoleDenotation> evaluate_impl(const State& state, DenotationsCaches& caches) const override {
@@ -30,27 +19,19 @@ private:
         compute_result(
             *m_role_left->evaluate(state, caches),
             *m_role_right->evaluate(state, caches),
-            state.get_instance_info_ref().get_num_objects(),
             *denotation);
         return denotation;
     }
 
     std::unique_ptr<RoleDenotations> evaluate_impl(const States& states, DenotationsCaches& caches) const override {
-        auto denotations = std::make_unique<RoleDenotations>();
-        denotations->reserve(states.size());
         auto role_left_denotations = m_role_left->evaluate(states, caches);
         auto role_right_denotations = m_role_right->evaluate(states, caches);
-        for (size_t i = 0; i < states.size(); ++i) {
-            auto denotation = std::make_unique<RoleDenotation>(
-                RoleDenotation(states[i].get_instance_info_ref().get_num_objects()));
+        return compute_denotations(states, caches, [&](size_t i, RoleDenotation& denotation) {
             compute_result(
                 *(*role_left_denotations)[i],
                 *(*role_right_denotations)[i],
-                states[i].get_instance_info_ref().get_num_objects(),
-                *denotation);
-            denotations->push_back(caches.m_r_denot_cache.insert(std::move(denotation)).first->get());
-        }
-        return denotations;
+                denotation);
+        });
     }
 
 protected:
@@ -71,11 +52,21 @@ public:
         compute_result(
             m_role_left->evaluate(state),
             m_role_right->evaluate(state),
-            num_objects,
             denotation);
         return denotation;
     }
 
+    Operands compile(ProgramCompiler& compiler) const override {
+        return {compiler.compile(*m_role_left), compiler.compile(*m_role_right), -1};
+    }
+
+    void execute(const State&, const Registers& registers, const Operands& operands, RoleDenotation& result) const override {
+        compute_result(
+            registers.roles[operands[0]],
+            registers.roles[operands[1]],
+            result);
+    }
+
     int compute_complexity() const override {
         return m_role_left->compute_complexity() + m_role_right->compute_complexity() + 1;
     }
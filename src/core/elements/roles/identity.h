@@ -25,18 +25,12 @@ private:
     }
 
     std::unique_ptr<RoleDenotations> evaluate_impl(const States& states, DenotationsCaches& caches) const override {
-        auto denotations = std::make_unique<RoleDenotations>();
-        denotations->reserve(states.size());
         auto concept_denotations = m_concept->evaluate(states, caches);
-        for (size_t i = 0; i < states.size(); ++i) {
-            auto denotation = std::make_unique<RoleDenotation>(
-                RoleDenotation(states[i].get_instance_info_ref().get_num_objects()));
+        return compute_denotations(states, caches, [&](size_t i, RoleDenotation& denotation) {
             compute_result(
                 *(*concept_denotations)[i],
-                *denotation);
-            denotations->push_back(caches.m_r_denot_cache.insert(std::move(denotation)).first->get());
-        }
-       return denotations;
+                denotation);
+        });
     }
 
 protected:
@@ -58,6 +52,16 @@ public:
         return denotation;
     }
 
+    Operands compile(ProgramCompiler& compiler) const override {
+        return {compiler.compile(*m_concept), -1, -1};
+    }
+
+    void execute(const State&, const Registers& registers, const Operands& operands, RoleDenotation& result) const override {
+        compute_result(
+            registers.concepts[operands[0]],
+            result);
+    }
+
     int compute_complexity() const override {
         return m_concept->compute_complexity() + 1;
     }
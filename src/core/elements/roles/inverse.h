@@ -9,9 +9,11 @@ namespace dlplan::core::element {
 class InverseRole : public Role {
 private:
     void compute_result(const RoleDenotation& denot, RoleDenotation& result) const {
-        for (const auto& pair : denot) {
-            result.insert(std::make_pair(pair.second, pair.first));
-        }
+        result.insert_unsorted([&](auto insert) {
+            denot.for_each([&](int first, int second) {
+                insert(second, first);
+            });
+        });
     }
 
     std::unique_ptr<RoleDenotation> evaluate_impl(const State& state, DenotationsCaches& caches) const override {
@@ -24,18 +26,27 @@ private:
     }
 
     std::unique_ptr<RoleDenotations> evaluate_impl(const States& states, DenotationsCaches& caches) const override {
-        auto denotations = std::make_unique<RoleDenotations>();
-        denotations->reserve(states.size());
         auto role_denotations = m_role->evaluate(states, caches);
-        for (size_t i = 0; i < states.size(); ++i) {
-            auto denotation = std::make_unique<RoleDenotation>(
-                RoleDenotation(states[i].get_instance_info_ref().get_num_objects()));
+        return compute_denotations(states, caches, [&](size_t i, RoleDenotation& denotation) {
             compute_result(
                 *(*role_denotations)[i],
-                *denotation);
-            denotations->push_back(caches.m_r_denot_cache.insert(std::move(denotation)).first->get());
+                denotation);
+        });
+    }
+
+    std::unique_ptr<BitSlicedDenotations> evaluate_sliced_impl(const States& states, DenotationsCaches& caches) const override {
+        const auto& role_denotations = *m_role->evaluate_sliced(states, caches);
+        int num_objects = role_denotations.get_num_objects();
+        int num_blocks = role_denotations.get_num_blocks_per_position();
+        auto denotations = std::make_unique<BitSlicedDenotations>(num_objects, num_objects * num_objects, role_denotations.get_num_states());
+        // The slice of pair (i,j) is the slice of pair (j,i) of the child.
+        for (int i = 0; i < num_objects; ++i) {
+            for (int j = 0; j < num_objects; ++j) {
+                const std::uint64_t* slice = role_denotations.get_slice(j * num_objects + i);
+                std::copy(slice, slice + num_blocks, denotations->get_slice(i * num_objects + j));
+            }
         }
-       return denotations;
+        return denotations;
     }
 
 protected:
@@ -57,6 +68,16 @@ public:
         return denotation;
     }
 
+    Operands compile(ProgramCompiler& compiler) const override {
+        return {compiler.compile(*m_role), -1, -1};
+    }
+
+    void execute(const State&, const Registers& registers, const Operands& operands, RoleDenotation& result) const override {
+        compute_result(
+            registers.roles[operands[0]],
+            result);
+    }
+
     int compute_complexity() const override {
         return m_role->compute_complexity() + 1;
     }
@@ -24,19 +24,19 @@ private:
     }
 
     std::unique_ptr<RoleDenotations> evaluate_impl(const States& states, DenotationsCaches& caches) const override {
-        auto denotations = std::make_unique<RoleDenotations>();
-        denotations->reserve(states.size());
         auto role_left_denotations = m_role_left->evaluate(states, caches);
         auto role_right_denotations = m_role_right->evaluate(states, caches);
-        for (size_t i = 0; i < states.size(); ++i) {
-            auto denotation = std::make_unique<RoleDenotation>(
-                RoleDenotation(states[i].get_instance_info_ref().get_num_objects()));
+        return compute_denotations(states, caches, [&](size_t i, RoleDenotation& denotation) {
             compute_result(
                 *(*role_left_denotations)[i],
                 *(*role_right_denotations)[i],
-                *denotation);
-            denotations->push_back(caches.m_r_denot_cache.insert(std::move(denotation)).first->get());
-        }
+                denotation);
+        });
+    }
+
+    std::unique_ptr<BitSlicedDenotations> evaluate_sliced_impl(const States& states, DenotationsCaches& caches) const override {
+        auto denotations = std::make_unique<BitSlicedDenotations>(*m_role_left->evaluate_sliced(states, caches));
+        *denotations |= *m_role_right->evaluate_sliced(states, caches);
         return denotations;
     }
 
@@ -45,6 +45,8 @@ protected:
     Role_Ptr m_role_right;
 
 public:
+    static constexpr bool is_commutative = true;
+
     OrRole(const VocabularyInfo& vocabulary, Role_Ptr role_1, Role_Ptr role_2)
     : Role(vocabulary),
       m_role_left(role_1),
@@ -52,11 +54,7 @@ public:
         if (!(role_1 && role_2)) {
             throw std::runtime_error("OrRole::OrRole - at least one child is a nullptr.");
         }
-        std::stringstream ss1;
-        m_role_left->compute_repr(ss1);
-        std::stringstream ss2;
-        m_role_right->compute_repr(ss2);
-        if (ss1.str() > ss2.str()) swap(m_role_left, m_role_right);
+        if (m_role_left->get_id() > m_role_right->get_id()) swap(m_role_left, m_role_right);
     }
 
     RoleDenotation evaluate(const State& state) const override {
@@ -68,6 +66,17 @@ public:
         return denotation;
     }
 
+    Operands compile(ProgramCompiler& compiler) const override {
+        return {compiler.compile(*m_role_left), compiler.compile(*m_role_right), -1};
+    }
+
+    void execute(const State&, const Registers& registers, const Operands& operands, RoleDenotation& result) const override {
+        compute_result(
+            registers.roles[operands[0]],
+            registers.roles[operands[1]],
+            result);
+    }
+
     int compute_complexity() const override {
         return m_role_left->compute_complexity() + m_role_right->compute_complexity() + 1;
     }
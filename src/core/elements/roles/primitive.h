@@ -2,6 +2,7 @@
 #define DLPLAN_SRC_CORE_ELEMENTS_ROLES_PRIMITIVE_H_
 
 #include "../role.h"
+#include "../../atom_index.h"
 
 
 namespace dlplan::core::element {
@@ -9,22 +10,14 @@ namespace dlplan::core::element {
 class PrimitiveRole : public Role {
 private:
     void compute_result(const State& state, RoleDenotation& result) const {
-        const auto& instance_info = state.get_instance_info_ref();
-        const auto& atoms = instance_info.get_atoms_ref();
-        for (int atom_idx : state.get_atom_idxs_ref()) {
-            const auto& atom = atoms[atom_idx];
-            if (atom.get_predicate_ref().get_index() == m_predicate.get_index()) {
-                result.insert(std::make_pair(atom.get_object_ref(m_pos_1).get_index(), atom.get_object_ref(m_pos_2).get_index()));
-            }
-        }
-        const auto& static_atoms = instance_info.get_static_atoms_ref();
-        const auto& per_predicate_idx_static_atom_idxs = instance_info.get_per_predicate_idx_static_atom_idxs_ref();
-        auto it = per_predicate_idx_static_atom_idxs.find(m_predicate.get_index());
-        if (it != per_predicate_idx_static_atom_idxs.end()) {
-            for (int atom_idx : it->second) {
-                const auto& atom = static_atoms[atom_idx];
-                result.insert(std::make_pair(atom.get_object_ref(m_pos_1).get_index(), atom.get_object_ref(m_pos_2).get_index()));
-            }
+        result.insert_unsorted([&](auto insert) {
+            state.get_atom_index_ref().for_each_atom(m_predicate, [&](const int* object_idxs) {
+                insert(object_idxs[m_pos_1], object_idxs[m_pos_2]);
+            });
+        });
+        const auto* static_mask = state.get_instance_info_ref().get_static_atom_masks_ref().get_role_mask(m_predicate, m_pos_1, m_pos_2);
+        if (static_mask) {
+            result |= *static_mask;
         }
     }
 
@@ -38,17 +31,11 @@ private:
     }
 
     std::unique_ptr<RoleDenotations> evaluate_impl(const States& states, DenotationsCaches& caches) const override {
-        auto denotations = std::make_unique<RoleDenotations>();
-        denotations->reserve(states.size());
-        for (size_t i = 0; i < states.size(); ++i) {
-            auto denotation = std::make_unique<RoleDenotation>(
-                RoleDenotation(states[i].get_instance_info_ref().get_num_objects()));
+        return compute_denotations(states, caches, [&](size_t i, RoleDenotation& denotation) {
             compute_result(
                 states[i],
-                *denotation);
-            denotations->push_back(caches.m_r_denot_cache.insert(std::move(denotation)).first->get());
-        }
-        return denotations;
+                denotation);
+        });
     }
 
 protected:
@@ -73,6 +60,15 @@ public:
         return denotation;
     }
 
+    Operands compile(ProgramCompiler& compiler) const override {
+        compiler.read_predicate(m_predicate);
+        return {-1, -1, -1};
+    }
+
+    void execute(const State& state, const Registers&, const Operands&, RoleDenotation& result) const override {
+        compute_result(state, result);
+    }
+
     int compute_complexity() const override {
         return 1;
     }
@@ -10,18 +10,8 @@ namespace dlplan::core::element {
 // https://stackoverflow.com/questions/3517524/what-is-the-best-known-transitive-closure-algorithm-for-a-directed-graph
 class TransitiveClosureRole : public Role {
 private:
-    void compute_result(const RoleDenotation& denot, int num_objects, RoleDenotation& result) const {
-        auto role_bitset = utils::role_denot_to_bitset(denot);
-        for (int k = 0; k < num_objects; ++k) {
-            for (int i = 0; i < num_objects; ++i) {
-                for (int j = 0; j < num_objects; ++j) {
-                    if (role_bitset.test(i * num_objects + k) && role_bitset.test(k * num_objects + j)) {
-                        role_bitset.set(i * num_objects + j);
-                    }
-                }
-            }
-        }
-        result = utils::bitset_to_role_denotation(role_bitset, num_objects);
+    void compute_result(const RoleDenotation& denot, RoleDenotation& result) const {
+        utils::compute_transitive_closure(denot, false, result);
     }
 
     std::unique_ptr<RoleDenotation> evaluate_impl(const State& state, DenotationsCaches& caches) const override {
@@ -29,25 +19,17 @@ private:
             RoleDenotation(state.get_instance_info_ref().get_num_objects()));
         compute_result(
             *m_role->evaluate(state, caches),
-            state.get_instance_info_ref().get_num_objects(),
             *denotation);
         return denotation;
     }
 
     std::unique_ptr<RoleDenotations> evaluate_impl(const States& states, DenotationsCaches& caches) const override {
-        auto denotations = std::make_unique<RoleDenotations>();
-        denotations->reserve(states.size());
         auto role_denotations = m_role->evaluate(states, caches);
-        for (size_t i = 0; i < states.size(); ++i) {
-            auto denotation = std::make_unique<RoleDenotation>(
-                RoleDenotation(states[i].get_instance_info_ref().get_num_objects()));
+        return compute_denotations(states, caches, [&](size_t i, RoleDenotation& denotation) {
             compute_result(
                 *(*role_denotations)[i],
-                states[i].get_instance_info_ref().get_num_objects(),
-                *denotation);
-            denotations->push_back(caches.m_r_denot_cache.insert(std::move(denotation)).first->get());
-        }
-       return denotations;
+                denotation);
+        });
     }
 
 protected:
@@ -66,11 +48,20 @@ public:
         RoleDenotation result(num_objects);
         compute_result(
             m_role->evaluate(state),
-            num_objects,
             result);
         return result;
     }
 
+    Operands compile(ProgramCompiler& compiler) const override {
+        return {compiler.compile(*m_role), -1, -1};
+    }
+
+    void execute(const State&, const Registers& registers, const Operands& operands, RoleDenotation& result) const override {
+        compute_result(
+            registers.roles[operands[0]],
+            result);
+    }
+
     int compute_complexity() const override {
         return m_role->compute_complexity() + 1;
     }
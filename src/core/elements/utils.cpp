@@ -1,5 +1,6 @@
 #include "utils.h"
 
+#include <algorithm>
 #include <deque>
 #include <iostream>
 
@@ -26,10 +27,10 @@ int path_addition(int a, int b) {
 AdjList compute_adjacency_list(const RoleDenotation& role_denot, bool forward=true) {
     int num_objects = role_denot.get_num_objects();
     AdjList adjacency_list(num_objects);
-    for (const auto& pair : role_denot) {
-        if (forward) adjacency_list[pair.first].push_back(pair.second);
-        else adjacency_list[pair.second].push_back(pair.first);
-    }
+    role_denot.for_each([&](int first, int second) {
+        if (forward) adjacency_list[first].push_back(second);
+        else adjacency_list[second].push_back(first);
+    });
     return adjacency_list;
 }
 
@@ -54,114 +55,391 @@ Distances compute_distances_from_state(const AdjList& adj_list, int source) {
 }
 
 
-int compute_multi_source_multi_target_shortest_distance(const ConceptDenotation& sources, const RoleDenotation& edges, const ConceptDenotation& targets) {
-    int num_objects = targets.get_num_objects();
-    Distances distances(num_objects, INF);
-    std::deque<int> queue;
-    for (int source : sources) {
-        distances[source] = 0;
-        queue.push_back(source);
+/**
+ * Adds the successors of node to result, which has one bit per object.
+ */
+static void add_successors(const RoleDenotation& edges, std::size_t node, dlplan::utils::DynamicBitset<std::uint64_t>& result) {
+    const std::size_t num_objects = edges.get_num_objects();
+    const std::size_t row_begin = node * num_objects;
+    const auto& edges_data = edges.get_bitset_ref();
+    if (edges_data.is_dense()) {
+        result.or_range(0, edges_data.get_dense_ref(), row_begin, num_objects);
+        return;
     }
-    while (!queue.empty()) {
-        int source = queue.front();
-        queue.pop_front();
-        for (int target = 0; target < num_objects; ++target) {
-            if (edges.get_bitset_ref().test(source * num_objects + target)) {
-                int alt = distances[source] + 1;
-                if (distances[target] > alt) {
-                    if (targets.contains(target)) {
-                        return alt;
-                    }
-                    queue.push_back(target);
-                    distances[target] = alt;
-                }
-            }
+    const auto& positions = edges_data.get_sparse_ref();
+    auto it = std::lower_bound(positions.begin(), positions.end(), row_begin);
+    for (; it != positions.end() && *it < row_begin + num_objects; ++it) {
+        result.set(*it - row_begin);
+    }
+}
+
+
+int compute_multi_source_multi_target_shortest_distance(const ConceptDenotation& sources, const RoleDenotation& edges, const ConceptDenotation& targets) {
+    using Bitset = dlplan::utils::DynamicBitset<std::uint64_t>;
+    const Bitset target_set = concept_denot_to_bitset(targets);
+    Bitset visited = concept_denot_to_bitset(sources);
+    Bitset frontier = visited;
+    Bitset next(targets.get_num_objects());
+    for (int distance = 1; !frontier.none(); ++distance) {
+        next.reset();
+        frontier.for_each_set_bit([&](std::size_t node) { add_successors(edges, node, next); });
+        next -= visited;
+        if (next.intersects(target_set)) {
+            return distance;
         }
+        visited |= next;
+        std::swap(frontier, next);
     }
     return INF;
 }
 
 
 Distances compute_multi_source_multi_target_shortest_distances(const ConceptDenotation& sources, const RoleDenotation& edges, const ConceptDenotation& targets) {
+    using Bitset = dlplan::utils::DynamicBitset<std::uint64_t>;
     int num_objects = targets.get_num_objects();
     Distances distances(num_objects, INF);
-    std::deque<int> queue;
-    for (int source : sources) {
-        distances[source] = 0;
-        queue.push_back(source);
-    }
-    while (!queue.empty()) {
-        int source = queue.front();
-        queue.pop_front();
-        for (int target = 0; target < num_objects; ++target) {
-            if (edges.get_bitset_ref().test(source * num_objects + target)) {
-                int alt = distances[source] + 1;
-                if (distances[target] > alt) {
-                    queue.push_back(target);
-                    distances[target] = alt;
-                }
-            }
-        }
+    Bitset visited = concept_denot_to_bitset(sources);
+    visited.for_each_set_bit([&](std::size_t node) { distances[node] = 0; });
+    Bitset remaining_targets = concept_denot_to_bitset(targets);
+    remaining_targets -= visited;
+    Bitset frontier = visited;
+    Bitset next(num_objects);
+    for (int distance = 1; !frontier.none() && !remaining_targets.none(); ++distance) {
+        next.reset();
+        frontier.for_each_set_bit([&](std::size_t node) { add_successors(edges, node, next); });
+        next -= visited;
+        next.for_each_set_bit([&](std::size_t node) { distances[node] = distance; });
+        remaining_targets -= next;
+        visited |= next;
+        std::swap(frontier, next);
     }
     return distances;
 }
 
 
-PairwiseDistances compute_floyd_warshall(const RoleDenotation& edges) {
-    int num_objects = edges.get_num_objects();
-    AdjList adj_list = compute_adjacency_list(edges);
-    PairwiseDistances dist(num_objects, Distances(num_objects, INF));
-    // initialize edge costs
-    for (int source = 0; source < num_objects; ++source) {
-        for (int target : adj_list[source]) {
-            dist[source][target] = 1;
+namespace {
+using Bitset = dlplan::utils::DynamicBitset<std::uint64_t>;
+
+/**
+ * Buffers that are reused by all role distance computations of a thread.
+ */
+struct RoleDistanceScratch {
+    Distances distances;
+    Bitset visited = Bitset(0);
+    Bitset frontier = Bitset(0);
+    Bitset next = Bitset(0);
+    Bitset targets = Bitset(0);
+    Bitset row = Bitset(0);
+    // The objects k with (k, i) in role_from for each source i.
+    AdjList properties_by_source;
+
+    void initialize(const RoleDenotation& role_from) {
+        const std::size_t num_objects = role_from.get_num_objects();
+        if (visited.size() != num_objects) {
+            distances.resize(num_objects);
+            visited = frontier = next = targets = row = Bitset(num_objects);
+            properties_by_source.resize(num_objects);
         }
-        dist[source][source] = 0;
-    }
-    // main loop
-    for (int k = 0; k < num_objects; ++k) {
-        for (int i = 0; i < num_objects; ++i) {
-            for (int j = 0; j < num_objects; ++j) {
-                if (dist[i][j] > path_addition(dist[i][k], dist[k][j])) {
-                    dist[i][j] = path_addition(dist[i][k], dist[k][j]);
-                }
-            }
+        for (auto& properties : properties_by_source) {
+            properties.clear();
         }
+        role_from.for_each([&](int property, int source) {
+            properties_by_source[source].push_back(property);
+        });
     }
-    return dist;
+};
+
+RoleDistanceScratch& get_role_distance_scratch(const RoleDenotation& role_from) {
+    thread_local RoleDistanceScratch scratch;
+    scratch.initialize(role_from);
+    return scratch;
 }
 
+/**
+ * Writes the distances from source into scratch.distances.
+ * Stops after all scratch.targets are reached or after max_distance levels.
+ * Objects that were not reached are at INF.
+ */
+void compute_distances_from_source(const RoleDenotation& edges, int source, int max_distance, RoleDistanceScratch& scratch) {
+    std::fill(scratch.distances.begin(), scratch.distances.end(), INF);
+    scratch.distances[source] = 0;
+    scratch.visited.reset();
+    scratch.visited.set(source);
+    scratch.frontier.reset();
+    scratch.frontier.set(source);
+    scratch.targets.reset(source);
+    for (int distance = 1; distance <= max_distance && !scratch.frontier.none() && !scratch.targets.none(); ++distance) {
+        scratch.next.reset();
+        scratch.frontier.for_each_set_bit([&](std::size_t node) { add_successors(edges, node, scratch.next); });
+        scratch.next -= scratch.visited;
+        scratch.next.for_each_set_bit([&](std::size_t node) { scratch.distances[node] = distance; });
+        scratch.targets -= scratch.next;
+        scratch.visited |= scratch.next;
+        std::swap(scratch.frontier, scratch.next);
+    }
+}
+
+/**
+ * The minimum distance to an object j with (property, j) in role_to.
+ */
+int compute_distance_to_property(const RoleDenotation& role_to, int property, RoleDistanceScratch& scratch) {
+    int result = INF;
+    scratch.row.reset();
+    add_successors(role_to, property, scratch.row);
+    scratch.row.for_each_set_bit([&](std::size_t target) { result = std::min(result, scratch.distances[target]); });
+    return result;
+}
 
-dlplan::utils::DynamicBitset<unsigned> concept_denot_to_bitset(const ConceptDenotation& denot) {
-    dlplan::utils::DynamicBitset<unsigned> result(denot.get_num_objects());
-    for (const auto single : denot) {
-        result.set(single);
+/**
+ * Collects the objects j with (k, j) in role_to for all properties k of source into scratch.targets.
+ */
+void collect_targets(const RoleDenotation& role_to, int source, RoleDistanceScratch& scratch) {
+    scratch.targets.reset();
+    for (int property : scratch.properties_by_source[source]) {
+        add_successors(role_to, property, scratch.targets);
+    }
+}
+}
+
+
+int compute_role_distance(const RoleDenotation& role_from, const RoleDenotation& edges, const RoleDenotation& role_to) {
+    RoleDistanceScratch& scratch = get_role_distance_scratch(role_from);
+    int result = INF;
+    const int num_objects = role_from.get_num_objects();
+    for (int source = 0; source < num_objects && result > 0; ++source) {
+        if (scratch.properties_by_source[source].empty()) continue;
+        collect_targets(role_to, source, scratch);
+        if (scratch.targets.none()) continue;
+        // Only distances that improve the result are of interest.
+        compute_distances_from_source(edges, source, result - 1, scratch);
+        for (int property : scratch.properties_by_source[source]) {
+            result = std::min(result, compute_distance_to_property(role_to, property, scratch));
+        }
     }
     return result;
 }
 
 
-dlplan::utils::DynamicBitset<unsigned>role_denot_to_bitset(const RoleDenotation& denot) {
-    int num_objects = denot.get_num_objects();
-    dlplan::utils::DynamicBitset<unsigned> result(num_objects * num_objects);
-    for (const auto& pair : denot) {
-        result.set(pair.first * num_objects + pair.second);
+int compute_sum_role_distance(const RoleDenotation& role_from, const RoleDenotation& edges, const RoleDenotation& role_to) {
+    RoleDistanceScratch& scratch = get_role_distance_scratch(role_from);
+    int result = 0;
+    const int num_objects = role_from.get_num_objects();
+    for (int source = 0; source < num_objects && result != INF; ++source) {
+        if (scratch.properties_by_source[source].empty()) continue;
+        collect_targets(role_to, source, scratch);
+        if (scratch.targets.none()) return INF;
+        compute_distances_from_source(edges, source, INF, scratch);
+        for (int property : scratch.properties_by_source[source]) {
+            result = path_addition(result, compute_distance_to_property(role_to, property, scratch));
+        }
     }
     return result;
 }
 
-RoleDenotation bitset_to_role_denotation(dlplan::utils::DynamicBitset<unsigned> bitset, int num_objects) {
-    RoleDenotation role_denot(num_objects);
-    int offset = 0;
-    for (int i = 0; i < num_objects; ++i) {
-        for (int j = 0; j < num_objects; ++j) {
-            if (bitset.test(offset + j)) {
-                role_denot.insert(std::make_pair(i, j));
+
+void compute_role_composition(const RoleDenotation& left, const RoleDenotation& right, RoleDenotation& result) {
+    const std::size_t num_objects = left.get_num_objects();
+    if (left.empty() || right.empty()) {
+        return;
+    }
+    const auto& right_data = right.get_bitset_ref();
+    auto& result_data = result.get_bitset_ref();
+    if (right_data.is_dense()) {
+        const auto& right_bitset = right_data.get_dense_ref();
+        auto& result_bitset = result_data.to_dense();
+        left.for_each([&](int i, int k) {
+            result_bitset.or_range(i * num_objects, right_bitset, k * num_objects, num_objects);
+        });
+        result_data.normalize();
+        return;
+    }
+    // Collect each result row in a small dense accumulator and emit its positions in order.
+    using Position = RoleBitset::Position;
+    const auto& right_positions = right_data.get_sparse_ref();
+    dlplan::utils::DynamicBitset<std::uint64_t> row(num_objects);
+    std::vector<Position> positions;
+    int current_row = -1;
+    auto flush_row = [&]() {
+        if (current_row < 0) return;
+        const std::size_t offset = current_row * num_objects;
+        row.for_each_set_bit([&](std::size_t j) { positions.push_back(static_cast<Position>(offset + j)); });
+        row.reset();
+    };
+    left.for_each([&](int i, int k) {
+        if (i != current_row) {
+            flush_row();
+            current_row = i;
+        }
+        const Position row_begin = static_cast<Position>(k * num_objects);
+        auto it = std::lower_bound(right_positions.begin(), right_positions.end(), row_begin);
+        for (; it != right_positions.end() && *it < row_begin + num_objects; ++it) {
+            row.set(*it - row_begin);
+        }
+    });
+    flush_row();
+    if (result_data.none()) {
+        result_data.assign_sorted(std::move(positions));
+    } else {
+        RoleBitset product(result_data.size());
+        product.assign_sorted(std::move(positions));
+        result_data |= product;
+    }
+}
+
+
+static void compute_transitive_closure_warshall(const RoleDenotation& edges, bool reflexive, RoleDenotation& result) {
+    const std::size_t num_objects = edges.get_num_objects();
+    auto& result_data = result.get_bitset_ref();
+    result_data = edges.get_bitset_ref();
+    auto& closure = result_data.to_dense();
+    for (std::size_t k = 0; k < num_objects; ++k) {
+        for (std::size_t i = 0; i < num_objects; ++i) {
+            if (i != k && closure.test(i * num_objects + k)) {
+                closure.or_range(i * num_objects, closure, k * num_objects, num_objects);
+            }
+        }
+    }
+    if (reflexive) {
+        for (std::size_t i = 0; i < num_objects; ++i) {
+            closure.set(i * num_objects + i);
+        }
+    }
+    result_data.normalize();
+}
+
+
+/**
+ * Tarjan's algorithm without recursion.
+ * Components are numbered in reverse topological order,
+ * i.e., edges only lead to components with smaller or equal number.
+ */
+static std::vector<int> compute_strongly_connected_components(const AdjList& adj_list, int& num_components) {
+    const int num_nodes = adj_list.size();
+    std::vector<int> component(num_nodes, -1);
+    std::vector<int> index(num_nodes, -1);
+    std::vector<int> lowlink(num_nodes, 0);
+    std::vector<bool> on_stack(num_nodes, false);
+    std::vector<int> stack;
+    // Pairs of node and index of its next successor.
+    std::vector<std::pair<int, int>> call_stack;
+    int next_index = 0;
+    num_components = 0;
+    auto discover = [&](int node) {
+        index[node] = lowlink[node] = next_index++;
+        stack.push_back(node);
+        on_stack[node] = true;
+        call_stack.emplace_back(node, 0);
+    };
+    for (int root = 0; root < num_nodes; ++root) {
+        if (index[root] != -1) continue;
+        discover(root);
+        while (!call_stack.empty()) {
+            const int node = call_stack.back().first;
+            const int successor_idx = call_stack.back().second;
+            if (successor_idx < static_cast<int>(adj_list[node].size())) {
+                ++call_stack.back().second;
+                const int successor = adj_list[node][successor_idx];
+                if (index[successor] == -1) {
+                    discover(successor);
+                } else if (on_stack[successor]) {
+                    lowlink[node] = std::min(lowlink[node], index[successor]);
+                }
+                continue;
+            }
+            if (lowlink[node] == index[node]) {
+                int member;
+                do {
+                    member = stack.back();
+                    stack.pop_back();
+                    on_stack[member] = false;
+                    component[member] = num_components;
+                } while (member != node);
+                ++num_components;
+            }
+            call_stack.pop_back();
+            if (!call_stack.empty()) {
+                const int parent = call_stack.back().first;
+                lowlink[parent] = std::min(lowlink[parent], lowlink[node]);
             }
         }
-        offset += num_objects;
     }
-    return role_denot;
+    return component;
 }
 
+
+static void compute_transitive_closure_scc(const RoleDenotation& edges, bool reflexive, RoleDenotation& result) {
+    using Bitset = dlplan::utils::DynamicBitset<std::uint64_t>;
+    using Position = RoleBitset::Position;
+    const int num_objects = edges.get_num_objects();
+    const AdjList adj_list = compute_adjacency_list(edges);
+    int num_components;
+    const std::vector<int> component = compute_strongly_connected_components(adj_list, num_components);
+    std::vector<std::vector<int>> members(num_components);
+    for (int node = 0; node < num_objects; ++node) {
+        members[component[node]].push_back(node);
+    }
+    // Successor components have smaller numbers and are completed first.
+    std::vector<Bitset> reachable(num_components, Bitset(num_objects));
+    std::size_t num_pairs = 0;
+    for (int c = 0; c < num_components; ++c) {
+        Bitset& reach = reachable[c];
+        bool is_cyclic = members[c].size() > 1;
+        for (int node : members[c]) {
+            for (int successor : adj_list[node]) {
+                const int successor_component = component[successor];
+                if (successor_component == c) {
+                    is_cyclic = true;
+                } else if (!reach.test(successor)) {
+                    reach.set(successor);
+                    reach |= reachable[successor_component];
+                }
+            }
+        }
+        if (is_cyclic) {
+            for (int node : members[c]) reach.set(node);
+        }
+        num_pairs += members[c].size() * reach.count();
+    }
+    auto& result_data = result.get_bitset_ref();
+    if (num_pairs * 32 > result_data.size()) {
+        auto& closure = result_data.to_dense();
+        for (int i = 0; i < num_objects; ++i) {
+            closure.or_range(i * num_objects, reachable[component[i]], 0, num_objects);
+            if (reflexive) closure.set(i * num_objects + i);
+        }
+        result_data.normalize();
+        return;
+    }
+    std::vector<Position> positions;
+    positions.reserve(num_pairs + (reflexive ? num_objects : 0));
+    for (int i = 0; i < num_objects; ++i) {
+        const Position offset = i * num_objects;
+        bool add_diagonal = reflexive;
+        reachable[component[i]].for_each_set_bit([&](std::size_t j) {
+            if (add_diagonal && static_cast<int>(j) >= i) {
+                if (static_cast<int>(j) > i) positions.push_back(offset + i);
+                add_diagonal = false;
+            }
+            positions.push_back(offset + j);
+        });
+        if (add_diagonal) positions.push_back(offset + i);
+    }
+    result_data.assign_sorted(std::move(positions));
+}
+
+
+void compute_transitive_closure(const RoleDenotation& edges, bool reflexive, RoleDenotation& result) {
+    if (edges.get_bitset_ref().is_dense()) {
+        compute_transitive_closure_warshall(edges, reflexive, result);
+    } else {
+        compute_transitive_closure_scc(edges, reflexive, result);
+    }
+}
+
+
+dlplan::utils::DynamicBitset<std::uint64_t> concept_denot_to_bitset(const ConceptDenotation& denot) {
+    return denot.get_bitset_ref().to_dynamic_bitset();
+}
+
+
 }
@@ -11,21 +11,52 @@ const int INF = std::numeric_limits<int>::max();
 namespace dlplan::core::element::utils {
 
 using Distances = std::vector<int>;
-using PairwiseDistances = std::vector<Distances>;
 
 extern int path_addition(int a, int b);
 
+/**
+ * Level-synchronous breadth-first search where each level is a bitset of objects.
+ * The next level is the union of the rows of edges for all objects in the frontier
+ * minus the visited objects. The search stops at the first level that contains a target.
+ */
 extern int compute_multi_source_multi_target_shortest_distance(const ConceptDenotation& sources, const RoleDenotation& edges, const ConceptDenotation& targets);
 
+/**
+ * Like above but continues until all targets are reached.
+ * Objects that are no targets can remain at INF even if they are reachable.
+ */
 extern Distances compute_multi_source_multi_target_shortest_distances(const ConceptDenotation& sources, const RoleDenotation& edges, const ConceptDenotation& targets);
 
-extern PairwiseDistances compute_floyd_warshall(const RoleDenotation& edges);
+/**
+ * The minimum over all (k,i) in role_from and (k,j) in role_to of the distance from i to j.
+ * One breadth-first search over edges is run for each distinct i in role_from
+ * and shared among all k with (k,i) in role_from.
+ * Buffers are reused per thread such that no allocation is necessary in the steady state.
+ */
+extern int compute_role_distance(const RoleDenotation& role_from, const RoleDenotation& edges, const RoleDenotation& role_to);
+
+/**
+ * Like above but sums over all (k,i) in role_from the minimum over (k,j) in role_to of the distance from i to j.
+ */
+extern int compute_sum_role_distance(const RoleDenotation& role_from, const RoleDenotation& edges, const RoleDenotation& role_to);
+
+/**
+ * Boolean matrix product: adds (i,j) to result if there is a k
+ * with (i,k) in left and (k,j) in right.
+ * For each (i,k) in left the row k of right is ORed blockwise into the row i of result.
+ */
+extern void compute_role_composition(const RoleDenotation& left, const RoleDenotation& right, RoleDenotation& result);
+
+/**
+ * Transitive closure of edges, optionally reflexive, written into an empty result.
+ * Dense graphs use Warshall's algorithm where row k is ORed blockwise into every row i with (i,k).
+ * Sparse graphs are condensed into strongly connected components
+ * whose reachable sets are propagated in reverse topological order.
+ */
+extern void compute_transitive_closure(const RoleDenotation& edges, bool reflexive, RoleDenotation& result);
+
+extern dlplan::utils::DynamicBitset<std::uint64_t> concept_denot_to_bitset(const ConceptDenotation& denot);
 
-extern dlplan::utils::DynamicBitset<unsigned> concept_denot_to_bitset(const ConceptDenotation& denot);
-
-extern dlplan::utils::DynamicBitset<unsigned> role_denot_to_bitset(const RoleDenotation& denot);
-
-extern RoleDenotation bitset_to_role_denotation(dlplan::utils::DynamicBitset<unsigned> bitset, int num_objects);
 
 }
 
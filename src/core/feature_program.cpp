@@ -0,0 +1,251 @@
+#include "feature_program.h"
+
+#include <algorithm>
+
+#include "elements/concept.h"
+#include "elements/role.h"
+#include "elements/numerical.h"
+#include "elements/boolean.h"
+
+
+namespace dlplan::core {
+
+namespace element {
+
+ProgramCompiler::ProgramCompiler() : m_predicate_idx(-1) { }
+
+template<typename T>
+int ProgramCompiler::compile(const T& element, Instruction::Type type) {
+    auto& registers = m_registers[static_cast<int>(type)];
+    auto it = registers.find(&element);
+    if (it != registers.end()) {
+        m_dependencies.push_back(it->second.second);
+        return it->second.first;
+    }
+    // The children add their instructions to a fresh list of dependencies.
+    std::vector<int> dependencies;
+    std::swap(dependencies, m_dependencies);
+    m_predicate_idx = -1;
+    Operands operands = element.compile(*this);
+    std::swap(dependencies, m_dependencies);
+    int result = static_cast<int>(registers.size());
+    int instruction_idx = static_cast<int>(m_instructions.size());
+    registers.emplace(&element, std::make_pair(result, instruction_idx));
+    m_instructions.push_back(Instruction{type, &element, result, operands, m_predicate_idx, std::move(dependencies)});
+    m_predicate_idx = -1;
+    m_dependencies.push_back(instruction_idx);
+    return result;
+}
+
+int ProgramCompiler::compile(const Concept& concept) {
+    return compile(concept, Instruction::Type::CONCEPT);
+}
+
+int ProgramCompiler::compile(const Role& role) {
+    return compile(role, Instruction::Type::ROLE);
+}
+
+int ProgramCompiler::compile(const Numerical& numerical) {
+    return compile(numerical, Instruction::Type::NUMERICAL);
+}
+
+int ProgramCompiler::compile(const Boolean& boolean) {
+    return compile(boolean, Instruction::Type::BOOLEAN);
+}
+
+void ProgramCompiler::read_predicate(const Predicate& predicate) {
+    m_predicate_idx = predicate.get_index();
+}
+
+const std::vector<Instruction>& ProgramCompiler::get_instructions_ref() const {
+    return m_instructions;
+}
+
+int ProgramCompiler::get_num_registers(Instruction::Type type) const {
+    return static_cast<int>(m_registers[static_cast<int>(type)].size());
+}
+
+}
+
+
+FeatureProgramImpl::FeatureProgramImpl(const std::vector<Boolean>& booleans, const std::vector<Numerical>& numericals)
+    : m_num_concept_registers(0), m_num_role_registers(0), m_num_objects(-1),
+      m_concept_buffer(0), m_role_buffer(0), m_num_executed_instructions(0) {
+    element::ProgramCompiler compiler;
+    for (const auto& boolean : booleans) {
+        if (!m_vocabulary_info) m_vocabulary_info = boolean.get_vocabulary_info();
+        if (m_vocabulary_info.get() != &boolean.get_vocabulary_info_ref()) {
+            throw std::runtime_error("FeatureProgram::FeatureProgram - mismatched vocabularies of features.");
+        }
+        m_booleans.push_back(boolean.get_element());
+        m_boolean_registers.push_back(compiler.compile(boolean.get_element_ref()));
+    }
+    for (const auto& numerical : numericals) {
+        if (!m_vocabulary_info) m_vocabulary_info = numerical.get_vocabulary_info();
+        if (m_vocabulary_info.get() != &numerical.get_vocabulary_info_ref()) {
+            throw std::runtime_error("FeatureProgram::FeatureProgram - mismatched vocabularies of features.");
+        }
+        m_numericals.push_back(numerical.get_element());
+        m_numerical_registers.push_back(compiler.compile(numerical.get_element_ref()));
+    }
+    m_instructions = compiler.get_instructions_ref();
+    m_num_concept_registers = compiler.get_num_registers(element::Instruction::Type::CONCEPT);
+    m_num_role_registers = compiler.get_num_registers(element::Instruction::Type::ROLE);
+    m_registers.numericals.resize(compiler.get_num_registers(element::Instruction::Type::NUMERICAL));
+    m_registers.booleans.resize(compiler.get_num_registers(element::Instruction::Type::BOOLEAN));
+    m_changed_instructions.resize(m_instructions.size());
+    if (m_vocabulary_info) m_changed_predicates.resize(m_vocabulary_info->get_predicates_ref().size());
+}
+
+void FeatureProgramImpl::allocate_registers(int num_objects) {
+    m_registers.concepts.assign(m_num_concept_registers, ConceptDenotation(num_objects));
+    m_registers.roles.assign(m_num_role_registers, RoleDenotation(num_objects));
+    m_concept_buffer = ConceptDenotation(num_objects);
+    m_role_buffer = RoleDenotation(num_objects);
+    m_num_objects = num_objects;
+}
+
+void FeatureProgramImpl::execute(const element::Instruction& instruction, const State& state) {
+    switch (instruction.type) {
+        case element::Instruction::Type::CONCEPT: {
+            auto& result = m_registers.concepts[instruction.result];
+            result.get_bitset_ref().reset();
+            static_cast<const element::Concept*>(instruction.element)->execute(state, m_registers, instruction.operands, result);
+            break;
+        }
+        case element::Instruction::Type::ROLE: {
+            auto& result = m_registers.roles[instruction.result];
+            result.get_bitset_ref().reset();
+            static_cast<const element::Role*>(instruction.element)->execute(state, m_registers, instruction.operands, result);
+            break;
+        }
+        case element::Instruction::Type::NUMERICAL: {
+            m_registers.numericals[instruction.result] =
+                static_cast<const element::Numerical*>(instruction.element)->execute(state, m_registers, instruction.operands);
+            break;
+        }
+        case element::Instruction::Type::BOOLEAN: {
+            m_registers.booleans[instruction.result] =
+                static_cast<const element::Boolean*>(instruction.element)->execute(state, m_registers, instruction.operands);
+            break;
+        }
+    }
+}
+
+bool FeatureProgramImpl::update(const element::Instruction& instruction, const State& state) {
+    switch (instruction.type) {
+        case element::Instruction::Type::CONCEPT: {
+            m_concept_buffer.get_bitset_ref().reset();
+            static_cast<const element::Concept*>(instruction.element)->execute(state, m_registers, instruction.operands, m_concept_buffer);
+            auto& result = m_registers.concepts[instruction.result];
+            if (m_concept_buffer == result) return false;
+            std::swap(m_concept_buffer, result);
+            return true;
+        }
+        case element::Instruction::Type::ROLE: {
+            m_role_buffer.get_bitset_ref().reset();
+            static_cast<const element::Role*>(instruction.element)->execute(state, m_registers, instruction.operands, m_role_buffer);
+            auto& result = m_registers.roles[instruction.result];
+            if (m_role_buffer == result) return false;
+            std::swap(m_role_buffer, result);
+            return true;
+        }
+        case element::Instruction::Type::NUMERICAL: {
+            int value = static_cast<const element::Numerical*>(instruction.element)->execute(state, m_registers, instruction.operands);
+            if (value == m_registers.numericals[instruction.result]) return false;
+            m_registers.numericals[instruction.result] = value;
+            return true;
+        }
+        case element::Instruction::Type::BOOLEAN: {
+            char value = static_cast<const element::Boolean*>(instruction.element)->execute(state, m_registers, instruction.operands);
+            if (value == m_registers.booleans[instruction.result]) return false;
+            m_registers.booleans[instruction.result] = value;
+            return true;
+        }
+    }
+    return true;
+}
+
+void FeatureProgramImpl::evaluate(const State& state) {
+    if (m_vocabulary_info && &state.get_instance_info_ref().get_vocabulary_info_ref() != m_vocabulary_info.get()) {
+        throw std::runtime_error("FeatureProgram::evaluate - mismatched vocabularies of features and State.");
+    }
+    int num_objects = state.get_instance_info_ref().get_num_objects();
+    if (num_objects != m_num_objects) {
+        allocate_registers(num_objects);
+    }
+    for (const auto& instruction : m_instructions) {
+        execute(instruction, state);
+    }
+    m_instance_info = state.get_instance_info();
+    m_atom_idxs.assign(state.get_atom_idxs_ref().begin(), state.get_atom_idxs_ref().end());
+    m_num_executed_instructions = static_cast<int>(m_instructions.size());
+}
+
+void FeatureProgramImpl::evaluate_incrementally(const State& state) {
+    // Objects can be added to an instance between two evaluations.
+    if (&state.get_instance_info_ref() != m_instance_info.get()
+        || state.get_instance_info_ref().get_num_objects() != m_num_objects) {
+        evaluate(state);
+        return;
+    }
+    // Mark the predicates of atoms in which the states differ.
+    const auto& atom_table = state.get_instance_info_ref().get_atom_table_ref();
+    auto& atom_idxs = m_successor_atom_idxs;
+    atom_idxs.assign(state.get_atom_idxs_ref().begin(), state.get_atom_idxs_ref().end());
+    std::fill(m_changed_predicates.begin(), m_changed_predicates.end(), false);
+    auto mark = [&](int atom_idx) {
+        m_changed_predicates[atom_table.get_predicate_idx(atom_idx)] = true;
+    };
+    auto it_1 = m_atom_idxs.begin();
+    auto it_2 = atom_idxs.begin();
+    while (it_1 != m_atom_idxs.end() || it_2 != atom_idxs.end()) {
+        if (it_2 == atom_idxs.end() || (it_1 != m_atom_idxs.end() && *it_1 < *it_2)) {
+            mark(*it_1++);
+        } else if (it_1 == m_atom_idxs.end() || *it_2 < *it_1) {
+            mark(*it_2++);
+        } else {
+            ++it_1;
+            ++it_2;
+        }
+    }
+    // Recompute elements that read changed predicates or whose children changed.
+    m_num_executed_instructions = 0;
+    for (std::size_t i = 0; i < m_instructions.size(); ++i) {
+        const auto& instruction = m_instructions[i];
+        bool dirty = instruction.predicate_idx != -1 && m_changed_predicates[instruction.predicate_idx];
+        for (int dependency : instruction.dependencies) {
+            dirty |= m_changed_instructions[dependency];
+        }
+        if (dirty) {
+            ++m_num_executed_instructions;
+            dirty = update(instruction, state);
+        }
+        m_changed_instructions[i] = dirty;
+    }
+    std::swap(m_atom_idxs, m_successor_atom_idxs);
+}
+
+bool FeatureProgramImpl::get_boolean_value(int boolean_idx) const {
+    if (boolean_idx < 0 || boolean_idx >= static_cast<int>(m_boolean_registers.size())) {
+        throw std::runtime_error("FeatureProgram::get_boolean_value - index out of range.");
+    }
+    return m_registers.booleans[m_boolean_registers[boolean_idx]];
+}
+
+int FeatureProgramImpl::get_numerical_value(int numerical_idx) const {
+    if (numerical_idx < 0 || numerical_idx >= static_cast<int>(m_numerical_registers.size())) {
+        throw std::runtime_error("FeatureProgram::get_numerical_value - index out of range.");
+    }
+    return m_registers.numericals[m_numerical_registers[numerical_idx]];
+}
+
+int FeatureProgramImpl::get_num_instructions() const {
+    return static_cast<int>(m_instructions.size());
+}
+
+int FeatureProgramImpl::get_num_executed_instructions() const {
+    return m_num_executed_instructions;
+}
+
+}
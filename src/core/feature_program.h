@@ -0,0 +1,65 @@
+#ifndef DLPLAN_SRC_CORE_FEATURE_PROGRAM_H_
+#define DLPLAN_SRC_CORE_FEATURE_PROGRAM_H_
+
+#include <memory>
+#include <vector>
+
+#include "elements/program.h"
+
+#include "../../include/dlplan/core.h"
+
+
+namespace dlplan::core {
+
+class FeatureProgramImpl {
+private:
+    std::shared_ptr<const VocabularyInfo> m_vocabulary_info;
+    // The compiled elements are kept alive by the features.
+    std::vector<std::shared_ptr<const element::Boolean>> m_booleans;
+    std::vector<std::shared_ptr<const element::Numerical>> m_numericals;
+
+    std::vector<element::Instruction> m_instructions;
+    std::vector<int> m_boolean_registers;
+    std::vector<int> m_numerical_registers;
+    int m_num_concept_registers;
+    int m_num_role_registers;
+
+    element::Registers m_registers;
+    // The number of objects that the denotation registers were allocated for.
+    int m_num_objects;
+
+    // The instance and sorted atoms of the state that the registers hold.
+    std::shared_ptr<const InstanceInfo> m_instance_info;
+    Index_Vec m_atom_idxs;
+    // Buffers of evaluate_incrementally.
+    Index_Vec m_successor_atom_idxs;
+    std::vector<char> m_changed_predicates;
+    std::vector<char> m_changed_instructions;
+    ConceptDenotation m_concept_buffer;
+    RoleDenotation m_role_buffer;
+    int m_num_executed_instructions;
+
+    void allocate_registers(int num_objects);
+
+    void execute(const element::Instruction& instruction, const State& state);
+
+    /**
+     * Executes the instruction and returns true iff the value of its register changed.
+     */
+    bool update(const element::Instruction& instruction, const State& state);
+
+public:
+    FeatureProgramImpl(const std::vector<Boolean>& booleans, const std::vector<Numerical>& numericals);
+
+    void evaluate(const State& state);
+    void evaluate_incrementally(const State& state);
+
+    bool get_boolean_value(int boolean_idx) const;
+    int get_numerical_value(int numerical_idx) const;
+    int get_num_instructions() const;
+    int get_num_executed_instructions() const;
+};
+
+}
+
+#endif
@@ -6,6 +6,7 @@
 #include <sstream>
 #include <cassert>
 
+#include "atom_index.h"
 #include "../utils/collections.h"
 
 using namespace std::string_literals;
@@ -13,32 +14,84 @@ using namespace std::string_literals;
 
 namespace dlplan::core {
 
-static std::string compute_atom_name(const Predicate& predicate, const std::vector<Object>& objects) {
-    std::stringstream ss;
-    ss << predicate.get_name_ref() << "(";
-    for (size_t i = 0; i < objects.size(); ++i) {
-        const auto& object = objects[i];
-        ss << object.get_name_ref();
-        if (i < objects.size() - 1) ss << ",";
-    }
-    ss << ")";
-    return ss.str();
-}
-
 InstanceInfo::InstanceInfo(std::shared_ptr<const VocabularyInfo> vocabulary_info, int index)
-    : m_vocabulary_info(vocabulary_info), m_index(index) {
+    : m_vocabulary_info(vocabulary_info), m_index(index),
+      m_atom_table(std::make_shared<AtomTable>(vocabulary_info, nullptr)),
+      m_static_atom_table(std::make_shared<AtomTable>(vocabulary_info, nullptr)),
+      m_objects(std::make_shared<std::vector<Object>>()),
+      m_constant_idx_to_object_idx(vocabulary_info->get_constants_ref().size(), -1) {
+    reset_atom_views();
 }
 
-InstanceInfo::InstanceInfo(const InstanceInfo& other) = default;
-
-InstanceInfo& InstanceInfo::operator=(const InstanceInfo& other) = default;
+// The tables and objects are copied such that the copy does not share them with the atoms of other.
+// The static atom masks are loaded atomically because another thread may be building them.
+InstanceInfo::InstanceInfo(const InstanceInfo& other)
+    : m_vocabulary_info(other.m_vocabulary_info),
+      m_index(other.m_index),
+      m_atom_table(std::make_shared<AtomTable>(*other.m_atom_table)),
+      m_atoms(other.m_atoms),
+      m_static_atom_table(std::make_shared<AtomTable>(*other.m_static_atom_table)),
+      m_static_atoms(other.m_static_atoms),
+      m_per_predicate_idx_static_atom_idxs(other.m_per_predicate_idx_static_atom_idxs),
+      m_static_atom_masks(std::atomic_load(&other.m_static_atom_masks)),
+      m_object_name_to_object_idx(other.m_object_name_to_object_idx),
+      m_objects(std::make_shared<std::vector<Object>>(*other.m_objects)),
+      m_constant_idx_to_object_idx(other.m_constant_idx_to_object_idx) {
+    reset_atom_views();
+}
 
-InstanceInfo::InstanceInfo(InstanceInfo&& other) = default;
+InstanceInfo& InstanceInfo::operator=(const InstanceInfo& other) {
+    if (this != &other) {
+        InstanceInfo copy(other);
+        *this = std::move(copy);
+    }
+    return *this;
+}
 
-InstanceInfo& InstanceInfo::operator=(InstanceInfo&& other) = default;
+// The atoms keep viewing the moved tables.
+InstanceInfo::InstanceInfo(InstanceInfo&& other)
+    : m_vocabulary_info(std::move(other.m_vocabulary_info)),
+      m_index(other.m_index),
+      m_atom_table(std::move(other.m_atom_table)),
+      m_atoms(std::move(other.m_atoms)),
+      m_static_atom_table(std::move(other.m_static_atom_table)),
+      m_static_atoms(std::move(other.m_static_atoms)),
+      m_per_predicate_idx_static_atom_idxs(std::move(other.m_per_predicate_idx_static_atom_idxs)),
+      m_static_atom_masks(std::move(other.m_static_atom_masks)),
+      m_object_name_to_object_idx(std::move(other.m_object_name_to_object_idx)),
+      m_objects(std::move(other.m_objects)),
+      m_constant_idx_to_object_idx(std::move(other.m_constant_idx_to_object_idx)) { }
+
+InstanceInfo& InstanceInfo::operator=(InstanceInfo&& other) {
+    if (this != &other) {
+        m_vocabulary_info = std::move(other.m_vocabulary_info);
+        m_index = other.m_index;
+        m_atom_table = std::move(other.m_atom_table);
+        m_atoms = std::move(other.m_atoms);
+        m_static_atom_table = std::move(other.m_static_atom_table);
+        m_static_atoms = std::move(other.m_static_atoms);
+        m_per_predicate_idx_static_atom_idxs = std::move(other.m_per_predicate_idx_static_atom_idxs);
+        m_static_atom_masks = std::move(other.m_static_atom_masks);
+        m_object_name_to_object_idx = std::move(other.m_object_name_to_object_idx);
+        m_objects = std::move(other.m_objects);
+        m_constant_idx_to_object_idx = std::move(other.m_constant_idx_to_object_idx);
+    }
+    return *this;
+}
 
 InstanceInfo::~InstanceInfo() = default;
 
+void InstanceInfo::reset_atom_views() {
+    m_atom_table->m_objects = m_objects;
+    m_static_atom_table->m_objects = m_objects;
+    for (auto& atom : m_atoms) {
+        atom.m_atom_table = m_atom_table;
+    }
+    for (auto& atom : m_static_atoms) {
+        atom.m_atom_table = m_static_atom_table;
+    }
+}
+
 const Atom& InstanceInfo::add_atom(const std::string &predicate_name, const Name_Vec &object_names, bool is_static) {
     if (m_vocabulary_info->get_predicate_ref(m_vocabulary_info->get_predicate_idx(predicate_name)).get_arity() != static_cast<int>(object_names.size())) {
         throw std::runtime_error("InstanceInfo::add_atom - predicate arity does not match the number of objects ("s + std::to_string(m_vocabulary_info->get_predicate_ref(m_vocabulary_info->get_predicate_idx(predicate_name)).get_arity()) + " != " + std::to_string(object_names.size()));
@@ -47,54 +100,135 @@ const Atom& InstanceInfo::add_atom(const std::string &predicate_name, const Name
     int predicate_idx = m_vocabulary_info->get_predicate_idx(predicate_name);
     const Predicate& predicate = m_vocabulary_info->get_predicate_ref(predicate_idx);
     // object related
-    std::vector<Object> objects;
+    std::vector<int> object_idxs;
     for (int i = 0; i < static_cast<int>(object_names.size()); ++i) {
         const std::string& object_name = object_names[i];
-        auto result = m_object_name_to_object_idx.emplace(object_name, m_objects.size());
+        auto result = m_object_name_to_object_idx.emplace(object_name, m_objects->size());
         int object_idx = result.first->second;
         bool newly_inserted = result.second;
         if (newly_inserted) {
-            m_objects.push_back(Object(object_name, object_idx));
+            m_objects->push_back(Object(object_name, object_idx));
+            map_constant(m_objects->back());
+            m_static_atom_masks.reset();
         }
-        objects.push_back(m_objects[object_idx]);
+        object_idxs.push_back(object_idx);
     }
-    return add_atom(predicate, objects, is_static);
+    return add_atom(predicate, object_idxs, is_static);
 }
 
 const Atom& InstanceInfo::add_atom(const Predicate& predicate, const std::vector<Object>& objects, bool is_static) {
     if (predicate.get_arity() != static_cast<int>(objects.size())) {
         throw std::runtime_error("InstanceInfo::add_atom - predicate arity does not match the number of objects ("s + std::to_string(predicate.get_arity()) + " != " + std::to_string(objects.size()));
     }
+    std::vector<int> object_idxs;
+    object_idxs.reserve(objects.size());
+    for (const auto& object : objects) {
+        if (!utils::in_bounds(object.get_index(), *m_objects) || (*m_objects)[object.get_index()] != object) {
+            throw std::runtime_error("InstanceInfo::add_atom - object ("s + object.get_name_ref() + ") does not exist in the instance.");
+        }
+        object_idxs.push_back(object.get_index());
+    }
+    return add_atom(predicate, object_idxs, is_static);
+}
+
+const Atom& InstanceInfo::add_atom(const Predicate& predicate, const std::vector<int>& object_idxs, bool is_static) {
+    if (!std::all_of(object_idxs.begin(), object_idxs.end(), [&](int object_idx){ return utils::in_bounds(object_idx, *m_objects); })) {
+        throw std::runtime_error("InstanceInfo::add_atom - object index out of range.");
+    }
     if (is_static) {
-        Atom atom = Atom(compute_atom_name(predicate, objects), m_static_atoms.size(), predicate, objects, is_static);
-        auto result = m_static_atom_name_to_static_atom_idx.emplace(atom.get_name_ref(), m_static_atoms.size());
-        bool newly_inserted = result.second;
-        if (!newly_inserted) {
-            throw std::runtime_error("InstanceInfo::add_atom - atom with name ("s + atom.get_name_ref() + ") already exists.");
+        auto result = m_static_atom_table->insert(predicate.get_index(), object_idxs);
+        if (!result.second) {
+            throw std::runtime_error("InstanceInfo::add_atom - atom with name ("s + m_static_atom_table->get_name_ref(result.first) + ") already exists.");
         }
-        m_per_predicate_idx_static_atom_idxs[predicate.get_index()].push_back(atom.get_index());
-        m_static_atoms.push_back(std::move(atom));
+        m_per_predicate_idx_static_atom_idxs[predicate.get_index()].push_back(result.first);
+        m_static_atom_masks.reset();
+        m_static_atoms.push_back(Atom(m_static_atom_table, result.first, true));
         return m_static_atoms.back();
     } else {
-        Atom atom = Atom(compute_atom_name(predicate, objects), m_atoms.size(), predicate, objects, is_static);
-        auto result = m_atom_name_to_atom_idx.emplace(atom.get_name_ref(), m_atoms.size());
-        bool newly_inserted = result.second;
-        if (!newly_inserted) {
-            return m_atoms[result.first->second];
+        auto result = m_atom_table->insert(predicate.get_index(), object_idxs);
+        if (!result.second) {
+            return m_atoms[result.first];
         }
-        m_atoms.push_back(std::move(atom));
+        m_atoms.push_back(Atom(m_atom_table, result.first, false));
         return m_atoms.back();
     }
 }
 
+int InstanceInfo::add_atoms(const Index_Vec& predicate_idxs, const Index_Vec& object_idxs, bool is_static) {
+    const auto& predicates = m_vocabulary_info->get_predicates_ref();
+    size_t num_object_idxs = 0;
+    for (int predicate_idx : predicate_idxs) {
+        if (!utils::in_bounds(predicate_idx, predicates)) {
+            throw std::runtime_error("InstanceInfo::add_atoms - predicate index out of range ("s + std::to_string(predicate_idx) + ").");
+        }
+        num_object_idxs += predicates[predicate_idx].get_arity();
+    }
+    if (num_object_idxs != object_idxs.size()) {
+        throw std::runtime_error("InstanceInfo::add_atoms - predicate arities do not match the number of objects ("s + std::to_string(num_object_idxs) + " != " + std::to_string(object_idxs.size()) + ").");
+    }
+    if (!std::all_of(object_idxs.begin(), object_idxs.end(), [&](int object_idx){ return utils::in_bounds(object_idx, *m_objects); })) {
+        throw std::runtime_error("InstanceInfo::add_atoms - object index out of range.");
+    }
+    AtomTable& atom_table = is_static ? *m_static_atom_table : *m_atom_table;
+    std::vector<Atom>& atoms = is_static ? m_static_atoms : m_atoms;
+    int first_atom_idx = atom_table.size();
+    atom_table.reserve(predicate_idxs.size(), object_idxs.size());
+    atoms.reserve(first_atom_idx + predicate_idxs.size());
+    const int* atom_object_idxs = object_idxs.data();
+    for (int predicate_idx : predicate_idxs) {
+        int arity = predicates[predicate_idx].get_arity();
+        int atom_idx = atom_table.push_back(predicate_idx, atom_object_idxs, arity);
+        atom_object_idxs += arity;
+        atoms.push_back(Atom(is_static ? m_static_atom_table : m_atom_table, atom_idx, is_static));
+        if (is_static) {
+            m_per_predicate_idx_static_atom_idxs[predicate_idx].push_back(atom_idx);
+        }
+    }
+    if (is_static) {
+        m_static_atom_masks.reset();
+    }
+    return first_atom_idx;
+}
+
+int InstanceInfo::add_objects(const Name_Vec& object_names) {
+    int first_object_idx = m_objects->size();
+    m_objects->reserve(m_objects->size() + object_names.size());
+    m_object_name_to_object_idx.reserve(m_objects->size() + object_names.size());
+    for (const auto& object_name : object_names) {
+        add_object(object_name);
+    }
+    return first_object_idx;
+}
+
+int InstanceInfo::add_atoms(const Index_Vec& predicate_idxs, const Index_Vec& object_idxs) {
+    return add_atoms(predicate_idxs, object_idxs, false);
+}
+
+int InstanceInfo::add_static_atoms(const Index_Vec& predicate_idxs, const Index_Vec& object_idxs) {
+    return add_atoms(predicate_idxs, object_idxs, true);
+}
+
+void InstanceInfo::map_constant(const Object& object) {
+    if (!m_vocabulary_info->exists_constant_name(object.get_name_ref())) {
+        return;
+    }
+    int constant_idx = m_vocabulary_info->get_constant_idx(object.get_name_ref());
+    if (constant_idx >= static_cast<int>(m_constant_idx_to_object_idx.size())) {
+        m_constant_idx_to_object_idx.resize(constant_idx + 1, -1);
+    }
+    m_constant_idx_to_object_idx[constant_idx] = object.get_index();
+}
+
 const Object& InstanceInfo::add_object(const std::string& object_name) {
-    Object object = Object(object_name, m_objects.size());
-    auto result = m_object_name_to_object_idx.emplace(object.get_name_ref(), m_objects.size());
+    Object object = Object(object_name, m_objects->size());
+    auto result = m_object_name_to_object_idx.emplace(object.get_name_ref(), m_objects->size());
     if (!result.second) {
         throw std::runtime_error("InstanceInfo::add_object - object with name ("s + object.get_name_ref() + ") already exists.");
     }
-    m_objects.push_back(std::move(object));
-    return m_objects.back();
+    m_objects->push_back(std::move(object));
+    map_constant(m_objects->back());
+    m_static_atom_masks.reset();
+    return m_objects->back();
 }
 
 const Atom& InstanceInfo::add_atom(const Predicate& predicate, const std::vector<Object>& objects) {
@@ -137,6 +271,14 @@ const std::vector<Atom>& InstanceInfo::get_static_atoms_ref() const {
     return m_static_atoms;
 }
 
+const AtomTable& InstanceInfo::get_atom_table_ref() const {
+    return *m_atom_table;
+}
+
+const AtomTable& InstanceInfo::get_static_atom_table_ref() const {
+    return *m_static_atom_table;
+}
+
 const Atom& InstanceInfo::get_atom_ref(int atom_idx) const {
     if (!utils::in_bounds(atom_idx, m_atoms)) {
         throw std::runtime_error("InstanceInfo::get_atom - atom index out of range.");
@@ -145,18 +287,19 @@ const Atom& InstanceInfo::get_atom_ref(int atom_idx) const {
 }
 
 int InstanceInfo::get_atom_idx(const std::string& name) const {
-    if (m_atom_name_to_atom_idx.find(name) == m_atom_name_to_atom_idx.end()) {
+    int atom_idx = m_atom_table->find(name);
+    if (atom_idx == -1) {
         throw std::runtime_error("InstanceInfo::get_atom_idx - no atom with name ("s + name + ").");
     }
-    return m_atom_name_to_atom_idx.at(name);
+    return atom_idx;
 }
 
 bool InstanceInfo::exists_object(const Object& object) const {
-    if (!utils::in_bounds(object.get_index(), m_objects)) {
+    if (!utils::in_bounds(object.get_index(), *m_objects)) {
         throw std::runtime_error("InstanceInfo::exists_object: object index out of range.");
     }
     // we only need to check the position with the corresponding index.
-    return (m_objects[object.get_index()] == object) ? true : false;
+    return ((*m_objects)[object.get_index()] == object) ? true : false;
 }
 
 bool InstanceInfo::exists_object(const std::string name) const {
@@ -164,14 +307,14 @@ bool InstanceInfo::exists_object(const std::string name) const {
 }
 
 const std::vector<Object>& InstanceInfo::get_objects_ref() const {
-    return m_objects;
+    return *m_objects;
 }
 
 const Object& InstanceInfo::get_object_ref(int object_idx) const {
-    if (!utils::in_bounds(object_idx, m_objects)) {
+    if (!utils::in_bounds(object_idx, *m_objects)) {
         throw std::runtime_error("InstanceInfo::get_object - object index out of range.");
     }
-    return m_objects[object_idx];
+    return (*m_objects)[object_idx];
 }
 
 int InstanceInfo::get_object_idx(const std::string& object_name) const {
@@ -181,8 +324,18 @@ int InstanceInfo::get_object_idx(const std::string& object_name) const {
     return m_object_name_to_object_idx.at(object_name);
 }
 
+int InstanceInfo::get_constant_object_idx(const Constant& constant) const {
+    int constant_idx = constant.get_index();
+    if (utils::in_bounds(constant_idx, m_constant_idx_to_object_idx) && m_constant_idx_to_object_idx[constant_idx] != -1) {
+        return m_constant_idx_to_object_idx[constant_idx];
+    }
+    // The constant was added to the vocabulary after the object or there is no such object.
+    auto it = m_object_name_to_object_idx.find(constant.get_name_ref());
+    return (it != m_object_name_to_object_idx.end()) ? static_cast<int>(it->second) : -1;
+}
+
 int InstanceInfo::get_num_objects() const {
-    return m_objects.size();
+    return m_objects->size();
 }
 
 const VocabularyInfo& InstanceInfo::get_vocabulary_info_ref() const {
@@ -197,4 +350,17 @@ const phmap::flat_hash_map<int, std::vector<int>>& InstanceInfo::get_per_predica
     return m_per_predicate_idx_static_atom_idxs;
 }
 
+const StaticAtomMasks& InstanceInfo::get_static_atom_masks_ref() const {
+    std::shared_ptr<const StaticAtomMasks> static_atom_masks = std::atomic_load(&m_static_atom_masks);
+    if (!static_atom_masks) {
+        // Threads that build the masks concurrently agree on the first one stored.
+        std::shared_ptr<const StaticAtomMasks> expected;
+        static_atom_masks = std::make_shared<const StaticAtomMasks>(*this);
+        if (!std::atomic_compare_exchange_strong(&m_static_atom_masks, &expected, static_atom_masks)) {
+            static_atom_masks = expected;
+        }
+    }
+    return *static_atom_masks;
+}
+
 }
@@ -11,9 +11,9 @@ namespace dlplan::core::parser {
 class Boolean : public Expression {
 protected:
     /**
-     * Construct the Boolean.
+     * Retrieve the Boolean from the caches or construct it.
      */
-    virtual std::unique_ptr<element::Boolean> parse_boolean_impl(const VocabularyInfo& vocabulary, Caches &caches) const = 0;
+    virtual element::Boolean_Ptr parse_boolean_impl(const VocabularyInfo& vocabulary, Caches &caches) const = 0;
 
 public:
     Boolean(const std::string &name, std::vector<std::unique_ptr<Expression>> &&children)
@@ -23,7 +23,7 @@ public:
      * Construct or retrieve the Boolean.
      */
     virtual element::Boolean_Ptr parse_boolean(const VocabularyInfo& vocabulary, Caches &caches) const {
-        return caches.m_boolean_cache->insert(parse_boolean_impl(vocabulary, caches)).first;
+        return parse_boolean_impl(vocabulary, caches);
     }
 };
 
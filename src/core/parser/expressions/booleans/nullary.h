@@ -10,14 +10,14 @@ namespace dlplan::core::parser {
 
 class NullaryBoolean : public Boolean {
 protected:
-    std::unique_ptr<element::Boolean> parse_boolean_impl(const VocabularyInfo& vocabulary, Caches &) const override {
+    element::Boolean_Ptr parse_boolean_impl(const VocabularyInfo& vocabulary, Caches &caches) const override {
         if (m_children.size() != 1) {
             throw std::runtime_error("NullaryBoolean::parse_boolean_impl - number of children ("s + std::to_string(m_children.size()) + " != 1).");
         }
         // 1. Parse children
         const std::string& predicate_name = m_children[0]->get_name();
         // 2. Construct element
-        return std::make_unique<element::NullaryBoolean>(vocabulary, vocabulary.get_predicate_ref(vocabulary.get_predicate_idx(predicate_name)));
+        return caches.make<element::NullaryBoolean>(vocabulary, vocabulary.get_predicate_ref(vocabulary.get_predicate_idx(predicate_name)));
     }
 
 public:
@@ -10,9 +10,9 @@ namespace dlplan::core::parser {
 class Concept : public Expression {
 protected:
     /**
-     * Construct the Concept.
+     * Retrieve the Concept from the caches or construct it.
      */
-    virtual std::unique_ptr<element::Concept> parse_concept_impl(const VocabularyInfo& vocabulary, Caches &caches) const = 0;
+    virtual element::Concept_Ptr parse_concept_impl(const VocabularyInfo& vocabulary, Caches &caches) const = 0;
 
 public:
     Concept(const std::string &name, std::vector<std::unique_ptr<Expression>> &&children)
@@ -22,7 +22,7 @@ public:
      * Construct or retrieve the Concept.
      */
     virtual element::Concept_Ptr parse_concept(const VocabularyInfo& vocabulary, Caches &caches) const {
-        return caches.m_concept_cache->insert(parse_concept_impl(vocabulary, caches)).first;
+        return parse_concept_impl(vocabulary, caches);
     }
 };
 
@@ -9,7 +9,7 @@ namespace dlplan::core::parser {
 
 class AndConcept : public Concept {
 protected:
-    std::unique_ptr<element::Concept> parse_concept_impl(const VocabularyInfo& vocabulary, Caches &cache) const override {
+    element::Concept_Ptr parse_concept_impl(const VocabularyInfo& vocabulary, Caches &cache) const override {
         if (m_children.size() != 2) {
             throw std::runtime_error("AndConcept::parse_concept_impl - number of children ("s + std::to_string(m_children.size()) + " != 2).");
         }
@@ -20,7 +20,7 @@ protected:
             throw std::runtime_error("AndConcept::parse_concept_impl - children are not of type Concept.");
         }
         // 2. Construct element
-        return std::make_unique<element::AndConcept>(vocabulary, l, r);
+        return cache.make<element::AndConcept>(vocabulary, l, r);
     }
 
 public:
@@ -9,7 +9,7 @@ namespace dlplan::core::parser {
 
 class OneOfConcept : public Concept {
 protected:
-    std::unique_ptr<element::Concept> parse_concept_impl(const VocabularyInfo& vocabulary, Caches &) const override {
+    element::Concept_Ptr parse_concept_impl(const VocabularyInfo& vocabulary, Caches &caches) const override {
         if (m_children.size() != 1) {
             throw std::runtime_error("OneOfConcept::parse_concept_impl - number of children ("s + std::to_string(m_children.size()) + " != 1).");
         }
@@ -18,7 +18,7 @@ protected:
             throw std::runtime_error("OneOfConcept::parse_concept_impl - VocabularyInfo does not contain constant (" + constant_name + ")");
         }
         // 2. Construct element
-        return std::make_unique<element::OneOfConcept>(vocabulary, vocabulary.get_constant_ref(vocabulary.get_constant_idx(constant_name)));
+        return caches.make<element::OneOfConcept>(vocabulary, vocabulary.get_constant_ref(vocabulary.get_constant_idx(constant_name)));
     }
 
 public:
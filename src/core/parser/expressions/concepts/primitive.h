@@ -10,7 +10,7 @@ namespace dlplan::core::parser {
 
 class PrimitiveConcept : public Concept {
 protected:
-    std::unique_ptr<element::Concept> parse_concept_impl(const VocabularyInfo& vocabulary, Caches &) const override {
+    element::Concept_Ptr parse_concept_impl(const VocabularyInfo& vocabulary, Caches &caches) const override {
         if (m_children.size() != 2) {
             throw std::runtime_error("PrimitiveConcept::parse_concept_impl - number of children ("s + std::to_string(m_children.size()) + " != 2).");
         }
@@ -18,7 +18,7 @@ protected:
         const std::string& predicate_name = m_children[0]->get_name();
         int pos = try_parse_number(m_children[1]->get_name());
         // 2. Construct element
-        return std::make_unique<element::PrimitiveConcept>(vocabulary, vocabulary.get_predicate_ref(vocabulary.get_predicate_idx(predicate_name)), pos);
+        return caches.make<element::PrimitiveConcept>(vocabulary, vocabulary.get_predicate_ref(vocabulary.get_predicate_idx(predicate_name)), pos);
     }
 
 public:
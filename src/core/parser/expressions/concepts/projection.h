@@ -10,7 +10,7 @@ namespace dlplan::core::parser {
 
 class ProjectionConcept : public Concept {
 protected:
-    std::unique_ptr<element::Concept> parse_concept_impl(const VocabularyInfo& vocabulary, Caches &caches) const override {
+    element::Concept_Ptr parse_concept_impl(const VocabularyInfo& vocabulary, Caches &caches) const override {
         if (m_children.size() != 2) {
             throw std::runtime_error("ProjectionConcept::parse_concept_impl - number of children ("s + std::to_string(m_children.size()) + " != 1).");
         }
@@ -22,7 +22,7 @@ protected:
         if (pos < 0 || pos > 1) {
             throw std::runtime_error("ProjectionConcept::parse_concept_impl - projection index out of range, should be 0 or 1 ("s + std::to_string(pos) + ")");
         }
-        return std::make_unique<element::ProjectionConcept>(vocabulary, role, pos);
+        return caches.make<element::ProjectionConcept>(vocabulary, role, pos);
     }
 
 public:
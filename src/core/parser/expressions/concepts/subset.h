@@ -8,7 +8,7 @@ namespace dlplan::core::parser {
 
 class SubsetConcept : public Concept {
 protected:
-    std::unique_ptr<element::Concept> parse_concept_impl(const VocabularyInfo& vocabulary, Caches &cache) const override {
+    element::Concept_Ptr parse_concept_impl(const VocabularyInfo& vocabulary, Caches &cache) const override {
         if (m_children.size() != 2) {
             throw std::runtime_error("SubsetConcept::parse_concept_impl - number of children ("s + std::to_string(m_children.size()) + " != 2).");
         }
@@ -19,7 +19,7 @@ protected:
             throw std::runtime_error("SubsetConcept::parse_concept_impl - at least one children is a nullptr");
         }
         // 2. Construct element
-        return std::make_unique<element::SubsetConcept>(vocabulary, role_left, role_right);
+        return cache.make<element::SubsetConcept>(vocabulary, role_left, role_right);
     }
 
 public:
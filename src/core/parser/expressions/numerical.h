@@ -11,9 +11,9 @@ namespace dlplan::core::parser {
 class Numerical : public Expression {
 protected:
     /**
-     * Construct the Numerical.
+     * Retrieve the Numerical from the caches or construct it.
      */
-    virtual std::unique_ptr<element::Numerical> parse_numerical_impl(const VocabularyInfo& vocabulary, Caches &caches) const = 0;
+    virtual element::Numerical_Ptr parse_numerical_impl(const VocabularyInfo& vocabulary, Caches &caches) const = 0;
 
 public:
     Numerical(const std::string &name, std::vector<std::unique_ptr<Expression>> &&children)
@@ -23,7 +23,7 @@ public:
      * Construct or retrieve the Numerical.
      */
     virtual element::Numerical_Ptr parse_numerical(const VocabularyInfo& vocabulary, Caches &caches) const {
-        return caches.m_numerical_cache->insert(parse_numerical_impl(vocabulary, caches)).first;
+        return parse_numerical_impl(vocabulary, caches);
     }
 };
 
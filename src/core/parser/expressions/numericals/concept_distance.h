@@ -8,7 +8,7 @@ namespace dlplan::core::parser {
 
 class ConceptDistanceNumerical : public Numerical {
 protected:
-    std::unique_ptr<element::Numerical> parse_numerical_impl(const VocabularyInfo& vocabulary, Caches &cache) const override {
+    element::Numerical_Ptr parse_numerical_impl(const VocabularyInfo& vocabulary, Caches &cache) const override {
         if (m_children.size() != 3) {
             throw std::runtime_error("ConceptDistanceNumerical::parse_numerical_impl - number of children ("s + std::to_string(m_children.size()) + " != 3).");
         }
@@ -19,7 +19,7 @@ protected:
         if (!(concept_from && role && concept_to)) {
             throw std::runtime_error("ConceptDistanceNumerical::parse_numerical_impl - child is not of type Concept, Role, Concept.");
         }
-        return std::make_unique<element::ConceptDistanceNumerical>(vocabulary, concept_from, role, concept_to);
+        return cache.make<element::ConceptDistanceNumerical>(vocabulary, concept_from, role, concept_to);
     }
 
 public:
@@ -11,9 +11,9 @@ namespace dlplan::core::parser {
 class Role : public Expression {
 protected:
     /**
-     * Construct the Role.
+     * Retrieve the Role from the caches or construct it.
      */
-    virtual std::unique_ptr<element::Role> parse_role_impl(const VocabularyInfo& vocabulary, Caches &caches) const = 0;
+    virtual element::Role_Ptr parse_role_impl(const VocabularyInfo& vocabulary, Caches &caches) const = 0;
 
 public:
     Role(const std::string &name, std::vector<std::unique_ptr<Expression>> &&children)
@@ -23,7 +23,7 @@ public:
      * Construct or retrieve the Role.
      */
     virtual element::Role_Ptr parse_role(const VocabularyInfo& vocabulary, Caches &caches) const {
-        return caches.m_role_cache->insert(parse_role_impl(vocabulary, caches)).first;
+        return parse_role_impl(vocabulary, caches);
     }
 };
 
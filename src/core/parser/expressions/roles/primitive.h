@@ -9,7 +9,7 @@ namespace dlplan::core::parser {
 
 class PrimitiveRole : public Role {
 protected:
-    std::unique_ptr<element::Role> parse_role_impl(const VocabularyInfo& vocabulary, Caches &) const override {
+    element::Role_Ptr parse_role_impl(const VocabularyInfo& vocabulary, Caches &caches) const override {
         if (m_children.size() != 3) {
             throw std::runtime_error("PrimitiveRole::parse_role_impl - number of children ("s + std::to_string(m_children.size()) + " != 3).");
         }
@@ -18,7 +18,7 @@ protected:
         int pos_1 = try_parse_number(m_children[1]->get_name());
         int pos_2 = try_parse_number(m_children[2]->get_name());
         // 2. Construct element
-        return std::make_unique<element::PrimitiveRole>(vocabulary, vocabulary.get_predicate_ref(vocabulary.get_predicate_idx(predicate_name)), pos_1, pos_2);
+        return caches.make<element::PrimitiveRole>(vocabulary, vocabulary.get_predicate_ref(vocabulary.get_predicate_idx(predicate_name)), pos_1, pos_2);
     }
 
 public:
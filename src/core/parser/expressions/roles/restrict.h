@@ -10,7 +10,7 @@ namespace dlplan::core::parser {
 
 class RestrictRole : public Role {
 protected:
-    std::unique_ptr<element::Role> parse_role_impl(const VocabularyInfo& vocabulary, Caches &cache) const override {
+    element::Role_Ptr parse_role_impl(const VocabularyInfo& vocabulary, Caches &cache) const override {
         if (m_children.size() != 2) {
             throw std::runtime_error("RestrictRole::parse_role_impl - number of children ("s + std::to_string(m_children.size()) + " != 2).");
         }
@@ -21,7 +21,7 @@ protected:
             throw std::runtime_error("RestrictRole::parse_role_impl - children are not of type Role.");
         }
         // 2. Construct element
-        return std::make_unique<element::RestrictRole>(vocabulary, role, concept);
+        return cache.make<element::RestrictRole>(vocabulary, role, concept);
     }
 
 public:
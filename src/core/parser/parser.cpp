@@ -11,11 +11,11 @@
 
 namespace dlplan::core::parser {
 
-static TokenRegexes element_token_regexes = {
-    { TokenType::COMMA, Tokenizer::build_regex(",") },
-    { TokenType::OPENING_PARENTHESIS, Tokenizer::build_regex("\\(") },
-    { TokenType::CLOSING_PARENTHESIS, Tokenizer::build_regex("\\)") },
-    { TokenType::NAME, Tokenizer::build_regex("[a-zA-Z0-9_\\-]+") },
+static const TokenRules element_token_rules = {
+    Tokenizer::build_rule(TokenType::COMMA, ","),
+    Tokenizer::build_rule(TokenType::OPENING_PARENTHESIS, "("),
+    Tokenizer::build_rule(TokenType::CLOSING_PARENTHESIS, ")"),
+    Tokenizer::build_rule(TokenType::NAME, "a-zA-Z0-9_-", "a-zA-Z0-9_-"),
 };
 
 
@@ -23,32 +23,30 @@ static TokenRegexes element_token_regexes = {
  * Parses the canonical AST from the given tokens.
  * Tokens in children are sorted lexicographically.
  */
-Expression_Ptr Parser::parse_expressions_tree(const VocabularyInfo& vocabulary_info, Tokens &tokens) const {
-    if (tokens.empty()) {
+Expression_Ptr Parser::parse_expressions_tree(const VocabularyInfo& vocabulary_info, const Tokens &tokens, std::size_t& pos) const {
+    if (pos == tokens.size()) {
         throw std::runtime_error("Parser::parse_expressions_tree - Unexpected EOF\n");
     }
-    Token token = tokens.front();
-    tokens.pop_front();
-    // std::cout << token.first << " " << token.second << std::endl;
-    if (!tokens.empty() && tokens.front().first == TokenType::OPENING_PARENTHESIS) {
+    const Token& token = tokens[pos++];
+    if (pos < tokens.size() && tokens[pos].first == TokenType::OPENING_PARENTHESIS) {
         // Consume "(".
-        tokens.pop_front();
+        ++pos;
         std::vector<Expression_Ptr> children;
-        while (!tokens.empty() && tokens.front().first != TokenType::CLOSING_PARENTHESIS) {
-            if (tokens.front().first == TokenType::COMMA) {
-                tokens.pop_front();
+        while (pos < tokens.size() && tokens[pos].first != TokenType::CLOSING_PARENTHESIS) {
+            if (tokens[pos].first == TokenType::COMMA) {
+                ++pos;
             }
-            children.push_back(parse_expressions_tree(vocabulary_info, tokens));
+            children.push_back(parse_expressions_tree(vocabulary_info, tokens, pos));
         }
         // Consume ")".
-        if (tokens.empty()) throw std::runtime_error("Parser::parse_expressions_tree - Expected ')' is missing.");
-        tokens.pop_front();
+        if (pos == tokens.size()) throw std::runtime_error("Parser::parse_expressions_tree - Expected ')' is missing.");
+        ++pos;
         // Construct an expression that can be parsed into an element if the description is correct.
-        return ExpressionFactory().make_expression(vocabulary_info, token.second, std::move(children));
+        return ExpressionFactory().make_expression(vocabulary_info, std::string(token.second), std::move(children));
     } else if (token.first == TokenType::CLOSING_PARENTHESIS) {
         throw std::runtime_error("Parser::parse_expressions_tree - Unexpected ')'");
     } else {
-        return ExpressionFactory().make_expression(vocabulary_info, token.second, {});
+        return ExpressionFactory().make_expression(vocabulary_info, std::string(token.second), {});
     }
 }
 
@@ -57,8 +55,9 @@ Parser::Parser() = default;
 Expression_Ptr Parser::parse(
     const VocabularyInfo& vocabulary_info,
     const std::string &description) const {
-    Tokens tokens = Tokenizer().tokenize(description, element_token_regexes);
-    return parse_expressions_tree(vocabulary_info, tokens);
+    Tokens tokens = Tokenizer().tokenize(description, element_token_rules);
+    std::size_t pos = 0;
+    return parse_expressions_tree(vocabulary_info, tokens, pos);
 }
 
 }
@@ -4,11 +4,21 @@
 #include <stdexcept>
 #include <sstream>
 
+#include "atom_index.h"
 #include "../utils/collections.h"
 
 
 namespace dlplan::core {
 
+static size_t compute_state_hash(const InstanceInfo* instance_info, const Index_Vec& sorted_atom_idxs) {
+    size_t seed = sorted_atom_idxs.size();
+    for (int atom_idx : sorted_atom_idxs) {
+        utils::hash_combine(seed, atom_idx);
+    }
+    utils::hash_combine(seed, instance_info);
+    return seed;
+}
+
 State::State(std::shared_ptr<const InstanceInfo> instance_info, const std::vector<Atom>& atoms, int index)
     : m_instance_info(instance_info), m_index(index) {
     if (!std::all_of(atoms.begin(), atoms.end(), [&](const auto& atom){ return instance_info->exists_atom(atom); })) {
@@ -22,22 +32,44 @@ State::State(std::shared_ptr<const InstanceInfo> instance_info, const std::vecto
         int atom_idx = atom.get_index();
         m_atom_idxs.push_back(atom_idx);
     }
+    std::sort(m_atom_idxs.begin(), m_atom_idxs.end());
+    m_hash = compute_state_hash(m_instance_info.get(), m_atom_idxs);
 }
 
-State::State(std::shared_ptr<const InstanceInfo> instance_info, const Index_Vec& atom_idxs, int index)
-    : m_instance_info(instance_info), m_atom_idxs(atom_idxs), m_index(index) {
+State::State(std::shared_ptr<const InstanceInfo> instance_info, Index_Vec atom_idxs, int index)
+    : m_instance_info(instance_info), m_atom_idxs(std::move(atom_idxs)), m_index(index) {
     const auto& atoms = instance_info->get_atoms_ref();
-    if (!std::all_of(atom_idxs.begin(), atom_idxs.end(), [&](int atom_idx){ return utils::in_bounds(atom_idx, atoms); })) {
+    if (!std::all_of(m_atom_idxs.begin(), m_atom_idxs.end(), [&](int atom_idx){ return utils::in_bounds(atom_idx, atoms); })) {
         throw std::runtime_error("State::State - atom index out of range.");
     }
-    if (!std::all_of(atom_idxs.begin(), atom_idxs.end(), [&](int atom_idx){ return !atoms[atom_idx].get_is_static(); })) {
+    if (!std::all_of(m_atom_idxs.begin(), m_atom_idxs.end(), [&](int atom_idx){ return !atoms[atom_idx].get_is_static(); })) {
         throw std::runtime_error("State::State - static atom is not allowed in State.");
     }
+    // Atom indices are usually written in order, e.g., by the state space reader.
+    if (!std::is_sorted(m_atom_idxs.begin(), m_atom_idxs.end())) {
+        std::sort(m_atom_idxs.begin(), m_atom_idxs.end());
+    }
+    m_hash = compute_state_hash(m_instance_info.get(), m_atom_idxs);
 }
 
-State::State(const State&) = default;
-
-State& State::operator=(const State&) = default;
+// The atom index is loaded atomically because another thread may be building it.
+State::State(const State& other)
+    : m_instance_info(other.m_instance_info),
+      m_atom_idxs(other.m_atom_idxs),
+      m_index(other.m_index),
+      m_hash(other.m_hash),
+      m_atom_index(std::atomic_load(&other.m_atom_index)) { }
+
+State& State::operator=(const State& other) {
+    if (this != &other) {
+        m_instance_info = other.m_instance_info;
+        m_atom_idxs = other.m_atom_idxs;
+        m_index = other.m_index;
+        m_hash = other.m_hash;
+        m_atom_index = std::atomic_load(&other.m_atom_index);
+    }
+    return *this;
+}
 
 State::State(State&& other) = default;
 
@@ -46,7 +78,9 @@ State& State::operator=(State&& other) = default;
 State::~State() = default;
 
 bool State::operator==(const State& other) const {
-    return (compute_sorted_atom_idxs() == other.compute_sorted_atom_idxs()) && (&get_instance_info_ref() == &other.get_instance_info_ref());
+    return (m_hash == other.m_hash)
+        && (m_instance_info == other.m_instance_info)
+        && (m_atom_idxs == other.m_atom_idxs);
 }
 
 bool State::operator!=(const State& other) const {
@@ -66,9 +100,20 @@ const Index_Vec& State::get_atom_idxs_ref() const {
 }
 
 Index_Vec State::compute_sorted_atom_idxs() const {
-    Index_Vec sorted_atom_idxs(m_atom_idxs);
-    std::sort(sorted_atom_idxs.begin(), sorted_atom_idxs.end());
-    return sorted_atom_idxs;
+    return m_atom_idxs;
+}
+
+const AtomIndex& State::get_atom_index_ref() const {
+    std::shared_ptr<const AtomIndex> atom_index = std::atomic_load(&m_atom_index);
+    if (!atom_index) {
+        // Threads that build the index concurrently agree on the first one stored.
+        std::shared_ptr<const AtomIndex> expected;
+        atom_index = std::make_shared<const AtomIndex>(*m_instance_info, m_atom_idxs);
+        if (!std::atomic_compare_exchange_strong(&m_atom_index, &expected, atom_index)) {
+            atom_index = expected;
+        }
+    }
+    return *atom_index;
 }
 
 int State::get_index() const {
@@ -89,13 +134,7 @@ std::string State::str() const {
 }
 
 size_t State::compute_hash() const {
-    Index_Vec sorted_atom_idxs = compute_sorted_atom_idxs();
-    size_t seed = sorted_atom_idxs.size();
-    for (int atom_idx : sorted_atom_idxs) {
-        utils::hash_combine(seed, atom_idx);
-    }
-    utils::hash_combine(seed, m_instance_info.get());
-    return seed;
+    return m_hash;
 }
 
 void State::set_index(int index) {
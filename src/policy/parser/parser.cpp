@@ -11,35 +11,33 @@
 
 namespace dlplan::policy::parser {
 
-static TokenRegexes element_token_regexes = {
-    { TokenType::COMMA, Tokenizer::build_regex(",") },
-    { TokenType::OPENING_PARENTHESIS, Tokenizer::build_regex("\\(") },
-    { TokenType::CLOSING_PARENTHESIS, Tokenizer::build_regex("\\)") },
-    { TokenType::INTEGER, Tokenizer::build_regex("[0-9]+")},
-    { TokenType::STRING, Tokenizer::build_regex("[a-zA-Z0-9_,\\)\\(\\s\\-]+", std::regex_constants::ECMAScript, "^\\s*\"(", ")\"\\s*") },
-    { TokenType::NAME, Tokenizer::build_regex(":[a-zA-Z0-9_\\-]+") },
+static const TokenRules element_token_rules = {
+    Tokenizer::build_rule(TokenType::COMMA, ","),
+    Tokenizer::build_rule(TokenType::OPENING_PARENTHESIS, "("),
+    Tokenizer::build_rule(TokenType::CLOSING_PARENTHESIS, ")"),
+    Tokenizer::build_rule(TokenType::INTEGER, "0-9", "0-9"),
+    Tokenizer::build_rule(TokenType::STRING, "a-zA-Z0-9_,)( \t\n\v\f\r-", "a-zA-Z0-9_,)( \t\n\v\f\r-", '"'),
+    Tokenizer::build_rule(TokenType::NAME, ":", "a-zA-Z0-9_-", '\0', true),
 };
 
 /**
  * Parses the canonical AST from the given tokens.
  * Tokens in children are sorted lexicographically.
  */
-Expression_Ptr Parser::parse_expressions_tree(Tokens &tokens) const {
-    if (tokens.empty()) {
+Expression_Ptr Parser::parse_expressions_tree(const Tokens &tokens, std::size_t& pos) const {
+    if (pos == tokens.size()) {
         throw std::runtime_error("Parser::parse_expressions_tree - Unexpected EOF\n");
     }
     // Consume "(".
-    Token token = tokens.front();
-    tokens.pop_front();
-    // std::cout << token.first << " " << token.second << std::endl;
+    const Token& token = tokens[pos++];
     if (token.second == "(") {
         std::vector<Expression_Ptr> children;
-        while (!tokens.empty() && tokens.front().second != ")") {
-            children.emplace_back(parse_expressions_tree(tokens));
+        while (pos < tokens.size() && tokens[pos].second != ")") {
+            children.emplace_back(parse_expressions_tree(tokens, pos));
         }
         // Consume ")".
-        if (tokens.empty()) throw std::runtime_error("Parser::parse_expressions_tree - Expected ')' is missing.");
-        tokens.pop_front();
+        if (pos == tokens.size()) throw std::runtime_error("Parser::parse_expressions_tree - Expected ')' is missing.");
+        ++pos;
         if (children.empty()) throw std::runtime_error("Parser::parse_expressions_tree - Empty list ().");
         std::string name = children.at(0)->get_name_ref();
         // Construct an expression that can be parsed into an element if the description is correct.
@@ -47,15 +45,16 @@ Expression_Ptr Parser::parse_expressions_tree(Tokens &tokens) const {
     } else if (token.second == ")") {
         throw std::runtime_error("Parser::parse_expressions_tree - Unexpected ')'");
     } else {
-        return std::make_unique<Expression>(Expression(token.second, {}));
+        return std::make_unique<Expression>(Expression(std::string(token.second), {}));
     }
 }
 
 Parser::Parser() = default;
 
 Expression_Ptr Parser::parse(const std::string& data) const {
-    Tokens tokens = Tokenizer().tokenize(data, element_token_regexes);
-    return parse_expressions_tree(tokens);
+    Tokens tokens = Tokenizer().tokenize(data, element_token_rules);
+    std::size_t pos = 0;
+    return parse_expressions_tree(tokens, pos);
 }
 
 }
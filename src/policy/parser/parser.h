@@ -22,14 +22,15 @@ enum class TokenType {
 using Token = dlplan::utils::Tokenizer<TokenType>::Token;
 using Tokens = dlplan::utils::Tokenizer<TokenType>::Tokens;
 using Tokenizer = dlplan::utils::Tokenizer<TokenType>;
-using TokenRegexes = dlplan::utils::Tokenizer<TokenType>::TokenRegexes;
+using TokenRules = dlplan::utils::Tokenizer<TokenType>::TokenRules;
 
 class Parser {
 private:
     /**
-     * Parses tokens into an abstract syntax tree.
+     * Parses the tokens starting at pos into an abstract syntax tree
+     * and advances pos behind them.
      */
-    Expression_Ptr parse_expressions_tree(Tokens &tokens) const;
+    Expression_Ptr parse_expressions_tree(const Tokens &tokens, std::size_t& pos) const;
 
 public:
     Parser();
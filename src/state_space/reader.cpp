@@ -2,7 +2,6 @@
 
 #include <iostream>
 #include <fstream>
-#include <regex>
 #include <sstream>
 
 #include "../utils/tokenizer.h"
@@ -41,20 +40,20 @@ enum class AtomTokenType {
 };
 
 
-static const std::vector<std::pair<AtomTokenType, std::regex>> atom_token_regexes = {
-    { AtomTokenType::COMMA, utils::Tokenizer<AtomTokenType>::build_regex(",") },
-    { AtomTokenType::OPENING_PARENTHESIS, utils::Tokenizer<AtomTokenType>::build_regex("\\(") },
-    { AtomTokenType::CLOSING_PARENTHESIS, utils::Tokenizer<AtomTokenType>::build_regex("\\)") },
-    { AtomTokenType::NAME, utils::Tokenizer<AtomTokenType>::build_regex("[a-zA-Z0-9_@\\-]+") },
+static const utils::Tokenizer<AtomTokenType>::TokenRules atom_token_rules = {
+    utils::Tokenizer<AtomTokenType>::build_rule(AtomTokenType::COMMA, ","),
+    utils::Tokenizer<AtomTokenType>::build_rule(AtomTokenType::OPENING_PARENTHESIS, "("),
+    utils::Tokenizer<AtomTokenType>::build_rule(AtomTokenType::CLOSING_PARENTHESIS, ")"),
+    utils::Tokenizer<AtomTokenType>::build_rule(AtomTokenType::NAME, "a-zA-Z0-9_@-", "a-zA-Z0-9_@-"),
 };
 
 
 static void parse_atom(const std::string& atom_name, InstanceInfo& instance_info, bool is_static, bool is_goal, std::vector<int>& new_atom_indices) {
-    auto tokens = utils::Tokenizer<AtomTokenType>().tokenize(atom_name, atom_token_regexes);
+    auto tokens = utils::Tokenizer<AtomTokenType>().tokenize(atom_name, atom_token_rules);
     if (tokens.size() < 3) throw std::runtime_error("parse_atom - insufficient number of tokens: " + std::to_string(tokens.size()));
     if (tokens[0].first != AtomTokenType::NAME) throw std::runtime_error("parse_atom_line - expected predicate name at position 0.");
     if (tokens[1].first != AtomTokenType::OPENING_PARENTHESIS) throw std::runtime_error("parse_atom_line - expected opening parenthesis at position 1.");
-    std::string predicate_name = tokens[0].second;
+    std::string predicate_name(tokens[0].second);
     if (is_goal) {
         predicate_name += "_g";
     }
@@ -73,10 +72,10 @@ static void parse_atom(const std::string& atom_name, InstanceInfo& instance_info
         } else if (tokens[i].first == AtomTokenType::COMMA) {
             ++i;
         } else if (tokens[i].first == AtomTokenType::NAME) {
-            object_names.push_back(tokens[i].second);
+            object_names.emplace_back(tokens[i].second);
             ++i;
         } else {
-            throw std::runtime_error("parse_atom_line - expected comma or name: " + tokens[i].second);
+            throw std::runtime_error("parse_atom_line - expected comma or name: " + std::string(tokens[i].second));
         }
     }
     if (tokens.back().first != AtomTokenType::CLOSING_PARENTHESIS) throw std::runtime_error("parse_atom_line - expected closing parenthesis.");
@@ -147,7 +146,7 @@ static std::pair<core::StatesSet, StateIndices> parse_states_file(const std::str
                 atom_indices.push_back(new_atom_index);
             }
         }
-        auto result = states.emplace(core::State(instance_info, atom_indices, state_index));
+        auto result = states.emplace(core::State(instance_info, std::move(atom_indices), state_index));
         if (!result.second) {
             throw std::runtime_error("StateSpaceGenerator::parse_states_file - tried parsing duplicate states.");
         }
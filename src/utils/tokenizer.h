@@ -1,48 +1,110 @@
 #ifndef DLPLAN_SRC_UTILS_TOKENIZER_H
 #define DLPLAN_SRC_UTILS_TOKENIZER_H
 
-#include <regex>
-#include <iostream>
+#include <bitset>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
 
 
 namespace dlplan::utils {
 
+using CharacterClass = std::bitset<256>;
+
+/**
+ * Builds a character class from characters and ranges, e.g., "a-zA-Z0-9_-".
+ * A '-' at the beginning or the end stands for itself.
+ */
+inline CharacterClass make_character_class(std::string_view characters) {
+    CharacterClass result;
+    for (std::size_t i = 0; i < characters.size(); ++i) {
+        if (i + 2 < characters.size() && characters[i + 1] == '-') {
+            for (int c = static_cast<unsigned char>(characters[i]); c <= static_cast<unsigned char>(characters[i + 2]); ++c) {
+                result.set(c);
+            }
+            i += 2;
+        } else {
+            result.set(static_cast<unsigned char>(characters[i]));
+        }
+    }
+    return result;
+}
+
+inline const CharacterClass& get_whitespace_class() {
+    static const CharacterClass whitespace = make_character_class(" \t\n\v\f\r");
+    return whitespace;
+}
+
 
 template<typename TOKEN_TYPE>
 class Tokenizer {
 public:
     Tokenizer() { }
 
-    using Token = std::pair<TOKEN_TYPE, std::string>;
-    using Tokens = std::deque<Token>;
-    using TokenRegex = std::pair<TOKEN_TYPE, std::regex>;
-    using TokenRegexes = std::vector<TokenRegex>;
+    /**
+     * Tokens view the tokenized text and are only valid as long as the text is.
+     */
+    using Token = std::pair<TOKEN_TYPE, std::string_view>;
+    using Tokens = std::vector<Token>;
 
-    static std::regex build_regex(const std::string &s, std::regex::flag_type f = std::regex_constants::ECMAScript, std::string prefix="^\\s*(", std::string suffix=")\\s*") {
-        return std::regex(prefix + s + suffix, f);
+    /**
+     * A token consists of a character from first followed by any number of characters from rest,
+     * or by at least one if rest_required is set.
+     * If quote is nonzero then the token is enclosed in quote characters that are not part of it.
+     */
+    struct TokenRule {
+        TOKEN_TYPE type;
+        CharacterClass first;
+        CharacterClass rest;
+        char quote;
+        bool rest_required;
+    };
+    using TokenRules = std::vector<TokenRule>;
+
+    static TokenRule build_rule(TOKEN_TYPE type, std::string_view first, std::string_view rest="", char quote='\0', bool rest_required=false) {
+        return TokenRule{type, make_character_class(first), make_character_class(rest), quote, rest_required};
     }
 
     /**
-     * Tokenizes a string.
+     * Tokenizes a string in a single pass.
+     * Whitespace between tokens is skipped and the first rule that matches at a position is taken.
      */
-    Tokens tokenize(const std::string& text, const TokenRegexes token_regexes) const {
-        auto start = text.begin();
-        const auto end = text.end();
-        std::smatch match;
+    Tokens tokenize(std::string_view text, const TokenRules& token_rules) const {
+        const auto& whitespace = get_whitespace_class();
+        auto is_in = [&](const CharacterClass& characters, std::size_t pos) {
+            return pos < text.size() && characters.test(static_cast<unsigned char>(text[pos]));
+        };
         Tokens tokens;
-        while (start != end) {
-            bool has_match = false;
-            for (const auto& pair : token_regexes) {
-                std::regex regex = pair.second;
-                if (std::regex_search(start, end, match, regex)) {
-                    tokens.emplace_back(pair.first, match[1].str());
-                    start += match[0].str().size();
-                    has_match = true;
+        std::size_t pos = 0;
+        while (is_in(whitespace, pos)) ++pos;
+        while (pos < text.size()) {
+            const TokenRule* match = nullptr;
+            for (const auto& rule : token_rules) {
+                std::size_t begin = rule.quote ? pos + 1 : pos;
+                if ((!rule.quote || text[pos] == rule.quote)
+                    && is_in(rule.first, begin)
+                    && (!rule.rest_required || is_in(rule.rest, begin + 1))) {
+                    match = &rule;
+                    break;
                 }
             }
-            if (!has_match) {
-                throw std::runtime_error("tokenize - unrecognized text: " + std::string(start,end));
+            if (!match) {
+                throw std::runtime_error("tokenize - unrecognized text: " + std::string(text.substr(pos)));
+            }
+            std::size_t begin = match->quote ? pos + 1 : pos;
+            std::size_t end = begin + 1;
+            while (is_in(match->rest, end)) ++end;
+            tokens.emplace_back(match->type, text.substr(begin, end - begin));
+            if (match->quote) {
+                if (end == text.size() || text[end] != match->quote) {
+                    throw std::runtime_error("tokenize - unterminated text: " + std::string(text.substr(pos)));
+                }
+                ++end;
             }
+            pos = end;
+            while (is_in(whitespace, pos)) ++pos;
         }
         return tokens;
     }
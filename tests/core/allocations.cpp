@@ -0,0 +1,74 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#include "../include/dlplan/core.h"
+
+using namespace dlplan::core;
+
+/*
+  Counts heap allocations of the test executable
+  to check that small denotations are stored inline.
+*/
+static std::atomic<std::size_t> num_allocations(0);
+
+void* operator new(std::size_t size) {
+    ++num_allocations;
+    if (void* ptr = std::malloc(size ? size : 1)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+
+TEST(DLPTests, DenotationAllocations) {
+    // Gripper with 2 rooms, 2 grippers and 4 balls.
+    std::shared_ptr<VocabularyInfo> vocabulary = std::make_shared<VocabularyInfo>();
+    vocabulary->add_predicate("at", 2);
+    vocabulary->add_predicate("at-robby", 1);
+    vocabulary->add_predicate("free", 1);
+    vocabulary->add_predicate("carry", 2);
+    vocabulary->add_predicate("ball", 1);
+    std::shared_ptr<InstanceInfo> instance = std::make_shared<InstanceInfo>(vocabulary, 0);
+    std::vector<Atom> atoms;
+    atoms.push_back(instance->add_atom("at-robby", {"rooma"}));
+    atoms.push_back(instance->add_atom("free", {"left"}));
+    atoms.push_back(instance->add_atom("carry", {"ball4", "right"}));
+    for (const auto& ball : {"ball1", "ball2", "ball3"}) {
+        atoms.push_back(instance->add_atom("at", {ball, "rooma"}));
+    }
+    for (const auto& ball : {"ball1", "ball2", "ball3", "ball4"}) {
+        instance->add_static_atom("ball", {ball});
+    }
+    instance->add_object("roomb");
+    State state(instance, atoms, 0);
+
+    SyntacticElementFactory factory(vocabulary);
+    std::vector<Concept> concepts({
+        factory.parse_concept("c_and(c_primitive(ball,0),c_not(c_some(r_primitive(carry,0,1),c_top)))"),
+        factory.parse_concept("c_some(r_inverse(r_primitive(at,0,1)),c_primitive(at-robby,0))"),
+        factory.parse_concept("c_all(r_primitive(at,0,1),c_primitive(at-robby,0))"),
+        factory.parse_concept("c_or(c_primitive(free,0),c_diff(c_top,c_primitive(ball,0)))"),
+        factory.parse_concept("c_some(r_transitive_closure(r_primitive(at,0,1)),c_bot)"),
+    });
+    // Warm up lazily initialized state, e.g., the selection of the bitset kernels.
+    for (const auto& concept : concepts) {
+        concept.evaluate(state);
+    }
+    for (const auto& concept : concepts) {
+        std::size_t num_allocations_before = num_allocations;
+        ConceptDenotation denotation = concept.evaluate(state);
+        EXPECT_EQ(num_allocations, num_allocations_before) << concept.compute_repr();
+        EXPECT_LE(denotation.count(), denotation.get_num_objects());
+    }
+}
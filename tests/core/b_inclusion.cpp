@@ -34,4 +34,10 @@ TEST(DLPTests, ConceptInclusion) {
     EXPECT_EQ(boolean.evaluate(s2), false);
     EXPECT_EQ(boolean.evaluate(s2, caches), false);
     EXPECT_EQ(boolean.evaluate({s2}, caches), false);
+
+    // Collections of states must compare the left against the right denotations.
+    EXPECT_EQ(*boolean.evaluate(States{s1, s2}, caches), BooleanDenotations({true, false}));
+    DenotationsCaches parallel_caches;
+    parallel_caches.set_num_threads(2);
+    EXPECT_EQ(*boolean.evaluate(States{s1, s2}, parallel_caches), BooleanDenotations({true, false}));
 }
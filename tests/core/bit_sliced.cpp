@@ -0,0 +1,71 @@
+#include <gtest/gtest.h>
+
+#include <random>
+
+#include "../include/dlplan/core.h"
+
+using namespace dlplan::core;
+
+
+static States sample_states(std::shared_ptr<InstanceInfo> instance, int num_states) {
+    std::mt19937 rng(0);
+    States states;
+    for (int state_idx = 0; state_idx < num_states; ++state_idx) {
+        std::vector<Atom> atoms;
+        for (int i = 0; i < 6; ++i) {
+            atoms.push_back(instance->add_atom("on", {"b" + std::to_string(rng() % 6), "b" + std::to_string(rng() % 6)}));
+            if (rng() % 2) atoms.push_back(instance->add_atom("clear", {"b" + std::to_string(i)}));
+        }
+        states.emplace_back(instance, atoms, state_idx);
+    }
+    return states;
+}
+
+TEST(DLPTests, BitSlicedDenotations) {
+    std::shared_ptr<VocabularyInfo> vocabulary = std::make_shared<VocabularyInfo>();
+    vocabulary->add_predicate("on", 2);
+    vocabulary->add_predicate("clear", 1);
+    std::shared_ptr<InstanceInfo> instance = std::make_shared<InstanceInfo>(vocabulary, 0);
+    // The last block of each position is only partially used.
+    States states = sample_states(instance, 150);
+    SyntacticElementFactory factory(vocabulary);
+    std::vector<Concept> concepts({
+        factory.parse_concept("c_and(c_primitive(clear,0),c_some(r_primitive(on,0,1),c_primitive(clear,0)))"),
+        factory.parse_concept("c_or(c_primitive(clear,0),c_projection(r_primitive(on,0,1),1))"),
+        factory.parse_concept("c_not(c_diff(c_top,c_primitive(clear,0)))"),
+        factory.parse_concept("c_or(c_bot,c_not(c_primitive(clear,0)))")
+    });
+    std::vector<Role> roles({
+        factory.parse_role("r_and(r_primitive(on,0,1),r_inverse(r_primitive(on,0,1)))"),
+        factory.parse_role("r_or(r_primitive(on,0,1),r_transitive_closure(r_primitive(on,0,1)))"),
+        factory.parse_role("r_not(r_diff(r_top,r_inverse(r_primitive(on,0,1))))")
+    });
+
+    DenotationsCaches caches;
+    int num_mismatches = 0;
+    for (const auto& concept : concepts) {
+        auto denotations = concept.evaluate_sliced(states, caches);
+        EXPECT_EQ(denotations->get_num_states(), static_cast<int>(states.size()));
+        for (std::size_t i = 0; i < states.size(); ++i) {
+            if (denotations->get_concept_denotation(i) != concept.evaluate(states[i])) ++num_mismatches;
+        }
+        EXPECT_EQ(concept.evaluate_sliced(states, caches), denotations);
+    }
+    for (const auto& role : roles) {
+        auto denotations = role.evaluate_sliced(states, caches);
+        for (std::size_t i = 0; i < states.size(); ++i) {
+            if (denotations->get_role_denotation(i) != role.evaluate(states[i])) ++num_mismatches;
+        }
+    }
+    EXPECT_EQ(num_mismatches, 0);
+
+    // Equal denotations are stored once.
+    EXPECT_EQ(factory.parse_concept("c_not(c_not(c_primitive(clear,0)))").evaluate_sliced(states, caches),
+              factory.parse_concept("c_primitive(clear,0)").evaluate_sliced(states, caches));
+    EXPECT_THROW(concepts[0].evaluate_sliced(states, caches)->get_role_denotation(0), std::runtime_error);
+
+    std::shared_ptr<InstanceInfo> other_instance = std::make_shared<InstanceInfo>(vocabulary, 1);
+    States mixed_states({states[0], State(other_instance, {other_instance->add_atom("clear", {"b0"})}, 0)});
+    DenotationsCaches other_caches;
+    EXPECT_THROW(concepts[0].evaluate_sliced(mixed_states, other_caches), std::runtime_error);
+}
@@ -0,0 +1,130 @@
+#include <gtest/gtest.h>
+
+#include <random>
+#include <thread>
+
+#include "../include/dlplan/core.h"
+
+using namespace dlplan::core;
+
+
+static States sample_states(std::shared_ptr<InstanceInfo> instance, int num_states) {
+    std::mt19937 rng(0);
+    States states;
+    for (int state_idx = 0; state_idx < num_states; ++state_idx) {
+        std::vector<Atom> atoms;
+        for (int i = 0; i < 6; ++i) {
+            atoms.push_back(instance->add_atom("on", {"b" + std::to_string(rng() % 6), "b" + std::to_string(rng() % 6)}));
+            if (rng() % 2) atoms.push_back(instance->add_atom("clear", {"b" + std::to_string(i)}));
+        }
+        states.emplace_back(instance, atoms, state_idx);
+    }
+    return states;
+}
+
+TEST(DLPTests, BoundedCaches) {
+    std::shared_ptr<VocabularyInfo> vocabulary = std::make_shared<VocabularyInfo>();
+    vocabulary->add_predicate("on", 2);
+    vocabulary->add_predicate("clear", 1);
+    std::shared_ptr<InstanceInfo> instance = std::make_shared<InstanceInfo>(vocabulary, 0);
+    States states = sample_states(instance, 5000);
+    SyntacticElementFactory factory(vocabulary);
+    Numerical numerical = factory.parse_numerical("n_count(c_some(r_transitive_closure(r_primitive(on,0,1)),c_primitive(clear,0)))");
+    Boolean boolean = factory.parse_boolean("b_empty(r_compose(r_primitive(on,0,1),r_primitive(on,0,1)))");
+    Concept concept = factory.parse_concept("c_all(r_primitive(on,0,1),c_primitive(clear,0))");
+
+    DenotationsCaches unbounded_caches;
+    EXPECT_FALSE(unbounded_caches.is_bounded());
+    const std::size_t byte_budget = 1 << 16;
+    DenotationsCaches caches(byte_budget);
+    EXPECT_TRUE(caches.is_bounded());
+    EXPECT_EQ(caches.get_byte_budget(), byte_budget);
+
+    // Collections are pinned and survive the eviction of per-state entries.
+    States first_states(states.begin(), states.begin() + 100);
+    auto pinned = concept.evaluate(first_states, caches);
+    std::vector<ConceptDenotation> pinned_values;
+    for (const auto* denotation : *pinned) pinned_values.push_back(*denotation);
+
+    std::size_t max_num_bytes = 0;
+    int num_mismatches = 0;
+    for (int repetition = 0; repetition < 2; ++repetition) {
+        for (const auto& state : states) {
+            if (numerical.evaluate(state, caches) != numerical.evaluate(state)) ++num_mismatches;
+            if (boolean.evaluate(state, caches) != boolean.evaluate(state)) ++num_mismatches;
+            if (*concept.evaluate(state, caches) != concept.evaluate(state)) ++num_mismatches;
+            numerical.evaluate(state, unbounded_caches);
+            boolean.evaluate(state, unbounded_caches);
+            concept.evaluate(state, unbounded_caches);
+            max_num_bytes = std::max(max_num_bytes, caches.compute_num_bytes());
+        }
+    }
+    EXPECT_EQ(num_mismatches, 0);
+    // A single evaluation can exceed the budget by the pages it allocates.
+    EXPECT_LE(max_num_bytes, 2 * byte_budget);
+    EXPECT_GT(unbounded_caches.compute_num_bytes(), 4 * byte_budget);
+
+    // Denotations of single states are not evicted while the caches are pinned.
+    {
+        auto pin = caches.pin();
+        const ConceptDenotation* first = concept.evaluate(states[0], caches);
+        ConceptDenotation first_value = *first;
+        for (const auto& state : states) numerical.evaluate(state, caches);
+        EXPECT_GT(caches.compute_num_bytes(), byte_budget);
+        EXPECT_EQ(*first, first_value);
+        EXPECT_EQ(concept.evaluate(states[0], caches), first);
+    }
+    numerical.evaluate(states[0], caches);
+    EXPECT_LE(caches.compute_num_bytes(), 2 * byte_budget);
+
+    EXPECT_EQ(concept.evaluate(first_states, caches), pinned);
+    for (std::size_t i = 0; i < pinned_values.size(); ++i) {
+        EXPECT_EQ(*(*pinned)[i], pinned_values[i]);
+    }
+}
+
+TEST(DLPTests, BoundedCachesConcurrent) {
+    std::shared_ptr<VocabularyInfo> vocabulary = std::make_shared<VocabularyInfo>();
+    vocabulary->add_predicate("on", 2);
+    vocabulary->add_predicate("clear", 1);
+    std::shared_ptr<InstanceInfo> instance = std::make_shared<InstanceInfo>(vocabulary, 0);
+    States states = sample_states(instance, 1000);
+    SyntacticElementFactory factory(vocabulary);
+    Numerical numerical = factory.parse_numerical("n_count(c_some(r_primitive(on,0,1),c_primitive(clear,0)))");
+
+    DenotationsCaches caches(1 << 14);
+    std::vector<std::thread> threads;
+    std::vector<int> num_mismatches(4, 0);
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&, t]() {
+            for (std::size_t i = 0; i < states.size(); ++i) {
+                const auto& state = states[(i * (t + 1)) % states.size()];
+                if (numerical.evaluate(state, caches) != numerical.evaluate(state)) ++num_mismatches[t];
+            }
+        });
+    }
+    for (auto& thread : threads) thread.join();
+    for (int t = 0; t < 4; ++t) {
+        EXPECT_EQ(num_mismatches[t], 0);
+    }
+
+    // Pinned results of one thread survive the evaluations of other threads.
+    Concept concept = factory.parse_concept("c_some(r_primitive(on,0,1),c_primitive(clear,0))");
+    std::vector<int> num_changed(4, 0);
+    threads.clear();
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&, t]() {
+            for (std::size_t i = t; i < states.size(); i += 4) {
+                auto pin = caches.pin();
+                const ConceptDenotation* denotation = concept.evaluate(states[i], caches);
+                ConceptDenotation value = *denotation;
+                for (std::size_t j = 0; j < 8; ++j) numerical.evaluate(states[(i + j * 97) % states.size()], caches);
+                if (*denotation != value) ++num_changed[t];
+            }
+        });
+    }
+    for (auto& thread : threads) thread.join();
+    for (int t = 0; t < 4; ++t) {
+        EXPECT_EQ(num_changed[t], 0);
+    }
+}
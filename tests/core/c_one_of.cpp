@@ -25,3 +25,26 @@ TEST(DLPTests, ConceptOneOf) {
     EXPECT_EQ(concept.evaluate(state, caches)->to_sorted_vector(), Index_Vec({0}));
     EXPECT_EQ(concept.evaluate({state}, caches)->to_sorted_vector(), Index_Vec({0}));
 }
+
+TEST(DLPTests, ConceptOneOfConstantMapping) {
+    std::shared_ptr<VocabularyInfo> vocabulary = std::make_shared<VocabularyInfo>();
+    vocabulary->add_predicate("concept", 1);
+    Constant c0 = vocabulary->add_constant("A");
+    std::shared_ptr<InstanceInfo> instance = std::make_shared<InstanceInfo>(vocabulary, 0);
+    Atom a0 = instance->add_atom("concept", {"B"});
+    Atom a1 = instance->add_atom("concept", {"A"});
+    // The constant is added after the object with its name.
+    Constant c1 = vocabulary->add_constant("B");
+    Constant c2 = vocabulary->add_constant("C");
+    EXPECT_EQ(instance->get_constant_object_idx(c0), 1);
+    EXPECT_EQ(instance->get_constant_object_idx(c1), 0);
+    EXPECT_EQ(instance->get_constant_object_idx(c2), -1);
+
+    State state(instance, {a0, a1}, 0);
+    SyntacticElementFactory factory(vocabulary);
+    DenotationsCaches caches;
+    EXPECT_EQ(factory.parse_concept("c_one_of(B)").evaluate(state).to_sorted_vector(), Index_Vec({0}));
+    Concept concept = factory.parse_concept("c_one_of(C)");
+    EXPECT_THROW(concept.evaluate(state), std::runtime_error);
+    EXPECT_THROW(concept.evaluate(state, caches), std::runtime_error);
+}
@@ -34,3 +34,33 @@ TEST(DLPTests, ConceptPrimitive) {
     EXPECT_EQ(concept3.evaluate(state, caches)->to_sorted_vector(), Index_Vec({2, 5}));
     EXPECT_EQ(concept3.evaluate({state}, caches)->to_sorted_vector(), Index_Vec({2, 5}));
 }
+
+TEST(DLPTests, ConceptPrimitiveStaticAtoms) {
+    using Pairs = std::vector<std::pair<int, int>>;
+    std::shared_ptr<VocabularyInfo> vocabulary = std::make_shared<VocabularyInfo>();
+    vocabulary->add_predicate("on", 2);
+    vocabulary->add_predicate("clear", 1);
+    vocabulary->add_predicate("smaller", 2);
+    std::shared_ptr<InstanceInfo> instance = std::make_shared<InstanceInfo>(vocabulary, 0);
+    Atom a0 = instance->add_atom("on", {"A", "B"});
+    Atom a1 = instance->add_atom("clear", {"A"});
+    Atom a2 = instance->add_atom("on", {"B", "C"});
+    instance->add_static_atom("smaller", {"A", "B"});
+
+    State state(instance, {a0, a1, a2}, 0);
+
+    SyntacticElementFactory factory(vocabulary);
+    Concept concept1 = factory.parse_concept("c_primitive(on,1)");
+    Concept concept2 = factory.parse_concept("c_primitive(smaller,0)");
+    Role role = factory.parse_role("r_primitive(smaller,1,0)");
+    EXPECT_EQ(concept1.evaluate(state).to_sorted_vector(), Index_Vec({1, 2}));
+    EXPECT_EQ(concept2.evaluate(state).to_sorted_vector(), Index_Vec({0}));
+    EXPECT_EQ(role.evaluate(state).to_sorted_vector(), Pairs({{1, 0}}));
+
+    // Adding objects and static atoms updates the static atoms of existing states.
+    instance->add_static_atom("smaller", {"C", "D"});
+    EXPECT_EQ(concept2.evaluate(state).to_sorted_vector(), Index_Vec({0, 2}));
+    EXPECT_EQ(concept2.evaluate(state).get_num_objects(), 4);
+    EXPECT_EQ(role.evaluate(state).to_sorted_vector(), Pairs({{1, 0}, {3, 2}}));
+    EXPECT_EQ(concept1.evaluate(state).to_sorted_vector(), Index_Vec({1, 2}));
+}
@@ -0,0 +1,63 @@
+#include <gtest/gtest.h>
+
+#include <random>
+#include <thread>
+
+#include "../include/dlplan/core.h"
+
+using namespace dlplan::core;
+
+
+TEST(DLPTests, ConcurrentCaches) {
+    std::shared_ptr<VocabularyInfo> vocabulary = std::make_shared<VocabularyInfo>();
+    vocabulary->add_predicate("on", 2);
+    vocabulary->add_predicate("clear", 1);
+    std::shared_ptr<InstanceInfo> instance = std::make_shared<InstanceInfo>(vocabulary, 0);
+    std::mt19937 rng(0);
+    States states;
+    for (int state_idx = 0; state_idx < 200; ++state_idx) {
+        std::vector<Atom> atoms;
+        for (int i = 0; i < 6; ++i) {
+            atoms.push_back(instance->add_atom("on", {"b" + std::to_string(rng() % 6), "b" + std::to_string(rng() % 6)}));
+            if (rng() % 2) atoms.push_back(instance->add_atom("clear", {"b" + std::to_string(i)}));
+        }
+        states.emplace_back(instance, atoms, state_idx);
+    }
+    SyntacticElementFactory factory(vocabulary);
+    std::vector<Numerical> numericals({
+        factory.parse_numerical("n_count(c_primitive(clear,0))"),
+        factory.parse_numerical("n_count(c_some(r_primitive(on,0,1),c_primitive(clear,0)))"),
+        factory.parse_numerical("n_count(r_transitive_closure(r_primitive(on,0,1)))"),
+        factory.parse_numerical("n_concept_distance(c_primitive(clear,0),r_primitive(on,0,1),c_not(c_primitive(clear,0)))")
+    });
+    std::vector<Boolean> booleans({
+        factory.parse_boolean("b_empty(c_all(r_primitive(on,0,1),c_primitive(clear,0)))"),
+        factory.parse_boolean("b_empty(r_compose(r_primitive(on,0,1),r_primitive(on,0,1)))")
+    });
+
+    // All threads evaluate all elements in a different order of states.
+    DenotationsCaches caches;
+    std::vector<std::thread> threads;
+    std::vector<int> num_mismatches(8, 0);
+    for (int t = 0; t < 8; ++t) {
+        threads.emplace_back([&, t]() {
+            for (std::size_t i = 0; i < states.size(); ++i) {
+                const auto& state = states[(i * (t + 1)) % states.size()];
+                for (const auto& numerical : numericals) {
+                    if (numerical.evaluate(state, caches) != numerical.evaluate(state)) ++num_mismatches[t];
+                }
+                for (const auto& boolean : booleans) {
+                    if (boolean.evaluate(state, caches) != boolean.evaluate(state)) ++num_mismatches[t];
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) thread.join();
+    for (int t = 0; t < 8; ++t) {
+        EXPECT_EQ(num_mismatches[t], 0);
+    }
+    auto denotations = numericals[1].evaluate(states, caches);
+    for (std::size_t i = 0; i < states.size(); ++i) {
+        EXPECT_EQ((*denotations)[i], numericals[1].evaluate(states[i]));
+    }
+}
@@ -1,6 +1,8 @@
 
 #include <gtest/gtest.h>
 
+#include "utils.h"
+
 #include "../include/dlplan/core.h"
 
 using namespace dlplan::core;
@@ -23,6 +25,12 @@ TEST(DLPTests, SyntacticErrorHandling) {
     ASSERT_THROW(factory.parse_numerical("n_count(on(4))"), std::runtime_error);
     ASSERT_THROW(factory.parse_numerical("n_count(on(-1))"), std::runtime_error);
     ASSERT_THROW(factory.parse_numerical("n_count(on_g(0))"), std::runtime_error);
+
+    ASSERT_THROW(factory.parse_concept("c_primitive(on,0);"), std::runtime_error);
+    ASSERT_THROW(factory.parse_concept("c_primitive(on,0"), std::runtime_error);
+    ASSERT_THROW(factory.parse_concept(""), std::runtime_error);
+    // Whitespace between tokens is ignored.
+    EXPECT_EQ(factory.parse_concept(" c_some( r_primitive(on,0,1) ,\tc_primitive(on, 1))\n").compute_repr(), "c_some(r_primitive(on,0,1),c_primitive(on,1))");
 }
 
 
@@ -62,4 +70,164 @@ TEST(DLPTests, InstanceCreation) {
     EXPECT_EQ(state3, state4);
     EXPECT_EQ(numerical.evaluate(state3), 0);
     EXPECT_EQ(numerical.evaluate(state4), 0);
+
+    // States are equal independent of the order of atoms.
+    State state5(instance, {a3, a0});
+    State state6(instance, {3, 0});
+    EXPECT_EQ(state5.get_atom_idxs_ref(), Index_Vec({0, 3}));
+    EXPECT_EQ(state1, state5);
+    EXPECT_EQ(state1, state6);
+    EXPECT_EQ(state1.compute_hash(), state6.compute_hash());
+    EXPECT_NE(state1, state3);
+    EXPECT_EQ(StatesSet({state1, state2, state5, state6}).size(), 1);
+}
+
+
+TEST(DLPTests, DenotationIterators) {
+    // The role denotation starts in the sparse representation.
+    const int num_objects = num_large_objects;
+    ConceptDenotation concept_denot(num_objects);
+    Index_Vec objects({0, 1, 63, 64, 69});
+    for (int object : objects) concept_denot.insert(object);
+    Index_Vec iterated_objects;
+    for (int object : concept_denot) iterated_objects.push_back(object);
+    EXPECT_EQ(iterated_objects, objects);
+    EXPECT_EQ(concept_denot.to_sorted_vector(), objects);
+
+    RoleDenotation role_denot(num_objects);
+    IndexPair_Vec pairs({{0, 0}, {0, 69}, {1, 0}, {13, 42}, {68, 1}, {69, 69}});
+    for (const auto& pair : pairs) role_denot.insert(pair);
+    IndexPair_Vec iterated_pairs;
+    for (const auto& pair : role_denot) iterated_pairs.push_back(pair);
+    EXPECT_EQ(iterated_pairs, pairs);
+    EXPECT_EQ(role_denot.to_sorted_vector(), pairs);
+    RoleDenotation bulk_role_denot(num_objects);
+    bulk_role_denot.insert_unsorted([&](auto insert) {
+        for (auto it = pairs.rbegin(); it != pairs.rend(); ++it) insert(it->first, it->second);
+        insert(pairs[0].first, pairs[0].second);
+    });
+    EXPECT_EQ(bulk_role_denot, role_denot);
+    RoleDenotation empty_role_denot(num_objects);
+    EXPECT_TRUE(empty_role_denot.begin() == empty_role_denot.end());
+
+    // The same pairs in the dense representation.
+    RoleDenotation dense_role_denot(num_objects);
+    dense_role_denot.set();
+    for (const auto& pair : RoleDenotation(dense_role_denot)) {
+        if (!role_denot.contains(pair)) dense_role_denot.erase(pair);
+    }
+    EXPECT_TRUE(dense_role_denot.get_bitset_ref().is_dense());
+    EXPECT_FALSE(role_denot.get_bitset_ref().is_dense());
+    EXPECT_EQ(dense_role_denot, role_denot);
+    EXPECT_EQ(dense_role_denot.compute_hash(), role_denot.compute_hash());
+    iterated_pairs.clear();
+    for (const auto& pair : dense_role_denot) iterated_pairs.push_back(pair);
+    EXPECT_EQ(iterated_pairs, pairs);
+}
+
+TEST(DLPTests, PerStateMapping) {
+    PerStateMapping<int, -1> mapping;
+    EXPECT_EQ(mapping.find(0, 0, 0), -1);
+    mapping.insert(0, 5, 2, 42);
+    mapping.insert(-1, -1, 0, 7);
+    EXPECT_EQ(mapping.find(0, 5, 2), 42);
+    EXPECT_EQ(mapping.find(-1, -1, 0), 7);
+    EXPECT_EQ(mapping.find(0, 4, 2), -1);
+    EXPECT_EQ(mapping.find(0, 5, 1), -1);
+    EXPECT_EQ(mapping.find(1, 5, 2), -1);
+    EXPECT_EQ(mapping.find(-2, 5, 2), -1);
+    EXPECT_THROW(mapping.insert(0, -2, 0, 1), std::runtime_error);
+}
+
+TEST(DLPTests, AtomTable) {
+    std::shared_ptr<VocabularyInfo> vocabulary = std::make_shared<VocabularyInfo>();
+    Predicate p0 = vocabulary->add_predicate("on", 2);
+    Predicate p1 = vocabulary->add_predicate("on_g", 2);
+    auto instance = std::make_unique<InstanceInfo>(vocabulary, 0);
+    Atom a0 = instance->add_atom("on", {"A", "B"});
+    Atom a1 = instance->add_atom("on", {"B", "C"});
+    EXPECT_EQ(instance->add_atom("on", {"A", "B"}).get_index(), a0.get_index());
+    Atom a2 = instance->add_static_atom("on_g", {"C", "A"});
+    EXPECT_THROW(instance->add_static_atom("on_g", {"C", "A"}), std::runtime_error);
+    EXPECT_EQ(a1.get_name_ref(), "on(B,C)");
+    EXPECT_EQ(a1.get_predicate_ref(), p0);
+    EXPECT_EQ(a1.get_object_ref(1).get_name_ref(), "C");
+    EXPECT_EQ(a2.get_objects().size(), 2);
+    EXPECT_EQ(a2.get_objects()[0].get_name_ref(), "C");
+    EXPECT_TRUE(a2.get_is_static());
+    EXPECT_EQ(instance->get_atom_idx("on(B,C)"), 1);
+    const auto& atom_table = instance->get_atom_table_ref();
+    EXPECT_EQ(atom_table.size(), 2);
+    EXPECT_EQ(atom_table.get_predicate_idx(1), p0.get_index());
+    EXPECT_EQ(atom_table.get_arity(1), 2);
+    EXPECT_EQ(atom_table.get_object_idxs(1)[0], 1);
+    EXPECT_EQ(atom_table.get_object_idxs(1)[1], 2);
+
+    // Atoms of copies view the copy.
+    InstanceInfo copy(*instance);
+    instance.reset();
+    EXPECT_EQ(copy.get_atom_ref(1).get_name_ref(), "on(B,C)");
+    EXPECT_EQ(copy.get_static_atoms_ref()[0].get_name_ref(), "on_g(C,A)");
+    EXPECT_EQ(copy.get_atom_idx("on(A,B)"), 0);
+    InstanceInfo moved(std::move(copy));
+    EXPECT_EQ(moved.get_atom_ref(0).get_object_ref(1).get_name_ref(), "B");
+    EXPECT_EQ(moved.add_atom("on", {"C", "C"}).get_index(), 2);
+
+    // Objects of other instances are rejected.
+    InstanceInfo other(vocabulary, 1);
+    other.add_objects({"X", "Y", "Z", "W"});
+    EXPECT_THROW(moved.add_atom(p0, {other.get_object_ref(0), moved.get_object_ref(0)}), std::runtime_error);
+    EXPECT_THROW(moved.add_static_atom(p1, {moved.get_object_ref(0), other.get_object_ref(3)}), std::runtime_error);
+    EXPECT_EQ(moved.add_atom(p0, {moved.get_object_ref(1), moved.get_object_ref(0)}).get_name_ref(), "on(B,A)");
+
+    // Atoms stay valid after their instance is released.
+    auto released = std::make_shared<InstanceInfo>(vocabulary, 0);
+    Atom a3 = released->add_atom("on", {"A", "B"});
+    released.reset();
+    EXPECT_EQ(a3.get_name_ref(), "on(A,B)");
+    EXPECT_EQ(a3.get_predicate_ref(), p0);
+    EXPECT_EQ(a3.get_object_ref(1).get_name_ref(), "B");
+}
+
+TEST(DLPTests, BulkInstanceCreation) {
+    std::shared_ptr<VocabularyInfo> vocabulary = std::make_shared<VocabularyInfo>();
+    Predicate p0 = vocabulary->add_predicate("on", 2);
+    Predicate p1 = vocabulary->add_predicate("clear", 1);
+    Predicate p2 = vocabulary->add_predicate("on_g", 2);
+    std::shared_ptr<InstanceInfo> instance = std::make_shared<InstanceInfo>(vocabulary, 0);
+    EXPECT_EQ(instance->add_objects({"A", "B", "C"}), 0);
+    EXPECT_EQ(instance->add_atoms({0, 1, 0}, {0, 1, 2, 1, 2}), 0);
+    EXPECT_EQ(instance->add_static_atoms({2}, {1, 0}), 0);
+    EXPECT_THROW(instance->add_atoms({0}, {0}), std::runtime_error);
+    EXPECT_THROW(instance->add_atoms({1}, {3}), std::runtime_error);
+    EXPECT_THROW(instance->add_atoms({3}, {}), std::runtime_error);
+    EXPECT_THROW(instance->add_objects({"A"}), std::runtime_error);
+
+    // Names are computed on demand and atoms added by name find the bulk atoms.
+    EXPECT_EQ(instance->get_atoms_ref().size(), 3);
+    EXPECT_EQ(instance->get_atom_ref(2).get_name_ref(), "on(B,C)");
+    EXPECT_EQ(instance->get_atom_idx("clear(C)"), 1);
+    EXPECT_EQ(instance->add_atom("on", {"A", "B"}).get_index(), 0);
+    EXPECT_EQ(instance->add_atom("on", {"C", "A"}).get_index(), 3);
+    EXPECT_EQ(instance->add_atoms({1}, {0}), 4);
+    EXPECT_EQ(instance->get_atom_ref(4).get_name_ref(), "clear(A)");
+    EXPECT_EQ(instance->get_static_atoms_ref()[0].get_name_ref(), "on_g(B,A)");
+    EXPECT_EQ(State(instance, Index_Vec({0, 1}), 0).str(), "{on(A,B), clear(C)}");
+
+    SyntacticElementFactory factory(vocabulary);
+    State state(instance, Index_Vec({0, 2, 4}), 0);
+    EXPECT_EQ(factory.parse_concept("c_primitive(on,1)").evaluate(state).to_sorted_vector(), Index_Vec({1, 2}));
+    EXPECT_EQ(factory.parse_concept("c_primitive(on_g,0)").evaluate(state).to_sorted_vector(), Index_Vec({1}));
+
+    // Duplicates are detected when the names are computed.
+    std::shared_ptr<InstanceInfo> duplicates = std::make_shared<InstanceInfo>(vocabulary, 1);
+    duplicates->add_objects({"A", "B"});
+    duplicates->add_atom("clear", {"A"});
+    duplicates->add_atoms({1, 1}, {1, 0});
+    EXPECT_THROW(duplicates->get_atom_idx("clear(B)"), std::runtime_error);
+    EXPECT_THROW(duplicates->get_atom_ref(1).get_name_ref(), std::runtime_error);
+    std::shared_ptr<InstanceInfo> batch_duplicates = std::make_shared<InstanceInfo>(vocabulary, 2);
+    batch_duplicates->add_objects({"A"});
+    batch_duplicates->add_atoms({1, 1}, {0, 0});
+    EXPECT_THROW(batch_duplicates->add_atom("clear", {"A"}), std::runtime_error);
 }
@@ -0,0 +1,338 @@
+#include <gtest/gtest.h>
+
+#include <random>
+#include <set>
+
+#include "../include/dlplan/utils/dynamic_bitset.h"
+#include "../include/dlplan/utils/hybrid_bitset.h"
+
+using namespace dlplan::utils;
+
+
+static std::vector<std::uint64_t> random_blocks(std::size_t num_blocks, std::mt19937_64& rng) {
+    std::vector<std::uint64_t> result(num_blocks);
+    for (auto& block : result) block = rng();
+    return result;
+}
+
+
+TEST(DLPTests, DynamicBitsetKernels) {
+    std::mt19937_64 rng(0);
+    const auto& reference = kernels::get_kernels(kernels::InstructionSet::SCALAR);
+    const auto& best = kernels::get_kernels();
+    // Include lengths that do not fill a whole vector register.
+    for (std::size_t num_blocks : {0, 1, 3, 4, 7, 8, 9, 17, 64, 65}) {
+        auto left = random_blocks(num_blocks, rng);
+        auto right = random_blocks(num_blocks, rng);
+        auto zeros = std::vector<std::uint64_t>(num_blocks, 0);
+
+        EXPECT_EQ(best.count(left.data(), num_blocks), reference.count(left.data(), num_blocks));
+        EXPECT_EQ(best.intersects(left.data(), right.data(), num_blocks), reference.intersects(left.data(), right.data(), num_blocks));
+        EXPECT_FALSE(best.intersects(left.data(), zeros.data(), num_blocks));
+        EXPECT_TRUE(best.is_subset_of(zeros.data(), left.data(), num_blocks));
+        EXPECT_TRUE(best.is_subset_of(left.data(), left.data(), num_blocks));
+        EXPECT_EQ(best.is_subset_of(left.data(), right.data(), num_blocks), reference.is_subset_of(left.data(), right.data(), num_blocks));
+        EXPECT_TRUE(best.none(zeros.data(), num_blocks));
+        EXPECT_EQ(best.none(left.data(), num_blocks), reference.none(left.data(), num_blocks));
+        EXPECT_TRUE(best.equal(left.data(), left.data(), num_blocks));
+        EXPECT_EQ(best.equal(left.data(), right.data(), num_blocks), reference.equal(left.data(), right.data(), num_blocks));
+
+        auto expected = left;
+        auto result = left;
+        reference.bitwise_and(expected.data(), right.data(), num_blocks);
+        best.bitwise_and(result.data(), right.data(), num_blocks);
+        EXPECT_EQ(result, expected);
+        reference.bitwise_or(expected.data(), right.data(), num_blocks);
+        best.bitwise_or(result.data(), right.data(), num_blocks);
+        EXPECT_EQ(result, expected);
+        reference.bitwise_andnot(expected.data(), left.data(), num_blocks);
+        best.bitwise_andnot(result.data(), left.data(), num_blocks);
+        EXPECT_EQ(result, expected);
+        reference.bitwise_not(expected.data(), num_blocks);
+        best.bitwise_not(result.data(), num_blocks);
+        EXPECT_EQ(result, expected);
+    }
+}
+
+
+TEST(DLPTests, DynamicBitsetOperations) {
+    // 1000 bits span 16 blocks such that the dispatched kernels are used.
+    DynamicBitset<std::uint64_t> left(1000);
+    DynamicBitset<std::uint64_t> right(1000);
+    for (std::size_t pos = 0; pos < 1000; pos += 3) left.set(pos);
+    for (std::size_t pos = 0; pos < 1000; pos += 6) right.set(pos);
+    EXPECT_EQ(left.count(), 334);
+    EXPECT_EQ(right.count(), 167);
+    EXPECT_TRUE(right.is_subset_of(left));
+    EXPECT_FALSE(left.is_subset_of(right));
+    EXPECT_TRUE(left.intersects(right));
+
+    auto complement = left;
+    ~complement;
+    // The unused bits of the last block must remain zero.
+    EXPECT_EQ(complement.count(), 666);
+    EXPECT_FALSE(complement.intersects(left));
+
+    auto difference = left;
+    difference -= right;
+    EXPECT_EQ(difference.count(), 167);
+    difference |= right;
+    EXPECT_EQ(difference, left);
+    difference &= complement;
+    EXPECT_TRUE(difference.none());
+}
+
+
+TEST(DLPTests, DynamicBitsetBitScan) {
+    DynamicBitset<std::uint64_t> bitset(300);
+    EXPECT_EQ(bitset.find_first(), DynamicBitset<std::uint64_t>::npos);
+    std::vector<std::size_t> positions({0, 5, 63, 64, 190, 299});
+    for (std::size_t pos : positions) bitset.set(pos);
+    std::vector<std::size_t> scanned;
+    for (std::size_t pos = bitset.find_first(); pos != DynamicBitset<std::uint64_t>::npos; pos = bitset.find_next(pos)) {
+        scanned.push_back(pos);
+    }
+    EXPECT_EQ(scanned, positions);
+    std::vector<std::size_t> visited;
+    bitset.for_each_set_bit([&](std::size_t pos) { visited.push_back(pos); });
+    EXPECT_EQ(visited, positions);
+    int num_nonzero_blocks = 0;
+    bitset.for_each_nonzero_block([&](std::size_t, std::uint64_t) { ++num_nonzero_blocks; });
+    EXPECT_EQ(num_nonzero_blocks, 4);
+}
+
+
+TEST(DLPTests, DynamicBitsetRanges) {
+    std::mt19937 rng(0);
+    DynamicBitset<std::uint64_t> source(700);
+    for (std::size_t pos = 0; pos < 700; ++pos) {
+        if (rng() % 2) source.set(pos);
+    }
+    // Offsets and lengths that are not multiples of the block size.
+    for (std::size_t len : {1, 13, 64, 70, 129}) {
+        for (std::size_t source_pos : {0, 5, 64, 100}) {
+            for (std::size_t target_pos : {0, 3, 63, 128, 131}) {
+                DynamicBitset<std::uint64_t> target(300);
+                target.set(target_pos + len / 2);
+                auto expected = target;
+                for (std::size_t offset = 0; offset < len; ++offset) {
+                    if (source.test(source_pos + offset)) expected.set(target_pos + offset);
+                }
+                target.or_range(target_pos, source, source_pos, len);
+                EXPECT_EQ(target, expected);
+            }
+        }
+    }
+}
+
+template<typename Bitset>
+static std::vector<std::size_t> to_positions(const Bitset& bitset) {
+    std::vector<std::size_t> result;
+    bitset.for_each_set_bit([&](std::size_t pos) { result.push_back(pos); });
+    return result;
+}
+
+
+TEST(DLPTests, DynamicBitsetInlineStorage) {
+    // Compare the fixed-size kernels on inline storage against heap storage.
+    using InlineBitset = DynamicBitset<std::uint64_t, 4096>;
+    using HeapBitset = DynamicBitset<std::uint64_t, 0>;
+    std::mt19937 rng(0);
+    for (std::size_t num_bits : {0, 1, 63, 64, 65, 200, 256, 257, 1000, 4096, 4097}) {
+        InlineBitset inline_left(num_bits), inline_right(num_bits);
+        HeapBitset heap_left(num_bits), heap_right(num_bits);
+        EXPECT_EQ(inline_left.is_inline(), num_bits <= 4096);
+        EXPECT_EQ(heap_left.is_inline(), num_bits == 0);
+        for (std::size_t pos = 0; pos < num_bits; ++pos) {
+            if (rng() % 3 == 0) { inline_left.set(pos); heap_left.set(pos); }
+            if (rng() % 3 == 0) { inline_right.set(pos); heap_right.set(pos); }
+        }
+        EXPECT_EQ(inline_left.count(), heap_left.count());
+        EXPECT_EQ(inline_left.none(), heap_left.none());
+        EXPECT_EQ(inline_left.intersects(inline_right), heap_left.intersects(heap_right));
+        EXPECT_EQ(inline_left.is_subset_of(inline_right), heap_left.is_subset_of(heap_right));
+        EXPECT_EQ(inline_left == inline_right, heap_left == heap_right);
+
+        auto inline_result = inline_left;
+        auto heap_result = heap_left;
+        inline_result &= inline_right;
+        heap_result &= heap_right;
+        EXPECT_EQ(to_positions(inline_result), to_positions(heap_result));
+        inline_result |= inline_right;
+        heap_result |= heap_right;
+        EXPECT_EQ(to_positions(inline_result), to_positions(heap_result));
+        inline_result -= inline_left;
+        heap_result -= heap_left;
+        EXPECT_EQ(to_positions(inline_result), to_positions(heap_result));
+        ~inline_result;
+        ~heap_result;
+        EXPECT_EQ(to_positions(inline_result), to_positions(heap_result));
+        // The complement must not leave bits behind the used blocks.
+        EXPECT_EQ(inline_result.count(), heap_result.count());
+    }
+}
+
+
+TEST(DLPTests, DynamicBitsetCopyAndMove) {
+    DynamicBitset<std::uint64_t> small(100);
+    DynamicBitset<std::uint64_t> large(1000);
+    small.set(99);
+    large.set(999);
+    ASSERT_TRUE(small.is_inline());
+    ASSERT_FALSE(large.is_inline());
+
+    auto copy = small;
+    EXPECT_EQ(copy, small);
+    copy = large;
+    EXPECT_EQ(copy, large);
+    copy = small;
+    EXPECT_EQ(copy, small);
+
+    auto moved_small = std::move(copy);
+    EXPECT_EQ(moved_small, small);
+    auto moved_large = large;
+    auto target = std::move(moved_large);
+    EXPECT_EQ(target, large);
+    target = std::move(moved_small);
+    EXPECT_EQ(target, small);
+    EXPECT_TRUE(target.test(99));
+}
+
+static std::set<std::size_t> to_set(const HybridBitset<>& bitset) {
+    std::set<std::size_t> result;
+    bitset.for_each_set_bit([&](std::size_t pos) { result.insert(pos); });
+    return result;
+}
+
+
+TEST(DLPTests, HybridBitsetRepresentation) {
+    HybridBitset<> small(HybridBitset<>::MIN_SPARSE_BITS - 1);
+    EXPECT_TRUE(small.is_dense());
+    HybridBitset<> large(10000);
+    EXPECT_FALSE(large.is_dense());
+    // Exceeding a density of 1/32 switches to the dense representation.
+    for (std::size_t pos = 0; pos < 10000 / 32; ++pos) large.set(pos * 7);
+    EXPECT_FALSE(large.is_dense());
+    large.set(1);
+    EXPECT_TRUE(large.is_dense());
+    // Operations that leave a density of at most 1/64 switch back.
+    HybridBitset<> mask(10000);
+    for (std::size_t pos = 0; pos < 10; ++pos) mask.set(pos * 7);
+    large &= mask;
+    EXPECT_FALSE(large.is_dense());
+    EXPECT_EQ(large, mask);
+    ~large;
+    EXPECT_TRUE(large.is_dense());
+    EXPECT_EQ(large.count(), 9990);
+    large.reset();
+    EXPECT_FALSE(large.is_dense());
+    EXPECT_TRUE(large.none());
+}
+
+
+TEST(DLPTests, HybridBitsetOperations) {
+    // Compare all combinations of representations against std::set.
+    std::mt19937 rng(0);
+    const std::size_t num_bits = 8192;
+    for (double left_density : {0.001, 0.2}) {
+        for (double right_density : {0.001, 0.2}) {
+            HybridBitset<> left(num_bits);
+            HybridBitset<> right(num_bits);
+            std::bernoulli_distribution left_distribution(left_density);
+            std::bernoulli_distribution right_distribution(right_density);
+            for (std::size_t pos = 0; pos < num_bits; ++pos) {
+                if (left_distribution(rng)) left.set(pos);
+                if (right_distribution(rng)) right.set(pos);
+            }
+            const auto left_set = to_set(left);
+            const auto right_set = to_set(right);
+            EXPECT_EQ(left.count(), static_cast<int>(left_set.size()));
+
+            std::set<std::size_t> expected;
+            std::set_intersection(left_set.begin(), left_set.end(), right_set.begin(), right_set.end(), std::inserter(expected, expected.end()));
+            auto result = left;
+            result &= right;
+            EXPECT_EQ(to_set(result), expected);
+            EXPECT_EQ(left.intersects(right), !expected.empty());
+            EXPECT_TRUE(result.is_subset_of(left));
+            EXPECT_TRUE(result.is_subset_of(right));
+
+            expected.clear();
+            std::set_union(left_set.begin(), left_set.end(), right_set.begin(), right_set.end(), std::inserter(expected, expected.end()));
+            result = left;
+            result |= right;
+            EXPECT_EQ(to_set(result), expected);
+            EXPECT_TRUE(left.is_subset_of(result));
+
+            expected.clear();
+            std::set_difference(left_set.begin(), left_set.end(), right_set.begin(), right_set.end(), std::inserter(expected, expected.end()));
+            result = left;
+            result -= right;
+            EXPECT_EQ(to_set(result), expected);
+            EXPECT_FALSE(result.intersects(right));
+
+            result = left;
+            ~result;
+            EXPECT_EQ(result.count() + left.count(), static_cast<int>(num_bits));
+            EXPECT_FALSE(result.intersects(left));
+
+            std::vector<std::size_t> scanned;
+            for (std::size_t pos = left.find_first(); pos != HybridBitset<>::npos; pos = left.find_next(pos)) {
+                scanned.push_back(pos);
+            }
+            EXPECT_EQ(scanned, std::vector<std::size_t>(left_set.begin(), left_set.end()));
+        }
+    }
+}
+
+
+TEST(DLPTests, HybridBitsetEqualityAndHashing) {
+    HybridBitset<> dense(10000);
+    HybridBitset<> sparse(10000);
+    dense.set();
+    // Erasing elements does not change the representation.
+    for (std::size_t pos = 0; pos < 10000; ++pos) {
+        if (pos % 1000 != 0) dense.reset(pos);
+    }
+    for (std::size_t pos = 0; pos < 10000; pos += 1000) sparse.set(pos);
+    ASSERT_TRUE(dense.is_dense());
+    ASSERT_FALSE(sparse.is_dense());
+    EXPECT_EQ(dense, sparse);
+    EXPECT_EQ(sparse, dense);
+    EXPECT_EQ(dense.compute_hash(), sparse.compute_hash());
+    EXPECT_TRUE(dense.is_subset_of(sparse));
+    sparse.reset(0);
+    EXPECT_NE(dense, sparse);
+    EXPECT_FALSE(dense.is_subset_of(sparse));
+}
+
+
+TEST(DLPTests, HybridBitsetUnorderedInsertion) {
+    std::mt19937 rng(0);
+    std::uniform_int_distribution<std::size_t> distribution(0, 99999);
+    std::vector<std::size_t> positions;
+    for (int i = 0; i < 1000; ++i) positions.push_back(distribution(rng));
+    positions.push_back(positions.front());
+    HybridBitset<> expected(100000);
+    HybridBitset<> unordered(100000);
+    for (auto pos : positions) expected.set(pos);
+    for (auto pos : positions) unordered.set_unordered(pos);
+    unordered.sort_unordered();
+    EXPECT_FALSE(unordered.is_dense());
+    EXPECT_EQ(unordered.get_sparse_ref(), expected.get_sparse_ref());
+    // Insertion into a nonempty bitset that switches to the dense representation.
+    positions.clear();
+    for (int i = 0; i < 5000; ++i) positions.push_back(distribution(rng));
+    for (auto pos : positions) expected.set(pos);
+    for (auto pos : positions) unordered.set_unordered(pos);
+    unordered.sort_unordered();
+    EXPECT_TRUE(unordered.is_dense());
+    EXPECT_EQ(unordered, expected);
+    // Positions set in increasing order are appended.
+    HybridBitset<> appended(100000);
+    for (std::size_t pos = 0; pos < 100000; pos += 100) appended.set(pos);
+    appended.set(50);
+    appended.set(50);
+    EXPECT_EQ(appended.count(), 1001);
+    EXPECT_TRUE(std::is_sorted(appended.get_sparse_ref().begin(), appended.get_sparse_ref().end()));
+}
@@ -0,0 +1,105 @@
+#include <gtest/gtest.h>
+
+#include <thread>
+
+#include "../include/dlplan/core.h"
+
+using namespace dlplan::core;
+
+
+TEST(DLPTests, StructuralInterning) {
+    std::shared_ptr<VocabularyInfo> vocabulary = std::make_shared<VocabularyInfo>();
+    Predicate p0 = vocabulary->add_predicate("on", 2);
+    Predicate p1 = vocabulary->add_predicate("clear", 1);
+    Predicate p2 = vocabulary->add_predicate("handempty", 0);
+    Constant c0 = vocabulary->add_constant("a");
+    SyntacticElementFactory factory(vocabulary);
+
+    Concept on = factory.make_primitive_concept(p0, 0);
+    Concept clear = factory.make_primitive_concept(p1, 0);
+    EXPECT_EQ(factory.make_primitive_concept(p0, 0).get_element(), on.get_element());
+    EXPECT_NE(factory.make_primitive_concept(p0, 1).get_element(), on.get_element());
+    EXPECT_EQ(factory.parse_concept("c_primitive(on,0)").get_element(), on.get_element());
+
+    // The children of commutative elements are ordered by their construction.
+    Concept and_1 = factory.make_and_concept(on, clear);
+    Concept and_2 = factory.make_and_concept(clear, on);
+    EXPECT_EQ(and_1.get_element(), and_2.get_element());
+    EXPECT_EQ(and_1.compute_repr(), "c_and(c_primitive(on,0),c_primitive(clear,0))");
+    EXPECT_EQ(factory.parse_concept("c_and(c_primitive(on,0),c_primitive(clear,0))").get_element(), and_1.get_element());
+    Concept diff_1 = factory.make_diff_concept(on, clear);
+    Concept diff_2 = factory.make_diff_concept(clear, on);
+    EXPECT_NE(diff_1.get_element(), diff_2.get_element());
+
+    // Elements of the same class over different types of children are distinct.
+    Role role = factory.make_primitive_role(p0, 0, 1);
+    Numerical count_concept = factory.make_count_numerical(on);
+    Numerical count_role = factory.make_count_numerical(role);
+    EXPECT_NE(count_concept.get_element(), count_role.get_element());
+    EXPECT_EQ(count_role.compute_repr(), "n_count(r_primitive(on,0,1))");
+    EXPECT_EQ(factory.make_one_of_concept(c0).get_element(), factory.parse_concept("c_one_of(a)").get_element());
+    EXPECT_EQ(factory.make_nullary_boolean(p2).get_element(), factory.parse_boolean("b_nullary(handempty)").get_element());
+
+    // A failed construction does not leave an entry behind.
+    EXPECT_THROW(factory.make_primitive_concept(p1, 1), std::runtime_error);
+    EXPECT_THROW(factory.make_primitive_concept(p1, 1), std::runtime_error);
+
+    // Released elements are removed and constructed again.
+    std::weak_ptr<const element::Concept> released = factory.make_not_concept(on).get_element();
+    EXPECT_TRUE(released.expired());
+    Concept not_on = factory.make_not_concept(on);
+    EXPECT_EQ(not_on.compute_repr(), "c_not(c_primitive(on,0))");
+}
+
+TEST(DLPTests, StructuralInterningAcrossFactories) {
+    std::shared_ptr<VocabularyInfo> vocabulary = std::make_shared<VocabularyInfo>();
+    vocabulary->add_predicate("p", 1);
+    vocabulary->add_predicate("q", 1);
+    SyntacticElementFactory factory_1(vocabulary);
+    SyntacticElementFactory factory_2(vocabulary);
+
+    // Both primitive concepts have the first index in their factory.
+    Concept q = factory_1.parse_concept("c_primitive(q,0)");
+    Concept not_q = factory_1.make_not_concept(q);
+    Concept p = factory_2.parse_concept("c_primitive(p,0)");
+    Concept not_p = factory_1.make_not_concept(p);
+    EXPECT_NE(not_p.get_element(), not_q.get_element());
+    EXPECT_EQ(not_p.compute_repr(), "c_not(c_primitive(p,0))");
+    EXPECT_EQ(factory_1.make_not_concept(p).get_element(), not_p.get_element());
+}
+
+TEST(DLPTests, ConcurrentStructuralInterning) {
+    std::shared_ptr<VocabularyInfo> vocabulary = std::make_shared<VocabularyInfo>();
+    vocabulary->add_predicate("on", 2);
+    vocabulary->add_predicate("clear", 1);
+    SyntacticElementFactory factory(vocabulary);
+    std::vector<std::string> reprs({
+        "n_count(c_primitive(clear,0))",
+        "n_count(c_some(r_primitive(on,0,1),c_primitive(clear,0)))",
+        "n_count(r_transitive_closure(r_primitive(on,0,1)))",
+        "n_concept_distance(c_primitive(clear,0),r_primitive(on,0,1),c_not(c_primitive(clear,0)))"
+    });
+
+    // Threads keep the elements of their first round alive,
+    // while later rounds construct and release further elements concurrently.
+    std::vector<std::vector<Numerical>> kept(8);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 8; ++t) {
+        threads.emplace_back([&, t]() {
+            for (int round = 0; round < 200; ++round) {
+                for (const auto& repr : reprs) {
+                    Numerical numerical = factory.parse_numerical(repr);
+                    Numerical released = factory.parse_numerical("n_count(c_not(c_some(r_inverse(r_primitive(on,0,1)),c_primitive(clear,0))))");
+                    if (round == 0) kept[t].push_back(numerical);
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) thread.join();
+    for (int t = 0; t < 8; ++t) {
+        for (std::size_t i = 0; i < reprs.size(); ++i) {
+            EXPECT_EQ(kept[t][i].get_element(), kept[0][i].get_element());
+            EXPECT_EQ(kept[t][i].compute_repr(), reprs[i]);
+        }
+    }
+}
@@ -0,0 +1,155 @@
+#include <gtest/gtest.h>
+
+#include <random>
+
+#include "../include/dlplan/core.h"
+
+using namespace dlplan::core;
+
+
+static States sample_states(std::shared_ptr<InstanceInfo> instance, int num_objects, int num_states) {
+    std::mt19937 rng(instance->get_index());
+    States states;
+    for (int state_idx = 0; state_idx < num_states; ++state_idx) {
+        std::vector<Atom> atoms;
+        for (int i = 0; i < num_objects; ++i) {
+            atoms.push_back(instance->add_atom("on", {"b" + std::to_string(rng() % num_objects), "b" + std::to_string(rng() % num_objects)}));
+            if (rng() % 2) atoms.push_back(instance->add_atom("clear", {"b" + std::to_string(i)}));
+        }
+        if (rng() % 2) atoms.push_back(instance->add_atom("handempty", {}));
+        states.emplace_back(instance, atoms, state_idx);
+    }
+    return states;
+}
+
+TEST(DLPTests, FeatureProgram) {
+    std::shared_ptr<VocabularyInfo> vocabulary = std::make_shared<VocabularyInfo>();
+    vocabulary->add_predicate("on", 2);
+    vocabulary->add_predicate("clear", 1);
+    vocabulary->add_predicate("handempty", 0);
+    vocabulary->add_constant("b0");
+    // Instances with different numbers of objects reuse the registers of the program.
+    std::shared_ptr<InstanceInfo> small_instance = std::make_shared<InstanceInfo>(vocabulary, 0);
+    std::shared_ptr<InstanceInfo> large_instance = std::make_shared<InstanceInfo>(vocabulary, 1);
+    States states = sample_states(small_instance, 4, 50);
+    States large_states = sample_states(large_instance, 9, 50);
+    states.insert(states.end(), large_states.begin(), large_states.end());
+
+    SyntacticElementFactory factory(vocabulary);
+    std::vector<Numerical> numericals({
+        factory.parse_numerical("n_count(c_some(r_primitive(on,0,1),c_primitive(clear,0)))"),
+        factory.parse_numerical("n_count(r_transitive_closure(r_primitive(on,0,1)))"),
+        factory.parse_numerical("n_count(r_transitive_reflexive_closure(r_or(r_primitive(on,0,1),r_inverse(r_primitive(on,0,1)))))"),
+        factory.parse_numerical("n_count(c_projection(r_and(r_top,r_not(r_primitive(on,0,1))),1))"),
+        factory.parse_numerical("n_count(r_diff(r_compose(r_primitive(on,0,1),r_primitive(on,0,1)),r_identity(c_top)))"),
+        factory.parse_numerical("n_count(c_or(c_one_of(b0),c_diff(c_bot,c_primitive(clear,0))))"),
+        factory.parse_numerical("n_concept_distance(c_one_of(b0),r_primitive(on,0,1),c_primitive(clear,0))"),
+        factory.parse_numerical("n_sum_concept_distance(c_primitive(clear,0),r_primitive(on,0,1),c_not(c_primitive(clear,0)))"),
+        factory.parse_numerical("n_role_distance(r_primitive(on,0,1),r_primitive(on,0,1),r_restrict(r_primitive(on,0,1),c_primitive(clear,0)))"),
+        factory.parse_numerical("n_sum_role_distance(r_primitive(on,0,1),r_primitive(on,0,1),r_inverse(r_primitive(on,0,1)))")
+    });
+    std::vector<Boolean> booleans({
+        factory.parse_boolean("b_empty(c_all(r_primitive(on,0,1),c_primitive(clear,0)))"),
+        factory.parse_boolean("b_empty(c_and(c_equal(r_primitive(on,0,1),r_inverse(r_primitive(on,0,1))),c_subset(r_primitive(on,0,1),r_top)))"),
+        factory.parse_boolean("b_inclusion(c_primitive(clear,0),c_some(r_primitive(on,0,1),c_primitive(clear,0)))"),
+        factory.parse_boolean("b_nullary(handempty)")
+    });
+
+    FeatureProgram program(booleans, numericals);
+    int num_mismatches = 0;
+    for (const auto& state : states) {
+        program.evaluate(state);
+        for (std::size_t i = 0; i < booleans.size(); ++i) {
+            if (program.get_boolean_value(i) != booleans[i].evaluate(state)) ++num_mismatches;
+        }
+        for (std::size_t i = 0; i < numericals.size(); ++i) {
+            if (program.get_numerical_value(i) != numericals[i].evaluate(state)) ++num_mismatches;
+        }
+    }
+    EXPECT_EQ(num_mismatches, 0);
+    EXPECT_THROW(program.get_boolean_value(booleans.size()), std::runtime_error);
+    EXPECT_THROW(program.get_numerical_value(-1), std::runtime_error);
+}
+
+TEST(DLPTests, FeatureProgramSharing) {
+    std::shared_ptr<VocabularyInfo> vocabulary = std::make_shared<VocabularyInfo>();
+    vocabulary->add_predicate("on", 2);
+    vocabulary->add_predicate("clear", 1);
+    SyntacticElementFactory factory(vocabulary);
+    Numerical numerical_1 = factory.parse_numerical("n_count(c_some(r_primitive(on,0,1),c_primitive(clear,0)))");
+    Numerical numerical_2 = factory.parse_numerical("n_count(c_all(r_primitive(on,0,1),c_primitive(clear,0)))");
+    Boolean boolean = factory.parse_boolean("b_empty(c_some(r_primitive(on,0,1),c_primitive(clear,0)))");
+
+    // r_primitive(on,0,1), c_primitive(clear,0) and c_some(...) are compiled once.
+    FeatureProgram program({boolean}, {numerical_1, numerical_2, numerical_1});
+    EXPECT_EQ(program.get_num_instructions(), 7);
+
+    std::shared_ptr<VocabularyInfo> other_vocabulary = std::make_shared<VocabularyInfo>();
+    SyntacticElementFactory other_factory(other_vocabulary);
+    other_vocabulary->add_predicate("clear", 1);
+    Boolean other_boolean = other_factory.parse_boolean("b_empty(c_primitive(clear,0))");
+    EXPECT_THROW(FeatureProgram({boolean, other_boolean}, {}), std::runtime_error);
+}
+
+TEST(DLPTests, FeatureProgramIncremental) {
+    std::shared_ptr<VocabularyInfo> vocabulary = std::make_shared<VocabularyInfo>();
+    vocabulary->add_predicate("on", 2);
+    vocabulary->add_predicate("clear", 1);
+    vocabulary->add_predicate("handempty", 0);
+    vocabulary->add_constant("b0");
+    std::shared_ptr<InstanceInfo> instance = std::make_shared<InstanceInfo>(vocabulary, 0);
+    std::shared_ptr<InstanceInfo> other_instance = std::make_shared<InstanceInfo>(vocabulary, 1);
+    States other_states = sample_states(other_instance, 7, 1);
+    std::vector<Atom> atoms;
+    for (int i = 0; i < 6; ++i) {
+        for (int j = 0; j < 6; ++j) atoms.push_back(instance->add_atom("on", {"b" + std::to_string(i), "b" + std::to_string(j)}));
+        atoms.push_back(instance->add_atom("clear", {"b" + std::to_string(i)}));
+    }
+    atoms.push_back(instance->add_atom("handempty", {}));
+
+    SyntacticElementFactory factory(vocabulary);
+    std::vector<Numerical> numericals({
+        factory.parse_numerical("n_count(c_some(r_primitive(on,0,1),c_primitive(clear,0)))"),
+        factory.parse_numerical("n_count(r_transitive_closure(r_primitive(on,0,1)))"),
+        factory.parse_numerical("n_concept_distance(c_one_of(b0),r_primitive(on,0,1),c_primitive(clear,0))")
+    });
+    std::vector<Boolean> booleans({
+        factory.parse_boolean("b_empty(c_and(c_primitive(clear,0),c_top))"),
+        factory.parse_boolean("b_nullary(handempty)")
+    });
+    FeatureProgram program(booleans, numericals);
+
+    // A random walk that adds or deletes one atom per step.
+    std::mt19937 rng(0);
+    std::vector<bool> contained(atoms.size(), false);
+    int num_mismatches = 0;
+    for (int step = 0; step < 300; ++step) {
+        int atom_idx = rng() % atoms.size();
+        contained[atom_idx] = !contained[atom_idx];
+        std::vector<Atom> state_atoms;
+        for (std::size_t i = 0; i < atoms.size(); ++i) {
+            if (contained[i]) state_atoms.push_back(atoms[i]);
+        }
+        State state(instance, state_atoms, step);
+        if (step % 100 == 50) program.evaluate(other_states[0]);
+        program.evaluate_incrementally(state);
+        for (std::size_t i = 0; i < booleans.size(); ++i) {
+            if (program.get_boolean_value(i) != booleans[i].evaluate(state)) ++num_mismatches;
+        }
+        for (std::size_t i = 0; i < numericals.size(); ++i) {
+            if (program.get_numerical_value(i) != numericals[i].evaluate(state)) ++num_mismatches;
+        }
+        EXPECT_LE(program.get_num_executed_instructions(), program.get_num_instructions());
+    }
+    EXPECT_EQ(num_mismatches, 0);
+
+    // Only the nullary boolean reads handempty.
+    State state(instance, {atoms[0], atoms[6]}, 0);
+    program.evaluate(state);
+    EXPECT_EQ(program.get_num_executed_instructions(), program.get_num_instructions());
+    program.evaluate_incrementally(State(instance, {atoms[0], atoms[6], atoms.back()}, 1));
+    EXPECT_EQ(program.get_num_executed_instructions(), 1);
+    EXPECT_TRUE(program.get_boolean_value(1));
+    program.evaluate_incrementally(State(instance, {atoms[0], atoms[6], atoms.back()}, 2));
+    EXPECT_EQ(program.get_num_executed_instructions(), 0);
+}
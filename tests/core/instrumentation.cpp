@@ -0,0 +1,63 @@
+#include <gtest/gtest.h>
+
+#include "../include/dlplan/core.h"
+
+using namespace dlplan::core;
+
+
+TEST(DLPTests, Instrumentation) {
+    std::shared_ptr<VocabularyInfo> vocabulary = std::make_shared<VocabularyInfo>();
+    vocabulary->add_predicate("on", 2);
+    vocabulary->add_predicate("clear", 1);
+    std::shared_ptr<InstanceInfo> instance = std::make_shared<InstanceInfo>(vocabulary, 0);
+    Atom a0 = instance->add_atom("on", {"A", "B"});
+    Atom a1 = instance->add_atom("clear", {"A"});
+    States states({State(instance, {a0, a1}, 0), State(instance, {a0}, 1)});
+    SyntacticElementFactory factory(vocabulary);
+    Numerical numerical = factory.parse_numerical("n_count(c_some(r_primitive(on,0,1),c_primitive(clear,0)))");
+
+    DenotationsCaches caches;
+    for (int repetition = 0; repetition < 3; ++repetition) {
+        for (const auto& state : states) {
+            numerical.evaluate(state, caches);
+        }
+    }
+    numerical.evaluate(states, caches);
+    std::string table = caches.compute_statistics_table();
+    std::string json = caches.compute_statistics_json();
+#ifdef DLPLAN_INSTRUMENTATION
+    // The numerical is evaluated 6 times for single states and once for the collection.
+    EXPECT_NE(json.find("{\"type\": \"numerical\", \"repr\": \"n_count(c_some(r_primitive(on,0,1),c_primitive(clear,0)))\", "
+                        "\"calls\": 7, \"hits\": 4, \"misses\": 3"), std::string::npos);
+    // Subelements are only evaluated on misses of their parents.
+    EXPECT_NE(json.find("{\"type\": \"role\", \"repr\": \"r_primitive(on,0,1)\", \"calls\": 3, \"hits\": 0, \"misses\": 3"), std::string::npos);
+    EXPECT_NE(table.find("c_primitive(clear,0)"), std::string::npos);
+#else
+    EXPECT_EQ(json, "[]");
+    EXPECT_EQ(table.find("c_primitive"), std::string::npos);
+#endif
+}
+
+TEST(DLPTests, SlicedInstrumentation) {
+    std::shared_ptr<VocabularyInfo> vocabulary = std::make_shared<VocabularyInfo>();
+    vocabulary->add_predicate("on", 2);
+    vocabulary->add_predicate("clear", 1);
+    std::shared_ptr<InstanceInfo> instance = std::make_shared<InstanceInfo>(vocabulary, 0);
+    Atom a0 = instance->add_atom("on", {"A", "B"});
+    Atom a1 = instance->add_atom("clear", {"A"});
+    States states({State(instance, {a0, a1}, 0), State(instance, {a0}, 1)});
+    SyntacticElementFactory factory(vocabulary);
+    Concept concept = factory.parse_concept("c_not(c_primitive(clear,0))");
+
+    DenotationsCaches caches;
+    concept.evaluate_sliced(states, caches);
+    concept.evaluate_sliced(states, caches);
+    std::string json = caches.compute_statistics_json();
+#ifdef DLPLAN_INSTRUMENTATION
+    EXPECT_NE(json.find("{\"type\": \"concept\", \"repr\": \"c_not(c_primitive(clear,0))\", \"calls\": 2, \"hits\": 1, \"misses\": 1"), std::string::npos);
+    // Elements without a bit-sliced implementation additionally evaluate the collection of states.
+    EXPECT_NE(json.find("{\"type\": \"concept\", \"repr\": \"c_primitive(clear,0)\", \"calls\": 2, \"hits\": 0, \"misses\": 2"), std::string::npos);
+#else
+    EXPECT_EQ(json, "[]");
+#endif
+}
@@ -0,0 +1,48 @@
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../include/dlplan/utils/interning_pool.h"
+
+using namespace dlplan::utils;
+
+
+TEST(DLPTests, InterningPool) {
+    InterningPool<std::string> pool;
+    std::vector<std::string*> pointers;
+    // Insert enough values to allocate several slabs.
+    for (int i = 0; i < 10000; ++i) {
+        auto result = pool.insert(std::to_string(i) + std::string(30, 'x'));
+        EXPECT_TRUE(result.second);
+        pointers.push_back(result.first);
+    }
+    EXPECT_EQ(pool.size(), 10000);
+    // Duplicates return the stored value and previously returned pointers remain valid.
+    for (int i = 0; i < 10000; ++i) {
+        auto result = pool.insert(std::to_string(i) + std::string(30, 'x'));
+        EXPECT_FALSE(result.second);
+        EXPECT_EQ(result.first, pointers[i]);
+        EXPECT_EQ(*pointers[i], std::to_string(i) + std::string(30, 'x'));
+    }
+    EXPECT_EQ(pool.size(), 10000);
+    // Moving the pool keeps the stored values in place.
+    InterningPool<std::string> other(std::move(pool));
+    auto result = other.insert("0" + std::string(30, 'x'));
+    EXPECT_FALSE(result.second);
+    EXPECT_EQ(result.first, pointers[0]);
+    EXPECT_EQ(other.size(), 10000);
+}
+
+TEST(DLPTests, InterningPoolDestroysValues) {
+    auto value = std::make_shared<int>(0);
+    {
+        InterningPool<std::shared_ptr<int>> pool;
+        pool.insert(std::shared_ptr<int>(value));
+        pool.insert(std::shared_ptr<int>(value));
+        EXPECT_EQ(pool.size(), 1);
+        EXPECT_EQ(value.use_count(), 2);
+    }
+    EXPECT_EQ(value.use_count(), 1);
+}
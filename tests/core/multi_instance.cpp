@@ -51,4 +51,12 @@ TEST(DLPTests, MultiInstance) {
     EXPECT_EQ(numerical.evaluate(state2), 3);
     // Shortest distance in union of graphs reduces to 2
     EXPECT_EQ(numerical.evaluate(state), 2);
+
+    // Cached denotations are kept apart per instance.
+    DenotationsCaches caches;
+    for (int i = 0; i < 2; ++i) {
+        EXPECT_EQ(numerical.evaluate(state1, caches), 3);
+        EXPECT_EQ(numerical.evaluate(state2, caches), 3);
+        EXPECT_EQ(numerical.evaluate(state, caches), 2);
+    }
 }
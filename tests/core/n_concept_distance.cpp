@@ -1,11 +1,16 @@
+#include <deque>
 #include <limits>
 
 #include <gtest/gtest.h>
 
+#include "utils.h"
+
 #include "../include/dlplan/core.h"
 
 using namespace dlplan::core;
 
+static const int INF = std::numeric_limits<int>::max();
+
 
 TEST(DLPTests, NumericalConceptDistance) {
     // Add predicates
@@ -52,3 +57,51 @@ TEST(DLPTests, NumericalConceptDistance) {
     EXPECT_EQ(numerical3.evaluate(state, caches), std::numeric_limits<int>::max());
     EXPECT_EQ(numerical3.evaluate({state}, caches), std::numeric_limits<int>::max());
 }
+
+
+TEST(DLPTests, NumericalConceptDistanceLarge) {
+    const int num_objects = num_large_objects;
+    for (double density : {0.01, 0.05, 0.3}) {
+        std::shared_ptr<VocabularyInfo> vocabulary = std::make_shared<VocabularyInfo>();
+        vocabulary->add_predicate("conn", 2);
+        vocabulary->add_predicate("start", 1);
+        vocabulary->add_predicate("end", 1);
+        std::shared_ptr<InstanceInfo> instance = construct_large_instance_info(vocabulary);
+        std::vector<Atom> atoms;
+        std::vector<std::vector<int>> successors(num_objects);
+        for (const auto& edge : add_random_graph_atoms(*instance, "conn", density, 0, atoms)) {
+            successors[edge.first].push_back(edge.second);
+        }
+        std::vector<int> sources({3, 40});
+        std::vector<int> targets({1, 17, 64, 69});
+        for (int source : sources) atoms.push_back(instance->add_atom("start", {large_object_name(source)}));
+        for (int target : targets) atoms.push_back(instance->add_atom("end", {large_object_name(target)}));
+        State state(instance, atoms, 0);
+
+        std::vector<int> distances(num_objects, INF);
+        std::deque<int> queue;
+        for (int source : sources) {
+            distances[source] = 0;
+            queue.push_back(source);
+        }
+        while (!queue.empty()) {
+            int node = queue.front();
+            queue.pop_front();
+            for (int successor : successors[node]) {
+                if (distances[successor] == INF) {
+                    distances[successor] = distances[node] + 1;
+                    queue.push_back(successor);
+                }
+            }
+        }
+        int expected = INF;
+        for (int target : targets) expected = std::min(expected, distances[target]);
+
+        SyntacticElementFactory factory(vocabulary);
+        DenotationsCaches caches;
+        Numerical numerical = factory.parse_numerical("n_concept_distance(c_primitive(start,0),r_primitive(conn,0,1),c_primitive(end,0))");
+        EXPECT_EQ(numerical.evaluate(state), expected);
+        EXPECT_EQ(numerical.evaluate(state, caches), expected);
+        EXPECT_EQ((*numerical.evaluate(States{state}, caches))[0], expected);
+    }
+}
@@ -2,10 +2,14 @@
 
 #include <gtest/gtest.h>
 
+#include "utils.h"
+
 #include "../include/dlplan/core.h"
 
 using namespace dlplan::core;
 
+static const int INF = std::numeric_limits<int>::max();
+
 
 TEST(DLPTests, NumericalSumRoleDistance) {
     // Add predicates
@@ -58,3 +62,51 @@ TEST(DLPTests, NumericalSumRoleDistance) {
     EXPECT_EQ(numerical3.evaluate(state, caches), std::numeric_limits<int>::max());
     EXPECT_EQ(numerical3.evaluate({state}, caches), std::numeric_limits<int>::max());
 }
+
+
+TEST(DLPTests, NumericalSumRoleDistanceLarge) {
+    const int num_objects = num_large_objects;
+    for (double density : {0.01, 0.05, 0.3}) {
+        std::shared_ptr<VocabularyInfo> vocabulary = std::make_shared<VocabularyInfo>();
+        vocabulary->add_predicate("conn", 2);
+        vocabulary->add_predicate("start", 2);
+        vocabulary->add_predicate("end", 2);
+        std::shared_ptr<InstanceInfo> instance = construct_large_instance_info(vocabulary);
+        std::vector<Atom> atoms;
+        std::vector<std::vector<int>> distances(num_objects, std::vector<int>(num_objects, INF));
+        for (int i = 0; i < num_objects; ++i) distances[i][i] = 0;
+        for (const auto& edge : add_random_graph_atoms(*instance, "conn", density, 0, atoms)) {
+            distances[edge.first][edge.second] = std::min(distances[edge.first][edge.second], 1);
+        }
+        // Properties 0 and 1 share the source 5, property 2 has two sources.
+        std::vector<std::pair<int, int>> from({{0, 5}, {1, 5}, {2, 7}, {2, 30}});
+        std::vector<std::pair<int, int>> to({{0, 66}, {1, 12}, {1, 50}, {2, 69}});
+        for (const auto& pair : from) atoms.push_back(instance->add_atom("start", {large_object_name(pair.first), large_object_name(pair.second)}));
+        for (const auto& pair : to) atoms.push_back(instance->add_atom("end", {large_object_name(pair.first), large_object_name(pair.second)}));
+        State state(instance, atoms, 0);
+        for (int k = 0; k < num_objects; ++k) {
+            for (int i = 0; i < num_objects; ++i) {
+                for (int j = 0; j < num_objects; ++j) {
+                    if (distances[i][k] != INF && distances[k][j] != INF) {
+                        distances[i][j] = std::min(distances[i][j], distances[i][k] + distances[k][j]);
+                    }
+                }
+            }
+        }
+        int expected = 0;
+        for (const auto& source : from) {
+            int min_distance = INF;
+            for (const auto& target : to) {
+                if (source.first == target.first) min_distance = std::min(min_distance, distances[source.second][target.second]);
+            }
+            expected = (expected == INF || min_distance == INF) ? INF : expected + min_distance;
+        }
+
+        SyntacticElementFactory factory(vocabulary);
+        DenotationsCaches caches;
+        Numerical numerical = factory.parse_numerical("n_sum_role_distance(r_primitive(start,0,1),r_primitive(conn,0,1),r_primitive(end,0,1))");
+        EXPECT_EQ(numerical.evaluate(state), expected);
+        EXPECT_EQ(numerical.evaluate(state, caches), expected);
+        EXPECT_EQ((*numerical.evaluate(States{state}, caches))[0], expected);
+    }
+}
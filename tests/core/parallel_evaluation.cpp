@@ -0,0 +1,59 @@
+#include <gtest/gtest.h>
+
+#include <random>
+
+#include "../include/dlplan/core.h"
+
+using namespace dlplan::core;
+
+
+TEST(DLPTests, ParallelEvaluation) {
+    std::shared_ptr<VocabularyInfo> vocabulary = std::make_shared<VocabularyInfo>();
+    vocabulary->add_predicate("on", 2);
+    vocabulary->add_predicate("clear", 1);
+    std::shared_ptr<InstanceInfo> instance = std::make_shared<InstanceInfo>(vocabulary, 0);
+    std::mt19937 rng(0);
+    States states;
+    for (int state_idx = 0; state_idx < 500; ++state_idx) {
+        std::vector<Atom> atoms;
+        for (int i = 0; i < 6; ++i) {
+            atoms.push_back(instance->add_atom("on", {"b" + std::to_string(rng() % 6), "b" + std::to_string(rng() % 6)}));
+            if (rng() % 2) atoms.push_back(instance->add_atom("clear", {"b" + std::to_string(i)}));
+        }
+        states.emplace_back(instance, atoms, state_idx);
+    }
+    SyntacticElementFactory factory(vocabulary);
+    Concept concept = factory.parse_concept("c_all(r_primitive(on,0,1),c_primitive(clear,0))");
+    Concept double_negation = factory.parse_concept("c_not(c_not(c_all(r_primitive(on,0,1),c_primitive(clear,0))))");
+    Role role = factory.parse_role("r_transitive_closure(r_primitive(on,0,1))");
+    Numerical numerical = factory.parse_numerical("n_concept_distance(c_primitive(clear,0),r_primitive(on,0,1),c_not(c_primitive(clear,0)))");
+    Boolean boolean = factory.parse_boolean("b_inclusion(c_primitive(clear,0),c_some(r_primitive(on,0,1),c_top))");
+
+    DenotationsCaches serial_caches;
+    EXPECT_EQ(serial_caches.get_num_threads(), 1);
+    DenotationsCaches parallel_caches;
+    parallel_caches.set_num_threads(4);
+    EXPECT_EQ(parallel_caches.get_num_threads(), 4);
+    EXPECT_THROW(parallel_caches.set_num_threads(0), std::runtime_error);
+
+    auto serial_concepts = concept.evaluate(states, serial_caches);
+    auto parallel_concepts = concept.evaluate(states, parallel_caches);
+    auto serial_roles = role.evaluate(states, serial_caches);
+    auto parallel_roles = role.evaluate(states, parallel_caches);
+    auto serial_numericals = numerical.evaluate(states, serial_caches);
+    auto parallel_numericals = numerical.evaluate(states, parallel_caches);
+    auto serial_booleans = boolean.evaluate(states, serial_caches);
+    auto parallel_booleans = boolean.evaluate(states, parallel_caches);
+    EXPECT_EQ(*serial_numericals, *parallel_numericals);
+    EXPECT_EQ(*serial_booleans, *parallel_booleans);
+    for (std::size_t i = 0; i < states.size(); ++i) {
+        EXPECT_EQ(*(*serial_concepts)[i], *(*parallel_concepts)[i]);
+        EXPECT_EQ(*(*serial_roles)[i], *(*parallel_roles)[i]);
+        EXPECT_EQ(*(*parallel_concepts)[i], concept.evaluate(states[i]));
+        EXPECT_EQ(*(*parallel_roles)[i], role.evaluate(states[i]));
+        EXPECT_EQ((*parallel_numericals)[i], numerical.evaluate(states[i]));
+        EXPECT_EQ(static_cast<bool>((*parallel_booleans)[i]), boolean.evaluate(states[i]));
+    }
+    // Equal collections are still interned once.
+    EXPECT_EQ(double_negation.evaluate(states, parallel_caches), parallel_concepts);
+}
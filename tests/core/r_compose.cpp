@@ -1,5 +1,7 @@
 #include <gtest/gtest.h>
 
+#include "utils.h"
+
 #include "../include/dlplan/core.h"
 
 using namespace dlplan::core;
@@ -30,3 +32,41 @@ TEST(DLPTests, RoleCompose) {
     EXPECT_EQ(role1.evaluate(state, caches)->to_sorted_vector(), IndexPair_Vec({{0, 2}, {0, 4}, {2, 2}, {2, 4}}));
     EXPECT_EQ(role1.evaluate({state}, caches)->to_sorted_vector(), IndexPair_Vec({{0, 2}, {0, 4}, {2, 2}, {2, 4}}));
 }
+
+
+TEST(DLPTests, RoleComposeLarge) {
+    // Low densities keep the operands in the sparse representation.
+    const int num_objects = num_large_objects;
+    for (double density : {0.01, 0.2}) {
+        std::shared_ptr<VocabularyInfo> vocabulary = std::make_shared<VocabularyInfo>();
+        vocabulary->add_predicate("conn_1", 2);
+        vocabulary->add_predicate("conn_2", 2);
+        std::shared_ptr<InstanceInfo> instance = construct_large_instance_info(vocabulary);
+        std::vector<Atom> atoms;
+        add_random_graph_atoms(*instance, "conn_1", density, 0, atoms);
+        add_random_graph_atoms(*instance, "conn_2", density, 1, atoms);
+        State state(instance, atoms, 0);
+
+        SyntacticElementFactory factory(vocabulary);
+        Role conn_1 = factory.parse_role("r_primitive(conn_1,0,1)");
+        Role conn_2 = factory.parse_role("r_primitive(conn_2,0,1)");
+        IndexPair_Vec expected;
+        auto left_denot = conn_1.evaluate(state);
+        auto right_denot = conn_2.evaluate(state);
+        for (int i = 0; i < num_objects; ++i) {
+            for (int j = 0; j < num_objects; ++j) {
+                for (int k = 0; k < num_objects; ++k) {
+                    if (left_denot.contains({i, k}) && right_denot.contains({k, j})) {
+                        expected.emplace_back(i, j);
+                        break;
+                    }
+                }
+            }
+        }
+        Role role = factory.parse_role("r_compose(r_primitive(conn_1,0,1),r_primitive(conn_2,0,1))");
+        DenotationsCaches caches;
+        EXPECT_EQ(role.evaluate(state).to_sorted_vector(), expected);
+        EXPECT_EQ(role.evaluate(state, caches)->to_sorted_vector(), expected);
+        EXPECT_EQ(role.evaluate({state}, caches)->to_sorted_vector(), expected);
+    }
+}
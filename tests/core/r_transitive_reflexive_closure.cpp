@@ -1,5 +1,7 @@
 #include <gtest/gtest.h>
 
+#include "utils.h"
+
 #include "../include/dlplan/core.h"
 
 using namespace dlplan::core;
@@ -33,3 +35,40 @@ TEST(DLPTests, RoleTransitiveReflexiveClosure) {
     EXPECT_EQ(role2.evaluate(state, caches)->to_sorted_vector(), IndexPair_Vec({{0, 0}, {0, 1}, {0, 2}, {1, 0}, {1, 1}, {1, 2}, {2, 0}, {2, 1}, {2, 2}, {3, 0}, {3, 1}, {3, 2}, {3, 3}, {3, 4}, {4, 0}, {4, 1}, {4, 2}, {4, 4}}));
     EXPECT_EQ(role2.evaluate({state}, caches)->to_sorted_vector(), IndexPair_Vec({{0, 0}, {0, 1}, {0, 2}, {1, 0}, {1, 1}, {1, 2}, {2, 0}, {2, 1}, {2, 2}, {3, 0}, {3, 1}, {3, 2}, {3, 3}, {3, 4}, {4, 0}, {4, 1}, {4, 2}, {4, 4}}));
 }
+
+
+TEST(DLPTests, RoleTransitiveReflexiveClosureLarge) {
+    // Low densities keep the input sparse such that components are condensed.
+    const int num_objects = num_large_objects;
+    for (double density : {0.005, 0.02, 0.3}) {
+        std::shared_ptr<VocabularyInfo> vocabulary = std::make_shared<VocabularyInfo>();
+        vocabulary->add_predicate("conn", 2);
+        std::shared_ptr<InstanceInfo> instance = construct_large_instance_info(vocabulary);
+        std::vector<Atom> atoms;
+        std::vector<std::vector<bool>> reachable(num_objects, std::vector<bool>(num_objects, false));
+        for (const auto& edge : add_random_graph_atoms(*instance, "conn", density, 0, atoms)) {
+            reachable[edge.first][edge.second] = true;
+        }
+        State state(instance, atoms, 0);
+        for (int k = 0; k < num_objects; ++k) {
+            for (int i = 0; i < num_objects; ++i) {
+                for (int j = 0; j < num_objects; ++j) {
+                    if (reachable[i][k] && reachable[k][j]) reachable[i][j] = true;
+                }
+            }
+        }
+        IndexPair_Vec expected;
+        for (int i = 0; i < num_objects; ++i) {
+            for (int j = 0; j < num_objects; ++j) {
+                if (reachable[i][j] || i == j) expected.emplace_back(i, j);
+            }
+        }
+
+        SyntacticElementFactory factory(vocabulary);
+        DenotationsCaches caches;
+        Role role = factory.parse_role("r_transitive_reflexive_closure(r_primitive(conn,0,1))");
+        EXPECT_EQ(role.evaluate(state).to_sorted_vector(), expected);
+        EXPECT_EQ(role.evaluate(state, caches)->to_sorted_vector(), expected);
+        EXPECT_EQ(role.evaluate({state}, caches)->to_sorted_vector(), expected);
+    }
+}
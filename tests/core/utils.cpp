@@ -0,0 +1,32 @@
+#include "utils.h"
+
+#include <random>
+
+const int num_large_objects = 70;
+
+std::string large_object_name(int object) {
+    return "o" + std::to_string(object);
+}
+
+std::shared_ptr<InstanceInfo> construct_large_instance_info(std::shared_ptr<const VocabularyInfo> vocabulary_info) {
+    std::shared_ptr<InstanceInfo> instance_info = std::make_shared<InstanceInfo>(vocabulary_info, 0);
+    for (int i = 0; i < num_large_objects; ++i) {
+        instance_info->add_object(large_object_name(i));
+    }
+    return instance_info;
+}
+
+IndexPair_Vec add_random_graph_atoms(InstanceInfo& instance_info, const std::string& predicate_name, double density, int seed, std::vector<Atom>& atoms) {
+    std::mt19937 rng(seed);
+    std::bernoulli_distribution distribution(density);
+    IndexPair_Vec edges;
+    for (int i = 0; i < num_large_objects; ++i) {
+        for (int j = 0; j < num_large_objects; ++j) {
+            if (distribution(rng)) {
+                atoms.push_back(instance_info.add_atom(predicate_name, {large_object_name(i), large_object_name(j)}));
+                edges.emplace_back(i, j);
+            }
+        }
+    }
+    return edges;
+}
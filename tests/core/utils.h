@@ -0,0 +1,14 @@
+#include "../include/dlplan/core.h"
+
+using namespace dlplan::core;
+
+
+// More objects than bits in a block such that rows of role denotations cross block boundaries.
+extern const int num_large_objects;
+
+extern std::string large_object_name(int object);
+
+extern std::shared_ptr<InstanceInfo> construct_large_instance_info(std::shared_ptr<const VocabularyInfo> vocabulary_info);
+
+// Adds the atoms of a random graph where each edge exists with the given density and returns its edges.
+extern IndexPair_Vec add_random_graph_atoms(InstanceInfo& instance_info, const std::string& predicate_name, double density, int seed, std::vector<Atom>& atoms);
@@ -0,0 +1,36 @@
+#include <gtest/gtest.h>
+
+#include "utils.h"
+
+#include "../include/dlplan/policy.h"
+
+using namespace dlplan::core;
+using namespace dlplan::policy;
+
+
+TEST(DLPTests, PolicyReaderNames) {
+    auto vocabulary_info = construct_vocabulary_info();
+    auto syntactic_element_factory = construct_syntactic_element_factory(vocabulary_info);
+    std::string policy_textual =
+        "(:policy\n"
+        "(:boolean_features \"b_empty(r_primitive(at,0,1))\")\n"
+        "(:numerical_features \"n_count(r_primitive(at,0,1))\")\n"
+        "(:rule (:conditions (:c_b_pos 0)) (:effects (:e_b_neg 0)))\n"
+        ")";
+    auto policy = PolicyReader().read(policy_textual, syntactic_element_factory);
+    EXPECT_EQ(policy.get_rules().size(), 1);
+
+    // A name consists of ':' followed by at least one character.
+    std::string bare_colon_textual =
+        "(:policy\n"
+        "(:boolean_features \"b_empty(r_primitive(at,0,1))\")\n"
+        "(:numerical_features \"n_count(r_primitive(at,0,1))\")\n"
+        "(: (:conditions (:c_b_pos 0)) (:effects (:e_b_neg 0)))\n"
+        ")";
+    try {
+        PolicyReader().read(bare_colon_textual, syntactic_element_factory);
+        FAIL() << "Expected std::runtime_error";
+    } catch (const std::runtime_error& error) {
+        EXPECT_NE(std::string(error.what()).find("tokenize - unrecognized text: : (:conditions"), std::string::npos);
+    }
+}